@@ -0,0 +1,41 @@
+# Writes OUTPUT, the build_id[] naming this build of the engine: the git
+# commit of SOURCE_DIR and, when the sources there are not all committed,
+# -dirty and a hash of them.  Run on every build, but OUTPUT is only
+# rewritten when the id changes, so a build with nothing to do relinks
+# nothing and the id stays the same while the sources do.
+execute_process(COMMAND git describe --always
+                WORKING_DIRECTORY ${SOURCE_DIR}
+                OUTPUT_VARIABLE build_commit
+                OUTPUT_STRIP_TRAILING_WHITESPACE
+                ERROR_QUIET)
+execute_process(COMMAND git status --porcelain -- .
+                WORKING_DIRECTORY ${SOURCE_DIR}
+                OUTPUT_VARIABLE build_changes
+                OUTPUT_STRIP_TRAILING_WHITESPACE
+                ERROR_QUIET)
+if(NOT build_commit)
+  set(build_commit "unknown")
+  set(build_changes TRUE)
+endif()
+
+set(build "${build_commit}")
+if(build_changes)
+  file(GLOB_RECURSE build_sources LIST_DIRECTORIES false RELATIVE ${SOURCE_DIR} ${SOURCE_DIR}/*)
+  list(SORT build_sources)
+  set(build_hashes "")
+  foreach(source ${build_sources})
+    file(SHA1 ${SOURCE_DIR}/${source} source_hash)
+    string(APPEND build_hashes "${source_hash} ${source}\n")
+  endforeach()
+  string(SHA1 build_hash "${build_hashes}")
+  string(SUBSTRING ${build_hash} 0 12 build_hash)
+  set(build "${build}-dirty-${build_hash}")
+endif()
+
+set(build_text "// Build id written by build_id.cmake. Edit there.\nconst char build_id[] = \"${build}\";\n")
+if(EXISTS ${OUTPUT})
+  file(READ ${OUTPUT} build_text_was)
+endif()
+if(NOT build_text STREQUAL build_text_was)
+  file(WRITE ${OUTPUT} "${build_text}")
+endif()
@@ -8,6 +8,7 @@
 #include <ctype.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #ifdef _WIN32
 #include "../getopt/getopt.h"
 #else
@@ -20,6 +21,7 @@ void process_command_line(int argc, char **argv) {
   extern char *optarg;
   extern int optind;
   int opt;
+  int sweeps;
 
   // Default command line arguments
   // clang-format off
@@ -39,8 +41,18 @@ void process_command_line(int argc, char **argv) {
   cmds.mhea_compare_file_path     = NO_OUTPUT;    // x
   cmds.mhea_measure_file_path     = NO_OUTPUT;    // y
   cmds.regression_test            = FALSE;        // z
+  cmds.weather_sweep_file_path    = NO_SWEEP;     // w
+  cmds.parametric_sweep_file_path = NO_SWEEP;     // p
+  cmds.monte_carlo_file_path      = NO_SWEEP;     // t
+  cmds.session_file_path          = NO_SWEEP;     // a
+  cmds.sensitivity_file_path      = NO_SWEEP;     // k
+  cmds.batch_file_path            = NO_SWEEP;     // g
+  cmds.package_search_seconds     = 0.0f;         // b
+  cmds.package_frontier           = FALSE;        // l
+  cmds.first_pass_cache_path      = NO_OUTPUT;    // q
+  cmds.performance                = FALSE;        // P
 
-  static char usage[] = "usage: %s -nm[sjfz] [-d LEVEL] [-ioecuxy  FILE] [-r STRING]\n\n"
+  static char usage[] = "usage: %s -nm[sjfzlP] [-d LEVEL] [-b SECONDS] [-ioecuxywptakg FILE] [-q DIR] [-r STRING]\n\n"
     WA_DESCRIPTION "\n"
     "Version: " WA_VERSION "\n"
     "Contact: " WA_CONTACT_EMAIL "\n\n"
@@ -49,7 +61,7 @@ void process_command_line(int argc, char **argv) {
     "  -n              Run the NEAT site built engine\n"
     "  -m              Run the MHEA manufactured housing engine\n"
     "  -s              Do the input JSON validation against the schema\n"
-    "  -v              Do the output JSON validation against the schema\n"
+    "  -v              Do the output JSON validation against the schema, not with a sweep\n"
     "  -d   LEVEL      Debug level. NOTE: use >2filepath to redirect stderr to filepath (silent)\n"
     "  -i   FILE       JSON Input from FILE instead of standard input (stdin)\n"
     "  -o   FILE       JSON Output to FILE instead of standard output (stdout)\n"
@@ -62,10 +74,20 @@ void process_command_line(int argc, char **argv) {
     "  -x   FILE       Create a formated sizing and bill comparison output file, MHEA extra/legacy (no output)\n"
     "  -y   FILE       Create a formated recommended measure text report, MHEA extra/legacy (no output)\n"
     "  -z              Skip items in JSON output to aid in regression testing (false)\n"
+    "  -w   FILE       Run the MHEA audit for each weather file listed in FILE, one row per station (no sweep)\n"
+    "  -p   FILE       Run the MHEA audit over the input field grid described in FILE, one row per point (no sweep)\n"
+    "  -t   FILE       Run the MHEA audit for samples of the uncertain inputs described in FILE, percentiles only (no sweep)\n"
+    "  -a   FILE       Keep the MHEA audit loaded and rerun it after each JSON Patch line of FILE, - for stdin (no session)\n"
+    "  -k   FILE       Perturb each MHEA input field described in FILE in turn, normalized sensitivities only (no sweep)\n"
+    "  -g   FILE       Run each MHEA audit listed in the batch FILE and reduce the results to fleet aggregates, no -i (no batch)\n"
+    "  -b   SECONDS    MHEA also finds the most savings package within the spending limit, searching up to SECONDS (no search)\n"
+    "  -l              MHEA also traces the cost versus savings frontier of measure packages (no frontier)\n"
+    "  -q   DIR        MHEA keeps first pass results in DIR and reuses them for audits it has seen before (no cache)\n"
+    "  -P              Add phase timings and counters to the JSON output, not with a sweep (false)\n"
     "  -h              Show this command line usage help message (no help message)\n";
 
   // list of command letters followed by : if the command takes an arg
-  while ((opt = getopt(argc, argv, "nmsvd:i:o:jr:fe:c:u:x:y:zh")) != -1){
+  while ((opt = getopt(argc, argv, "nmsvd:i:o:jr:fe:c:u:x:y:zw:p:t:a:k:g:b:lq:Ph")) != -1){
 
     switch (opt) {
     case 'n':
@@ -116,6 +138,36 @@ void process_command_line(int argc, char **argv) {
     case 'z':
       cmds.regression_test = TRUE;
       break;
+    case 'w':
+      cmds.weather_sweep_file_path = optarg;
+      break;
+    case 'p':
+      cmds.parametric_sweep_file_path = optarg;
+      break;
+    case 't':
+      cmds.monte_carlo_file_path = optarg;
+      break;
+    case 'a':
+      cmds.session_file_path = optarg;
+      break;
+    case 'k':
+      cmds.sensitivity_file_path = optarg;
+      break;
+    case 'g':
+      cmds.batch_file_path = optarg;
+      break;
+    case 'b':
+      cmds.package_search_seconds = (float)atof(optarg);
+      break;
+    case 'l':
+      cmds.package_frontier = TRUE;
+      break;
+    case 'q':
+      cmds.first_pass_cache_path = optarg;
+      break;
+    case 'P':
+      cmds.performance = TRUE;
+      break;
 
     case 'h':
     case '?':
@@ -126,10 +178,21 @@ void process_command_line(int argc, char **argv) {
   }
   // clang-format on
 
+  // at most one MHEA sweep or session mode per run, and neither -v nor -P
+  // with one: the rows it writes are not a result the output schema describes
+  sweeps = (strcmp(cmds.weather_sweep_file_path, NO_SWEEP) != 0) +
+           (strcmp(cmds.parametric_sweep_file_path, NO_SWEEP) != 0) +
+           (strcmp(cmds.monte_carlo_file_path, NO_SWEEP) != 0) +
+           (strcmp(cmds.session_file_path, NO_SWEEP) != 0) +
+           (strcmp(cmds.sensitivity_file_path, NO_SWEEP) != 0) +
+           (strcmp(cmds.batch_file_path, NO_SWEEP) != 0);
+
   // Show usage notes if errors found in command input
   if (optind < argc ||
      (cmds.run_neat == FALSE && cmds.run_mhea == FALSE) ||
-     (cmds.run_neat == TRUE && cmds.run_mhea == TRUE)) {
+     (cmds.run_neat == TRUE && cmds.run_mhea == TRUE) ||
+     (cmds.run_neat == TRUE && sweeps > 0) || sweeps > 1 ||
+     ((cmds.performance || cmds.do_output_validation) && sweeps > 0)) {
     fprintf(stderr, usage, argv[0]);
     fprintf(stderr, "\n\noptind:%d argc:%d", optind, argc);
     fprintf(stderr, "\nrun_neat:%d run_mhea:%d", cmds.run_neat, cmds.run_mhea);
@@ -25,6 +25,16 @@ typedef struct {
   char *mhea_compare_file_path;
   char *mhea_measure_file_path;
   int regression_test;
+  char *weather_sweep_file_path;
+  char *parametric_sweep_file_path;
+  char *monte_carlo_file_path;
+  char *session_file_path;
+  char *sensitivity_file_path;
+  char *batch_file_path;
+  float package_search_seconds;
+  int package_frontier;
+  char *first_pass_cache_path;
+  int performance;
 
 } WA_COMMAND_LINE_ARGS;
 
@@ -16,6 +16,7 @@
 #define NO_OUTPUT "no_output"
 #define STD_OUTPUT "std_out"
 #define STD_INPUT "std_in"
+#define NO_SWEEP "no_sweep"
 
 #define SYSTEM_DIR "./sys/"
 #define ESCALATION_DIR SYSTEM_DIR "fuel_escalation/"
@@ -63,6 +64,9 @@
 #define D_NEAT_ENERGY_DETAIL_ALL 1024   // detailed debug information from all calls to neat_energy_use 
 #define D_MEASURE_EXCLUSION 2048        // show the measure exclusion matrix
 #define D_WEATHER_DATA_ECHO 4096        // show summary of the weather data used
+#define D_MHEA_ENERGY_MEMO 8192         // hit and miss counts of the mhea_energy_use() memo
+#define D_MEASURE_ACCESS 16384          // check each MHEA measure only changes the dwelling sections it declares
+#define D_FIRST_PASS_REUSE 32768        // check the billing adjusted run's reuse of the MHEA first pass against a repeated pass
 
 // here are our string lengths. Every defined constant that is used
 // to dimension a character array has a _LEN (length) suffix
@@ -71,6 +75,9 @@
 
 #define MAX_COMPONENTS_LEN 1024
 
+#define MAX_COMPONENT_CODES 256                       // distinct component codes (W1, A2 ...) interned per audit
+#define COMPONENT_SET_WORDS (MAX_COMPONENT_CODES / 32) // 32 bit words in a component code bitset
+
 #define PATH_LEN 254            // longest possible file pathname length 
 #define SHORT_NAME_LEN 80       // size of a short file name, including extension
 
@@ -115,9 +122,16 @@
 #define MAX_ITC 60 // itemized costs
 #define MIN_ITC 0
 
+#define MHEA_MAX_SCENARIOS 8 // economic scenarios evaluated with an MHEA audit
+#define MHEA_MAX_FRONTIER 64 // packages reported on the MHEA package frontier
+
 #define MAX_UBI 4 // utility billing periods (heating, cooling x before, after)
 #define MIN_UBI 0
 
 #define MAXECMS 200 // The maximum number of individual measures considered  both NEAT and MHEA
 
+#define MAX_RANK_ITEMS (4 * MAXECMS + 1)  // largest list stable_rank() will order, room for a bottom mark entry
+
+#define HASH_SEED 14695981039346656037ULL // starting value for a hash_bytes() key (64 bit FNV offset basis)
+
 #endif // _DEFINITION_H
@@ -19,6 +19,14 @@ typedef struct {
   char file[SHORT_NAME_LEN + 1]; // actual name of the file
 } WTH;
 
+// ***************************************************
+// Set of interned component codes (see component_code_id())
+// a measure applies to, one bit per code
+// ***************************************************
+typedef struct {
+  unsigned int bits[COMPONENT_SET_WORDS];
+} COMPONENT_SET;
+
 
 
 
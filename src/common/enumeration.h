@@ -374,5 +374,29 @@ enum DUCTSHAPE // HEATING SUPPLY CROSS SECTION
   DS_RECTANGULAR,
   DS_NONE };
 
+// run phases timed for the performance block of the results, see performance.c
+enum PERFORMANCE_PHASE
+{ PP_SCHEMA_PARSE = 0,
+  PP_INPUT_READ,
+  PP_VALIDATION,
+  PP_WEATHER_LOAD,
+  PP_TRANSLATION,
+  PP_SIZING,
+  PP_BASE_CASE,
+  PP_FIRST_PASS,
+  PP_INTERACTION_PASS,
+  PP_BILLING_ADJUST,
+  PP_REPORT,
+  PP_OPTIMIZE,
+  PP_OUTPUT_WRITE,
+  PP_PHASES };
+
+enum PERFORMANCE_COUNTER
+{ PC_MEASURES = 0,           // measure evaluations, first and interaction passes
+  PC_DWELLING_ALLOCATIONS,   // working copies of the dwelling input allocated
+  PC_JSON_ALLOCATIONS,       // cJSON allocations
+  PC_ENERGY_CALLS,           // energy use calculations, memo hits included
+  PC_COUNTERS };
+
 
 #endif // _ENUM_H
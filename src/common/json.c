@@ -7,6 +7,7 @@
 ****************************************************************************/
 #include <ctype.h>
 #include <limits.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <errno.h>
@@ -486,6 +487,37 @@ cJSON *parse_json_file(const char *filepath) {
   return parsed;
 }
 
+/// As parse_json_file(), but a file that cannot be opened or is not JSON returns NULL with the reason in error
+/// rather than ending the run, for callers that go on to the next file.
+
+cJSON *try_parse_json_file(const char *filepath, const char **error) {
+  static char reason[MAX_ASSERT_MESSAGE_LEN];
+  FILE *in_file;
+  char *content;
+  cJSON *parsed;
+
+  *error = NULL;
+  if (strcmp(filepath, STD_INPUT) != 0) {
+    if ((in_file = fopen(filepath, "rb")) == NULL) {
+      snprintf(reason, sizeof(reason), "Failed to open the input json file: %s code:%d:%s", filepath, errno, strerror(errno));
+      *error = reason;
+      return NULL;
+    }
+    fclose(in_file);
+  }
+
+  content = read_json_file(filepath);
+  parsed = cJSON_Parse(content);
+  if (!parsed) {
+    const char *error_ptr = cJSON_GetErrorPtr();
+    snprintf(reason, sizeof(reason), "JSON Input parsing failed on file: %s before: %.40s", filepath,
+             error_ptr && strlen(error_ptr) ? error_ptr : "No Input");
+    *error = reason;
+  }
+  free(content);
+  return parsed;
+}
+
 /// Returns a pointer to the file extension.  It searches for the dot separator from the right side
 /// of the string.
 
@@ -495,3 +527,440 @@ const char *get_filename_ext(const char *filename) {
     return "";
   return dot + 1;
 }
+
+// Unescape the pointer token starting after the '/' at p into token.  Returns
+// where the token ends, at the next '/' or the end of the pointer, or NULL
+// with why in *error when the token can not be read.
+static const char *pointer_token(const char *p, char *token, const char **error) {
+  int n = 0;
+
+  for (p++; *p && *p != '/'; p++) {
+    char c = *p;
+    if (c == '~') { // ~0 is '~' and ~1 is '/'
+      p++;
+      if (*p != '0' && *p != '1') {
+        *error = "has a bad ~ escape";
+        return NULL;
+      }
+      c = (*p == '0') ? '~' : '/';
+    }
+    if (n >= MAX_FIELDNAME_LEN) {
+      *error = "has a token too long";
+      return NULL;
+    }
+    token[n++] = c;
+  }
+  token[n] = '\0';
+  return p;
+}
+
+// Why pointer can not be followed, NULL when it can
+static const char *pointer_error(const char *pointer) {
+  char token[MAX_FIELDNAME_LEN + 1];
+  const char *error = NULL;
+  const char *p = pointer;
+
+  if (pointer[0] != '/' && pointer[0] != '\0')
+    return "does not start with '/'";
+  while (p && *p == '/')
+    p = pointer_token(p, token, &error);
+  return error;
+}
+
+// Array index of token, -1 when it is not one
+static int pointer_index(const char *token) {
+  char *end;
+  long index = strtol(token, &end, 10);
+
+  return (isdigit((unsigned char)token[0]) && *end == '\0' && index < INT_MAX) ? (int)index : -1;
+}
+
+/// Returns the item a JSON pointer (RFC 6901, eg. "/walls/stud_size" or "/windows/0/area") refers to
+/// in root, or NULL if there is none.
+
+cJSON *json_pointer_item(cJSON *root, const char *pointer) {
+  cJSON *item = root;
+  const char *p = pointer;
+  const char *error;
+
+  ASSERT(pointer, sprintf(msg, "Missing JSON pointer"));
+  error = pointer_error(pointer);
+  ASSERT(error == NULL, sprintf(msg, "JSON pointer %s %s", pointer, error));
+
+  while (item && *p == '/') {
+    char token[MAX_FIELDNAME_LEN + 1];
+
+    p = pointer_token(p, token, &error);
+    if (cJSON_IsArray(item)) {
+      int index = pointer_index(token);
+      item = (index >= 0) ? cJSON_GetArrayItem(item, index) : NULL;
+    } else if (cJSON_IsObject(item)) {
+      item = cJSON_GetObjectItem(item, token);
+    } else {
+      item = NULL;
+    }
+  }
+
+  return item;
+}
+
+/// Give item a copy of value in place, keeping its name and place in the tree.  (The cJSON
+/// replace functions drop the name of the item replaced.)
+
+void json_set_item_value(cJSON *item, const cJSON *value) {
+  cJSON *copy = cJSON_Duplicate(value, TRUE);
+  cJSON *child = item->child;
+  char *valuestring = item->valuestring;
+  int type = item->type & ~cJSON_StringIsConst;
+
+  ASSERT(copy, sprintf(msg, "Out of memory copying a JSON value"));
+
+  // swap the values, the old one goes with the copy
+  item->type = (copy->type & ~cJSON_StringIsConst) | (item->type & cJSON_StringIsConst);
+  item->child = copy->child;
+  item->valuestring = copy->valuestring;
+  item->valueint = copy->valueint;
+  item->valuedouble = copy->valuedouble;
+
+  copy->type = type | (copy->type & cJSON_StringIsConst);
+  copy->child = child;
+  copy->valuestring = valuestring;
+  cJSON_Delete(copy);
+}
+
+// The container the last token of pointer is in, with that token
+static cJSON *pointer_parent(cJSON *root, const char *pointer, char *token) {
+  const char *last = strrchr(pointer, '/');
+  const char *error;
+  char parent[PATH_LEN];
+
+  if (last == NULL || last - pointer >= PATH_LEN)
+    return NULL;
+  memcpy(parent, pointer, last - pointer);
+  parent[last - pointer] = '\0';
+  pointer_token(last, token, &error); // the whole pointer has been checked
+  return json_pointer_item(root, parent);
+}
+
+// Put value (owned from here on) at pointer, as the JSON Patch "add" does
+static int pointer_add(cJSON *root, const char *pointer, cJSON *value) {
+  char token[MAX_FIELDNAME_LEN + 1];
+  cJSON *parent, *item;
+
+  if (pointer[0] == '\0') { // the whole document
+    json_set_item_value(root, value);
+    cJSON_Delete(value);
+    return TRUE;
+  }
+  parent = pointer_parent(root, pointer, token);
+  if (cJSON_IsObject(parent)) {
+    if ((item = cJSON_GetObjectItem(parent, token))) {
+      json_set_item_value(item, value);
+      cJSON_Delete(value);
+    } else {
+      cJSON_AddItemToObject(parent, token, value);
+    }
+    return TRUE;
+  }
+  if (cJSON_IsArray(parent)) {
+    int size = cJSON_GetArraySize(parent);
+    int index = strcmp(token, "-") == 0 ? size : pointer_index(token);
+    if (index < 0 || index > size)
+      return FALSE;
+    if (index == size)
+      cJSON_AddItemToArray(parent, value);
+    else
+      cJSON_InsertItemInArray(parent, index, value);
+    return TRUE;
+  }
+  return FALSE;
+}
+
+// Take the item at pointer out of the document, NULL if there is none
+static cJSON *pointer_detach(cJSON *root, const char *pointer) {
+  char token[MAX_FIELDNAME_LEN + 1];
+  cJSON *item = json_pointer_item(root, pointer);
+
+  if (item == NULL || item == root)
+    return NULL;
+  return cJSON_DetachItemViaPointer(pointer_parent(root, pointer, token), item);
+}
+
+/// Apply a JSON Patch (RFC 6902, an array of add, remove, replace, move, copy and test operations)
+/// to root.  Returns NULL when every operation applied, otherwise a message naming the one that
+/// did not, including one whose path or from is not a JSON pointer.  The operations before it
+/// stay applied, so patch a copy to keep root on failure.
+
+const char *json_patch_apply(cJSON *root, const cJSON *patch) {
+  static char error[MAX_ASSERT_MESSAGE_LEN];
+  const cJSON *jop;
+  int n = 0;
+
+  if (!cJSON_IsArray(patch))
+    return "A JSON Patch must be an array of operations";
+
+  cJSON_ArrayForEach(jop, patch) {
+    cJSON *jname = cJSON_GetObjectItem(jop, "op");
+    cJSON *jpath = cJSON_GetObjectItem(jop, "path");
+    cJSON *jvalue = cJSON_GetObjectItem(jop, "value");
+    cJSON *jfrom = cJSON_GetObjectItem(jop, "from");
+    const char *op = cJSON_IsString(jname) ? jname->valuestring : "";
+    const char *path = cJSON_IsString(jpath) ? jpath->valuestring : NULL;
+    const char *from = cJSON_IsString(jfrom) ? jfrom->valuestring : NULL;
+    const char *bad = NULL;
+    cJSON *item;
+    int ok = FALSE;
+
+    n++;
+    if (path && (bad = pointer_error(path)) != NULL) {
+      snprintf(error, sizeof(error), "JSON Patch operation %d (%s %s) path %s", n, op, path, bad);
+      return error;
+    }
+    if (from && (bad = pointer_error(from)) != NULL) {
+      snprintf(error, sizeof(error), "JSON Patch operation %d (%s %s) from %s", n, op, path ? path : "without a path", bad);
+      return error;
+    }
+    if (path) {
+      if (strcmp(op, "add") == 0) {
+        ok = jvalue && pointer_add(root, path, cJSON_Duplicate(jvalue, TRUE));
+      } else if (strcmp(op, "remove") == 0) {
+        cJSON_Delete(item = pointer_detach(root, path));
+        ok = item != NULL;
+      } else if (strcmp(op, "replace") == 0) {
+        if ((ok = jvalue && (item = json_pointer_item(root, path))))
+          json_set_item_value(item, jvalue);
+      } else if (strcmp(op, "test") == 0) {
+        ok = jvalue && (item = json_pointer_item(root, path)) && cJSON_Compare(item, jvalue, FALSE);
+      } else if (strcmp(op, "copy") == 0) {
+        ok = from && (item = json_pointer_item(root, from)) && pointer_add(root, path, cJSON_Duplicate(item, TRUE));
+      } else if (strcmp(op, "move") == 0) {
+        size_t len = from ? strlen(from) : 0;
+        if (from && !(strncmp(path, from, len) == 0 && path[len] == '/') && (item = pointer_detach(root, from))) {
+          if (!(ok = pointer_add(root, path, item)))
+            cJSON_Delete(item);
+        }
+      }
+    }
+    if (!ok) {
+      snprintf(error, sizeof(error), "JSON Patch operation %d (%s %s) failed", n, op, path ? path : "without a path");
+      return error;
+    }
+  }
+  return NULL;
+}
+
+static int schema_check(const cJSON *root, const cJSON *schema, const cJSON *item, char *path, char *error);
+
+// Note where item fails its schema and why, for json_schema_check()
+static int schema_fail(char *error, const char *path, const char *why) {
+  snprintf(error, MAX_ASSERT_MESSAGE_LEN, "Input %s %s", path[0] ? path : "document", why);
+  return FALSE;
+}
+
+static int schema_type_is(const cJSON *item, const char *type) {
+  if (strcmp(type, "integer") == 0)
+    return cJSON_IsNumber(item) && item->valuedouble == floor(item->valuedouble);
+  if (strcmp(type, "number") == 0)
+    return cJSON_IsNumber(item);
+  if (strcmp(type, "string") == 0)
+    return cJSON_IsString(item);
+  if (strcmp(type, "boolean") == 0)
+    return cJSON_IsBool(item);
+  if (strcmp(type, "object") == 0)
+    return cJSON_IsObject(item);
+  if (strcmp(type, "array") == 0)
+    return cJSON_IsArray(item);
+  if (strcmp(type, "null") == 0)
+    return cJSON_IsNull(item);
+  return FALSE;
+}
+
+// Characters, not bytes, in a UTF-8 string
+static long schema_string_length(const char *s) {
+  long n = 0;
+
+  for (; *s; s++)
+    if ((*s & 0xC0) != 0x80)
+      n++;
+  return n;
+}
+
+// Check item, the member name or element index step of the value at path
+static int schema_check_member(const cJSON *root, const cJSON *schema, const cJSON *item, char *path, char *error, const char *step) {
+  size_t len = strlen(path);
+  int ok;
+
+  snprintf(path + len, PATH_LEN - len, "/%s", step);
+  ok = schema_check(root, schema, item, path, error);
+  path[len] = '\0';
+  return ok;
+}
+
+static int schema_check_element(const cJSON *root, const cJSON *schema, const cJSON *item, char *path, char *error, int index) {
+  char step[16];
+
+  sprintf(step, "%d", index);
+  return schema_check_member(root, schema, item, path, error, step);
+}
+
+static int schema_check_array(const cJSON *root, const cJSON *schema, const cJSON *item, char *path, char *error) {
+  const cJSON *jitems = cJSON_GetObjectItem(schema, "items");
+  const cJSON *jmore = cJSON_GetObjectItem(schema, "additionalItems");
+  const cJSON *jkey, *jelement, *jother;
+  int size = cJSON_GetArraySize(item);
+  int i = 0;
+
+  if ((jkey = cJSON_GetObjectItem(schema, "minItems")) && cJSON_IsNumber(jkey) && size < jkey->valuedouble)
+    return schema_fail(error, path, "has fewer items than the schema allows");
+  if ((jkey = cJSON_GetObjectItem(schema, "maxItems")) && cJSON_IsNumber(jkey) && size > jkey->valuedouble)
+    return schema_fail(error, path, "has more items than the schema allows");
+  if (cJSON_IsTrue(cJSON_GetObjectItem(schema, "uniqueItems"))) {
+    cJSON_ArrayForEach(jelement, item) {
+      for (jother = jelement->next; jother; jother = jother->next)
+        if (cJSON_Compare(jelement, jother, FALSE))
+          return schema_fail(error, path, "has items the schema requires to be unique");
+    }
+  }
+
+  cJSON_ArrayForEach(jelement, item) {
+    const cJSON *jsub = NULL;
+    if (cJSON_IsArray(jitems)) // a schema for each position, then additionalItems
+      jsub = (i < cJSON_GetArraySize(jitems)) ? cJSON_GetArrayItem(jitems, i) : jmore;
+    else
+      jsub = jitems;
+    if (jsub && !schema_check_element(root, jsub, jelement, path, error, i))
+      return FALSE;
+    i++;
+  }
+  return TRUE;
+}
+
+static int schema_check_object(const cJSON *root, const cJSON *schema, const cJSON *item, char *path, char *error) {
+  const cJSON *jproperties = cJSON_GetObjectItem(schema, "properties");
+  const cJSON *jmore = cJSON_GetObjectItem(schema, "additionalProperties");
+  const cJSON *jrequired = cJSON_GetObjectItem(schema, "required");
+  const cJSON *jname, *jmember;
+
+  cJSON_ArrayForEach(jname, jrequired) {
+    if (cJSON_IsString(jname) && !cJSON_GetObjectItem(item, jname->valuestring)) {
+      char why[MAX_FIELDNAME_LEN + 32];
+      snprintf(why, sizeof(why), "is missing required %s", jname->valuestring);
+      return schema_fail(error, path, why);
+    }
+  }
+
+  cJSON_ArrayForEach(jmember, item) {
+    const cJSON *jsub = cJSON_GetObjectItem(jproperties, jmember->string);
+    if (jsub == NULL)
+      jsub = jmore;
+    if (jsub && !schema_check_member(root, jsub, jmember, path, error, jmember->string))
+      return FALSE;
+  }
+  return TRUE;
+}
+
+static int schema_check(const cJSON *root, const cJSON *schema, const cJSON *item, char *path, char *error) {
+  const cJSON *jkey, *jsub;
+  int matches;
+
+  if (cJSON_IsBool(schema))
+    return cJSON_IsTrue(schema) || schema_fail(error, path, "is not allowed by the schema");
+  if (!cJSON_IsObject(schema))
+    return TRUE;
+
+  // local references only ("#/definitions/leakiness"), the keywords beside a $ref are ignored
+  if ((jkey = cJSON_GetObjectItem(schema, "$ref")) && cJSON_IsString(jkey)) {
+    const cJSON *jtarget = NULL;
+    if (jkey->valuestring[0] == '#' && pointer_error(jkey->valuestring + 1) == NULL)
+      jtarget = json_pointer_item((cJSON *)root, jkey->valuestring + 1);
+    if (jtarget == NULL)
+      return schema_fail(error, path, "has a schema $ref that can not be found");
+    return schema_check(root, jtarget, item, path, error);
+  }
+
+  if ((jkey = cJSON_GetObjectItem(schema, "type"))) {
+    matches = cJSON_IsString(jkey) && schema_type_is(item, jkey->valuestring);
+    cJSON_ArrayForEach(jsub, jkey) // a list of types
+      matches = matches || (cJSON_IsString(jsub) && schema_type_is(item, jsub->valuestring));
+    if (!matches)
+      return schema_fail(error, path, "is not of a type the schema allows");
+  }
+  if ((jkey = cJSON_GetObjectItem(schema, "enum"))) {
+    matches = FALSE;
+    cJSON_ArrayForEach(jsub, jkey)
+      matches = matches || cJSON_Compare(item, jsub, FALSE);
+    if (!matches)
+      return schema_fail(error, path, "is not one of the values the schema allows");
+  }
+  if ((jkey = cJSON_GetObjectItem(schema, "const")) && !cJSON_Compare(item, jkey, FALSE))
+    return schema_fail(error, path, "is not the value the schema requires");
+
+  if (cJSON_IsNumber(item)) {
+    double x = item->valuedouble;
+    if ((jkey = cJSON_GetObjectItem(schema, "minimum")) && cJSON_IsNumber(jkey) && x < jkey->valuedouble)
+      return schema_fail(error, path, "is below the schema minimum");
+    if ((jkey = cJSON_GetObjectItem(schema, "maximum")) && cJSON_IsNumber(jkey) && x > jkey->valuedouble)
+      return schema_fail(error, path, "is above the schema maximum");
+    if ((jkey = cJSON_GetObjectItem(schema, "exclusiveMinimum")) && cJSON_IsNumber(jkey) && x <= jkey->valuedouble)
+      return schema_fail(error, path, "is not above the schema minimum");
+    if ((jkey = cJSON_GetObjectItem(schema, "exclusiveMaximum")) && cJSON_IsNumber(jkey) && x >= jkey->valuedouble)
+      return schema_fail(error, path, "is not below the schema maximum");
+  }
+  if (cJSON_IsString(item)) {
+    long length = schema_string_length(item->valuestring);
+    if ((jkey = cJSON_GetObjectItem(schema, "minLength")) && cJSON_IsNumber(jkey) && length < jkey->valuedouble)
+      return schema_fail(error, path, "is shorter than the schema allows");
+    if ((jkey = cJSON_GetObjectItem(schema, "maxLength")) && cJSON_IsNumber(jkey) && length > jkey->valuedouble)
+      return schema_fail(error, path, "is longer than the schema allows");
+  }
+  if (cJSON_IsArray(item) && !schema_check_array(root, schema, item, path, error))
+    return FALSE;
+  if (cJSON_IsObject(item) && !schema_check_object(root, schema, item, path, error))
+    return FALSE;
+
+  cJSON_ArrayForEach(jsub, cJSON_GetObjectItem(schema, "allOf")) {
+    if (!schema_check(root, jsub, item, path, error))
+      return FALSE;
+  }
+  if ((jkey = cJSON_GetObjectItem(schema, "anyOf"))) {
+    matches = FALSE;
+    cJSON_ArrayForEach(jsub, jkey)
+      matches = matches || schema_check(root, jsub, item, path, error);
+    if (!matches)
+      return schema_fail(error, path, "matches none of the schema choices (anyOf)");
+  }
+  if ((jkey = cJSON_GetObjectItem(schema, "oneOf"))) {
+    matches = 0;
+    cJSON_ArrayForEach(jsub, jkey)
+      matches += schema_check(root, jsub, item, path, error);
+    if (matches != 1)
+      return schema_fail(error, path, "does not match exactly one of the schema choices (oneOf)");
+  }
+  if ((jkey = cJSON_GetObjectItem(schema, "not")) && schema_check(root, jkey, item, path, error))
+    return schema_fail(error, path, "matches a schema it must not (not)");
+  if ((jkey = cJSON_GetObjectItem(schema, "if"))) {
+    jsub = cJSON_GetObjectItem(schema, schema_check(root, jkey, item, path, error) ? "then" : "else");
+    if (jsub && !schema_check(root, jsub, item, path, error))
+      return FALSE;
+  }
+  return TRUE;
+}
+
+/// Check doc against a JSON Schema (draft 7) without leaving the engine, as the session and
+/// batch modes do for each audit they read.  Returns NULL when doc conforms, otherwise a
+/// message naming the first place it does not.  It is not the full validation of -s
+/// (json_schema_validate_input(), ajv), which stays the reference.  Where the two differ:
+///  - pattern is not checked, so a component code with a comma passes here only;
+///  - member names match properties and required regardless of case, as the engine reads
+///    them, where ajv takes a differently cased name as another member;
+///  - $ref must be a local "#/..." pointer, and $id changes no base URI;
+///  - format, multipleOf, contains, propertyNames, patternProperties, dependencies and
+///    min/maxProperties are not checked.  The engine schemas use none of them.
+/// The session_schema case of bat/check_modes runs edits on either side of these.
+
+const char *json_schema_check(const cJSON *doc, const cJSON *schema) {
+  static char error[MAX_ASSERT_MESSAGE_LEN];
+  char path[PATH_LEN] = "";
+
+  return schema_check(schema, schema, doc, path, error) ? NULL : error;
+}
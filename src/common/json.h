@@ -29,7 +29,12 @@ int lng_assign(long *target, cJSON *jitem, char *section, char *fieldname);
 int flt_assign(float *target, cJSON *jitem, char *section, char *fieldname);
 
 cJSON *parse_json_file(const char *filename);
+cJSON *try_parse_json_file(const char *filename, const char **error);
 const char *get_filename_ext(const char *filename);
+cJSON *json_pointer_item(cJSON *root, const char *pointer);
+void json_set_item_value(cJSON *item, const cJSON *value);
+const char *json_patch_apply(cJSON *root, const cJSON *patch);
+const char *json_schema_check(const cJSON *doc, const cJSON *schema);
 void write_results_to_file(char *output);
 void write_json_echo_to_file(char *output);
 
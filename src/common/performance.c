@@ -0,0 +1,160 @@
+/***************************************************************************
+ * MODULE:       performance.c            CREATED:      10/19/2026
+ *
+ * AUTHOR:       ORNL Weatherization Assistant
+ *
+ * MDESC:        Phase timing and counters for the performance block of
+ *               the JSON results, only kept when asked for (-P).  Phases
+ *               are timed on the monotonic clock.  A phase begun inside
+ *               another pauses it, so each phase's time is its own and
+ *               the phases never add up to more than the total.  When
+ *               not asked for, each call is a test of one flag.
+ ****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#include "wa_engine.h"
+
+static double monotonic_seconds(void);
+static void count_open_phase(double now);
+static void *CJSON_CDECL counted_malloc(size_t size);
+static void CJSON_CDECL counted_free(void *p);
+
+static struct {
+  int enabled;
+  double started;              // when performance_start() was called
+  double seconds[PP_PHASES];   // time spent in each phase
+  int calls[PP_PHASES];        // and how many times it was begun
+  int open[PP_PHASES];         // phases begun and not yet ended, innermost last
+  int depth;
+  double resumed;              // when the innermost open phase last started counting
+  long count[PC_COUNTERS];
+} perf;
+
+/***************************************************************************
+ ** Function Name: performance_start
+ **
+ **  DESCRIPTION:  Start the run's clock and counters if -P asked for
+ **                them.  Called once, before the schema and input are
+ **                parsed, so the cJSON allocations of both are counted.
+ **************************************************************************/
+void performance_start(void) {
+  cJSON_Hooks hooks = {counted_malloc, counted_free};
+
+  memset(&perf, 0, sizeof(perf));
+  if (!cmds.performance)
+    return;
+
+  perf.enabled = TRUE;
+  perf.started = monotonic_seconds();
+  cJSON_InitHooks(&hooks);
+}
+
+// Start timing phase, pausing the one it is inside of
+void phase_begin(enum PERFORMANCE_PHASE phase) {
+  double now;
+
+  if (!perf.enabled || perf.depth >= PP_PHASES)
+    return;
+
+  now = monotonic_seconds();
+  count_open_phase(now);
+  perf.open[perf.depth++] = phase;
+  perf.calls[phase]++;
+}
+
+// Stop timing phase, and any begun inside it and not ended, resuming
+// the phase it was inside of
+void phase_end(enum PERFORMANCE_PHASE phase) {
+  int level;
+
+  if (!perf.enabled)
+    return;
+
+  for (level = perf.depth - 1; level >= 0 && perf.open[level] != (int)phase; level--)
+    ;
+  if (level < 0)
+    return;
+
+  count_open_phase(monotonic_seconds());
+  perf.depth = level;
+}
+
+void performance_count(enum PERFORMANCE_COUNTER counter) {
+  if (perf.enabled)
+    perf.count[counter]++;
+}
+
+/***************************************************************************
+ ** Function Name: add_performance_json
+ **
+ **  DESCRIPTION:  Add the performance block to the results, if asked
+ **                for.  Called as the last item of the results tree, so
+ **                time spent turning the tree into text and writing it is
+ **                not in the block.
+ **************************************************************************/
+void add_performance_json(cJSON *jroot) {
+  static const char *phase_names[PP_PHASES] = {
+    "schema_parse", "input_read", "validation", "weather_load", "translation", "sizing",
+    "base_case", "first_pass", "interaction_pass", "billing_adjust", "report", "optimize", "output_write"};
+  cJSON *jperf, *jphases, *jitem;
+  double now, total;
+  long json_allocations;
+
+  if (!perf.enabled)
+    return;
+
+  now = monotonic_seconds();
+  count_open_phase(now);
+  total = now - perf.started;
+  json_allocations = perf.count[PC_JSON_ALLOCATIONS]; // before this block adds its own
+
+  // clang-format off
+  cJSON_AddItemToObject(jroot, "performance", jperf = cJSON_CreateObject());
+  cJSON_AddNumberToObject(jperf, "total_seconds", WA_DBL_FMT(total, 6));
+  cJSON_AddItemToObject(jperf, "phases", jphases = cJSON_CreateObject());
+  for (int i = 0; i < PP_PHASES; i++) {
+    cJSON_AddItemToObject(jphases, phase_names[i], jitem = cJSON_CreateObject());
+    cJSON_AddNumberToObject(jitem, "seconds", WA_DBL_FMT(perf.seconds[i], 6));
+    cJSON_AddNumberToObject(jitem, "calls",   perf.calls[i]);
+  }
+  cJSON_AddNumberToObject(jperf, "energy_calls",          perf.count[PC_ENERGY_CALLS]);
+  cJSON_AddNumberToObject(jperf, "measures_evaluated",    perf.count[PC_MEASURES]);
+  cJSON_AddNumberToObject(jperf, "dwelling_allocations",  perf.count[PC_DWELLING_ALLOCATIONS]);
+  cJSON_AddNumberToObject(jperf, "json_allocations",      json_allocations);
+  // clang-format on
+}
+
+static double monotonic_seconds(void) {
+#ifdef _WIN32
+  LARGE_INTEGER count, frequency;
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+  return (double)count.QuadPart / (double)frequency.QuadPart;
+#else
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (double)now.tv_sec + (double)now.tv_nsec * 1.0e-9;
+#endif
+}
+
+// Give the innermost open phase its time since it last started counting
+static void count_open_phase(double now) {
+  if (perf.depth > 0)
+    perf.seconds[perf.open[perf.depth - 1]] += now - perf.resumed;
+  perf.resumed = now;
+}
+
+static void *CJSON_CDECL counted_malloc(size_t size) {
+  perf.count[PC_JSON_ALLOCATIONS]++;
+  return malloc(size);
+}
+
+static void CJSON_CDECL counted_free(void *p) {
+  free(p);
+}
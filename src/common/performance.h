@@ -0,0 +1,18 @@
+/***************************************************************************
+ * MODULE:       performance.h            CREATED:      10/19/2026
+ *
+ * AUTHOR:       ORNL Weatherization Assistant
+ *
+ * MDESC:        Phase timing and counters for the performance block of
+ *               the JSON results (-P)
+ ****************************************************************************/
+#ifndef _C_PERFORMANCE_H
+#define _C_PERFORMANCE_H
+
+void performance_start(void);
+void phase_begin(enum PERFORMANCE_PHASE phase);
+void phase_end(enum PERFORMANCE_PHASE phase);
+void performance_count(enum PERFORMANCE_COUNTER counter);
+void add_performance_json(cJSON *jroot);
+
+#endif /* _C_PERFORMANCE_H */
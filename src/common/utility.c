@@ -321,37 +321,113 @@ float water_heater_insulation_rpi(enum WH_INSULATION_TYPE insul_type) {
   ASSERT(FALSE, sprintf(msg, "Unrecognized water heater insulation type: %d", insul_type));
 }
 
-// Comma delimited string search. 
-// NOTE: assumes there are no commas embedded in the haystack or needle on entry
-char *comma_delimited_strstr(char *haystack, char *needle) {
-  char comma_haystack[MAX_COMPONENTS_LEN + 1];
-  char comma_needle[MAX_COMPONENTS_LEN + 1];
-  comma_haystack[0] = NULL_CHAR;
-  comma_needle[0] = NULL_CHAR;
-  sprintf(comma_haystack, ",%s,",haystack);
-  sprintf(comma_needle, ",%s,",needle);
-  return(strstr(comma_haystack, comma_needle));
+// Component code interning.  Each distinct component code in the audit is
+// assigned a small integer so the list of components a measure applies to
+// can be kept as a COMPONENT_SET bitset rather than a comma delimited string
+static char component_codes[MAX_COMPONENT_CODES][CODE_LEN + 1];
+static int num_component_codes = 0;
+
+// Forget all interned codes, called once at the start of each audit translation
+void reset_component_codes(void) {
+  num_component_codes = 0;
 }
 
+// Returns the interned id for code, adding it to the table if not already
+// there.  Blank codes are never part of a component list and return NOT_APPLICABLE
+int component_code_id(char *code) {
+  if (code == NULL || code[0] == NULL_CHAR)
+    return (NOT_APPLICABLE);
+  for (int i = 0; i < num_component_codes; i++) {
+    if (strcmp(component_codes[i], code) == 0)
+      return (i);
+  }
+  ASSERT(num_component_codes < MAX_COMPONENT_CODES, sprintf(msg, "Exceeded %d maximum distinct component codes", MAX_COMPONENT_CODES));
+  STRCPY(component_codes[num_component_codes], code);
+  return (num_component_codes++);
+}
+
+void component_set_clear(COMPONENT_SET *set) {
+  memset(set, 0, sizeof(COMPONENT_SET));
+}
+
+void component_set_add(COMPONENT_SET *set, int code_id) {
+  if (code_id >= 0)
+    set->bits[code_id >> 5] |= (1u << (code_id & 31));
+}
+
+void component_set_add_code(COMPONENT_SET *set, char *code) {
+  component_set_add(set, component_code_id(code));
+}
+
+void component_set_union(COMPONENT_SET *set, COMPONENT_SET *other) {
+  for (int w = 0; w < COMPONENT_SET_WORDS; w++)
+    set->bits[w] |= other->bits[w];
+}
+
+int component_set_contains(COMPONENT_SET *set, int code_id) {
+  if (code_id < 0)
+    return (0);
+  return ((set->bits[code_id >> 5] >> (code_id & 31)) & 1u);
+}
+
+// Returns 1 if the two component sets have any component in common,
+// or if both are empty (measures not tied to any particular component)
+int components_in_common(COMPONENT_SET *haystack, COMPONENT_SET *needle) {
+  unsigned int any = 0;
+  unsigned int common = 0;
+  for (int w = 0; w < COMPONENT_SET_WORDS; w++) {
+    common |= haystack->bits[w] & needle->bits[w];
+    any |= haystack->bits[w] | needle->bits[w];
+  }
+  return (common != 0 || any == 0);
+}
 
-// Returns 1 if the strings are the same, or if one of the comma delimited
-// sub strings in needle_list is found in the comma delimited haystack_list
-int components_in_common(char *haystack_list, char *needle_list) {
-  char haystack_list_copy[MAX_COMPONENTS_LEN + 1];
-  char needle_list_copy[MAX_COMPONENTS_LEN + 1];
-  char *token;
-
-  if (strcmp(haystack_list, needle_list) == 0)    // they are the same list or both zero length strings
-    return (1);
-
-  STRCPY(haystack_list_copy, haystack_list);
-  STRCPY(needle_list_copy, needle_list);
-  token = strtok(needle_list_copy, COMMA);   // first token
-  // walk through tokens
-  while( token != NULL ) {
-    if (comma_delimited_strstr(haystack_list_copy, token))
-      return (1);
-    token = strtok(NULL, COMMA);  // next token
+// Stable O(n log n) ranking shared by the NEAT and MHEA package sorts.
+// Reorders rank[0..n-1] so that a comes before b whenever ranks_before(a, b)
+// is true, with ties left in their original relative order.  That is exactly
+// the order the adjacent swap bubble sorts produced, as long as ranks_before()
+// is a strict weak ordering (a consistent "greater than" on the sort keys).
+void stable_rank(int *rank, int n, int (*ranks_before)(int a, int b, void *context), void *context) {
+  int work[MAX_RANK_ITEMS];
+  int *from = rank;
+  int *to = work;
+
+  ASSERT(n <= MAX_RANK_ITEMS, sprintf(msg, "Exceeded %d maximum items to rank", MAX_RANK_ITEMS));
+
+  // bottom up merge of ever wider runs, taking from the left run on ties
+  for (int width = 1; width < n; width *= 2) {
+    for (int lo = 0; lo < n; lo += 2 * width) {
+      int mid = MIN(lo + width, n);
+      int hi = MIN(lo + 2 * width, n);
+      int i = lo, j = mid, k = lo;
+      while (i < mid && j < hi) {
+        if (ranks_before(from[j], from[i], context))
+          to[k++] = from[j++];
+        else
+          to[k++] = from[i++];
+      }
+      while (i < mid)
+        to[k++] = from[i++];
+      while (j < hi)
+        to[k++] = from[j++];
+    }
+    int *swap = from;
+    from = to;
+    to = swap;
   }
-  return (0);
-}
\ No newline at end of file
+  if (from != rank)
+    memcpy(rank, from, n * sizeof(int));
+}
+
+// 64 bit FNV-1a hash of n bytes at data, continued from h so several blocks
+// can be folded into one key.  Start a new key from HASH_SEED.  Used to key
+// memoized results on the exact bytes of their inputs.
+unsigned long long hash_bytes(unsigned long long h, const void *data, size_t n) {
+  const unsigned char *p = data;
+
+  for (size_t i = 0; i < n; i++) {
+    h ^= p[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
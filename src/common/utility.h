@@ -24,7 +24,16 @@ void adjust_seer(float temp, float *fseer);
 float water_heater_insulation_rpi(enum WH_INSULATION_TYPE insul_type);
 int water_heater_replace_data_check(DWH dwh);
 
-char *comma_delimited_strstr(char *haystack, char *needle);
-int components_in_common(char *haystack_list, char *needle_list);
+void reset_component_codes(void);
+int component_code_id(char *code);
+void component_set_clear(COMPONENT_SET *set);
+void component_set_add(COMPONENT_SET *set, int code_id);
+void component_set_add_code(COMPONENT_SET *set, char *code);
+void component_set_union(COMPONENT_SET *set, COMPONENT_SET *other);
+int component_set_contains(COMPONENT_SET *set, int code_id);
+int components_in_common(COMPONENT_SET *haystack, COMPONENT_SET *needle);
+
+void stable_rank(int *rank, int n, int (*ranks_before)(int a, int b, void *context), void *context);
+unsigned long long hash_bytes(unsigned long long h, const void *data, size_t n);
 
 #endif /* _C_UTILITY_H */
\ No newline at end of file
@@ -25,6 +25,8 @@ int main(int argc, char **argv) {
 
   process_command_line(argc, argv);   // fills in our cmds. structure or fails and exits
 
+  performance_start();                // -P phase timings and counters
+
   if (cmds.debug_level != D_SILENT) {
     ASSERT(sizeof(int) == 4, sprintf(msg, "Debug flags are binary assuming at least 4 byte int variable size"));
   }
@@ -51,9 +53,17 @@ int main(int argc, char **argv) {
 
   if (cmds.run_neat) {
 
-    if (cmds.do_input_validation) json_schema_validate_input(NEAT_INPUT_JSON_SCHEMA_FILE);
+    if (cmds.do_input_validation) {
+      phase_begin(PP_VALIDATION);
+      json_schema_validate_input(NEAT_INPUT_JSON_SCHEMA_FILE);
+      phase_end(PP_VALIDATION);
+    }
+    phase_begin(PP_INPUT_READ);
     json_input = parse_json_file(cmds.input_file_path);
+    phase_end(PP_INPUT_READ);
+    phase_begin(PP_SCHEMA_PARSE);
     json_schema = parse_json_file(NEAT_INPUT_JSON_SCHEMA_FILE);
+    phase_end(PP_SCHEMA_PARSE);
 
     if (cmds.debug_level & D_NORMAL) {
       // clang-format off
@@ -71,7 +81,9 @@ int main(int argc, char **argv) {
     ASSERT((nir = (NIR *)calloc(1, sizeof(NIR))), sprintf(msg, "Out of memory on NIR"));
     ASSERT((nor = (NOR *)calloc(1, sizeof(NOR))), sprintf(msg, "Out of memory on NOR"));
 
+    phase_begin(PP_TRANSLATION);
     neat_json_read(ndi, json_input, json_schema); // cJSON to NDI assignments using schema
+    phase_end(PP_TRANSLATION);
 
     if (strcmp(cmds.input_echo_file_path, NO_OUTPUT) != 0) {
       neat_json_echo_write(ndi); // optional JSON echo for validation
@@ -79,7 +91,9 @@ int main(int argc, char **argv) {
 
     run_neat(); // <<<<<<<======= NEAT engine WORKHORSE
 
+    phase_begin(PP_OUTPUT_WRITE);
     neat_json_result_write(ndi, nor); // Output the results structure as a JSON
+    phase_end(PP_OUTPUT_WRITE);
 
     if (cmds.do_output_validation) json_schema_validate_output(NEAT_OUTPUT_JSON_SCHEMA_FILE);
 
@@ -87,17 +101,47 @@ int main(int argc, char **argv) {
     if (nir) {free(nir); nir = NULL;}
     if (nor) {free(nor); nor = NULL;}
 
+  } else if (cmds.run_mhea && strcmp(cmds.batch_file_path, NO_SWEEP) != 0) {
+
+    // each audit of the batch is read from its own file, so there is no -i input
+    json_schema = parse_json_file(MHEA_INPUT_JSON_SCHEMA_FILE);
+
+    if (cmds.debug_level & D_NORMAL) fprintf(stderr, "\nMHEA Batch of        : %s", cmds.batch_file_path);
+
+    ASSERT((mdi = (MDI *)calloc(1, sizeof(MDI))), sprintf(msg, "Out of memory on MDI"));
+    ASSERT((mir = (MIR *)calloc(1, sizeof(MIR))), sprintf(msg, "Out of memory on MIR"));
+    ASSERT((mor = (MOR *)calloc(1, sizeof(MOR))), sprintf(msg, "Out of memory on MOR"));
+
+    run_mhea_batch(cmds.batch_file_path, json_schema); // aggregates over the audits
+
+    if (mdi) {free(mdi); mdi = NULL;}
+    if (mir) {free(mir); mir = NULL;}
+    if (mor) {free(mor); mor = NULL;}
+
   } else if (cmds.run_mhea) {
 
-    if (cmds.do_input_validation) json_schema_validate_input(MHEA_INPUT_JSON_SCHEMA_FILE);
+    if (cmds.do_input_validation) {
+      phase_begin(PP_VALIDATION);
+      json_schema_validate_input(MHEA_INPUT_JSON_SCHEMA_FILE);
+      phase_end(PP_VALIDATION);
+    }
+    phase_begin(PP_INPUT_READ);
     json_input = parse_json_file(cmds.input_file_path);
+    phase_end(PP_INPUT_READ);
+    phase_begin(PP_SCHEMA_PARSE);
     json_schema = parse_json_file(MHEA_INPUT_JSON_SCHEMA_FILE);
+    phase_end(PP_SCHEMA_PARSE);
 
     if (cmds.debug_level & D_NORMAL) {
       // clang-format off
       if (strcmp(cmds.input_echo_file_path, NO_OUTPUT)    != 0) fprintf(stderr, "\nMHEA Echo To          : %s", cmds.input_echo_file_path);
       if (strcmp(cmds.mhea_compare_file_path, NO_OUTPUT)  != 0) fprintf(stderr, "\nMHEA Compare Report To: %s", cmds.mhea_compare_file_path);
       if (strcmp(cmds.mhea_measure_file_path, NO_OUTPUT)  != 0) fprintf(stderr, "\nMHEA Measure Report To: %s", cmds.mhea_measure_file_path);
+      if (strcmp(cmds.weather_sweep_file_path, NO_SWEEP)  != 0) fprintf(stderr, "\nMHEA Weather Sweep of: %s", cmds.weather_sweep_file_path);
+      if (strcmp(cmds.parametric_sweep_file_path, NO_SWEEP) != 0) fprintf(stderr, "\nMHEA Parametric Sweep: %s", cmds.parametric_sweep_file_path);
+      if (strcmp(cmds.monte_carlo_file_path, NO_SWEEP)    != 0) fprintf(stderr, "\nMHEA Monte Carlo of  : %s", cmds.monte_carlo_file_path);
+      if (strcmp(cmds.session_file_path, NO_SWEEP)        != 0) fprintf(stderr, "\nMHEA Session Edits   : %s", cmds.session_file_path);
+      if (strcmp(cmds.sensitivity_file_path, NO_SWEEP)    != 0) fprintf(stderr, "\nMHEA Sensitivity of  : %s", cmds.sensitivity_file_path);
       // clang-format on
     }
 
@@ -105,15 +149,31 @@ int main(int argc, char **argv) {
     ASSERT((mir = (MIR *)calloc(1, sizeof(MIR))), sprintf(msg, "Out of memory on MIR"));
     ASSERT((mor = (MOR *)calloc(1, sizeof(MOR))), sprintf(msg, "Out of memory on MOR"));
 
+    phase_begin(PP_TRANSLATION);
     mhea_json_read(mdi, json_input, json_schema);  // cJSON to MDI assignments
+    phase_end(PP_TRANSLATION);
 
     if (strcmp(cmds.input_echo_file_path, NO_OUTPUT) != 0) {
       mhea_json_echo_write(mdi); // optional JSON echo for validation
     }
 
-    run_mhea(); // <<<<<<<======= MHEA engine WORKHORSE
-
-    mhea_json_result_write(mdi, mor); // Output the results structure as a JSON
+    if (strcmp(cmds.weather_sweep_file_path, NO_SWEEP) != 0) {
+      run_mhea_weather_sweep(cmds.weather_sweep_file_path); // writes one result row per station
+    } else if (strcmp(cmds.parametric_sweep_file_path, NO_SWEEP) != 0) {
+      run_mhea_parametric_sweep(cmds.parametric_sweep_file_path, json_input, json_schema); // one row per grid point
+    } else if (strcmp(cmds.monte_carlo_file_path, NO_SWEEP) != 0) {
+      run_mhea_monte_carlo(cmds.monte_carlo_file_path, json_input, json_schema); // percentiles over the samples
+    } else if (strcmp(cmds.session_file_path, NO_SWEEP) != 0) {
+      run_mhea_session(cmds.session_file_path, json_input, json_schema); // one result line per edit
+    } else if (strcmp(cmds.sensitivity_file_path, NO_SWEEP) != 0) {
+      run_mhea_sensitivity(cmds.sensitivity_file_path, json_input, json_schema); // normalized sensitivities per field
+    } else {
+      run_mhea(); // <<<<<<<======= MHEA engine WORKHORSE
+
+      phase_begin(PP_OUTPUT_WRITE);
+      mhea_json_result_write(mdi, mor); // Output the results structure as a JSON
+      phase_end(PP_OUTPUT_WRITE);
+    }
 
     if (cmds.do_output_validation) json_schema_validate_output(MHEA_OUTPUT_JSON_SCHEMA_FILE);
 
@@ -123,6 +183,7 @@ int main(int argc, char **argv) {
   }
 
   if (cwd) {free(cwd); cwd = NULL;}
+  free_mdi_pool();
 
   // Time for cleanup just in case this function someday gets expanded or called separately
   // Normally all these will fall out of scope naturally at the return, but good practice to
@@ -10,6 +10,7 @@
 
 #include "version.h"
 #define WA_VERSION BUILD_VERSION " " BUILD_TIMESTAMP
+extern const char build_id[]; // this build of the engine, written by src/common/build_id.cmake
 #define WA_CONTACT_EMAIL "<ternesmp@ornl.gov>"
 #define WA_DESCRIPTION "USDOE/ORNL Weatherization Assistant analysis engine"
 
@@ -27,6 +28,7 @@
 #include "fuels.h"             // common fuel price functions
 #include "weather.h"           // common weather functions
 #include "utility.h"           // common utility functions
+#include "performance.h"       // common phase timing and counters
 
 #include "../neat/constant.h"            // NEAT defined constants
 #include "../neat/definition.h"          // NEAT defines
@@ -67,6 +69,11 @@
 #include "../mhea/json.h"                // MHEA JSON handling
 
 #include "../mhea/mhea.h"                // MHEA top level
+#include "../mhea/sweep.h"               // MHEA repeated runs of one audit
+#include "../mhea/optimize.h"            // MHEA budget constrained package
+#include "../mhea/scenario.h"            // MHEA economic scenarios
+#include "../mhea/batch.h"               // MHEA batches of audits reduced to fleet aggregates
+#include "../mhea/cache.h"               // MHEA first pass results kept across runs
 
 #include "infiltration.h"      // common infiltration and duct leakage calculations
 
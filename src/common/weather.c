@@ -19,6 +19,7 @@
 static void solar_load_ratio_data(void);
 static void solar_load_ratio_calculate();
 static void do_interpolate(float fract, float slr1[MONTHS + 1][SLR_DIFFUSE + 1], float slr2[MONTHS + 1][SLR_DIFFUSE + 1]);
+static void duct_psychrometrics(float drybulb[MONTHS + 1], float wetbulb[MONTHS + 1], DUCT_PSYCHROMETRICS *psy);
 
 // All weather and solar data read here
 // Solar data base on north_latitude contained in weather WX file
@@ -31,6 +32,9 @@ void read_weather_file(WTH *w) {
 
   ASSERT(cwd, sprintf(msg, "You must have Common Weather Data structure to run engine"));
 
+  if (w->file[0] && strcmp(cwd->weather_file, w->file) == 0) // already read, eg. by the previous run of a sweep
+    return;
+
   // weather_name(filepath); // gets path name of the weather data file
   STRCPY(filepath, WEATHER_DIR);
   STRCAT(filepath, w->file);
@@ -167,9 +171,54 @@ void read_weather_file(WTH *w) {
     cwd->days_in_year_for_month[m] = cwd->days_in_year_for_month[m - 1] + cwd->days_in_month[m - 1];
   }
 
+  duct_psychrometrics(cwd->avg_drybulb_temp, cwd->avg_wetbulb_temp, &cwd->duct_psy_monthly);
+  duct_psychrometrics(cwd->avg_temp, cwd->avg_wet_temp, &cwd->duct_psy_bins);
+
+  STRCPY(cwd->weather_file, w->file);
+
   return;
 }
 
+// The problem, if any, that would stop read_weather_file() on the WX file
+// named file (the file can not be opened, or has a bad first month line or
+// latitude), for callers that go on without it, eg. the weather sweep.
+// Returns NULL when the file reads.
+const char *check_weather_file(const char *file) {
+  static char reason[MAX_ASSERT_MESSAGE_LEN];
+  FILE *wxfile;
+  char line[80];
+  char filepath[PATH_LEN];
+  float latitude = 0.0f;
+  int nc;
+
+  if (strlen(file) > SHORT_NAME_LEN || strlen(WEATHER_DIR) + strlen(file) >= sizeof(filepath)) {
+    snprintf(reason, sizeof(reason), "Weather file name too long: %s", file);
+    return reason;
+  }
+  snprintf(filepath, sizeof(filepath), "%s%s", WEATHER_DIR, file);
+
+  wxfile = fopen(filepath, "r");
+  if (!wxfile) {
+    snprintf(reason, sizeof(reason), "Failed to open the input weather file: %s code:%d:%s", filepath, errno, strerror(errno));
+    return reason;
+  }
+
+  fgets(line, 80, wxfile);             // city name
+  nc = getf_line(line, 80, wxfile);    // month heading
+  if (nc <= 0 || !fgets(line, 80, wxfile) || sscanf(line, "%*f%*f%*f%*f%f", &latitude) != 1) {
+    fclose(wxfile);
+    snprintf(reason, sizeof(reason), "Error in first line of wx file: %s", filepath);
+    return reason;
+  }
+  fclose(wxfile);
+
+  if (!(latitude > 20.0 && latitude < 52.0)) {
+    snprintf(reason, sizeof(reason), "Latitude outside acceptable range: %f", latitude);
+    return reason;
+  }
+  return NULL;
+}
+
 // This assigns solar load ratio values from what what previously stored in a separate slr.inp file
 // These should not change  #126 MJF 5/2020
 
@@ -363,11 +412,67 @@ float enthalpy(float dbt, float RH, float tambR, float *wout) {
   pw = RH * pws;
   w = 0.62198f * pw / (patm - pw);
   *wout = w;
-  h = 0.240f * tambR + w * (1061.0f + 0.444f * tambR);
+  h = moist_air_enthalpy(tambR, w);
   // fprintf(stderr, "\n pws = %8.3f,  h = %8.3f", pws,h);
   return (h);
 }
 
+// Enthalpy (Btu/lb) of air at dry bulb temperature tdb with humidity ratio w
+
+float moist_air_enthalpy(float tdb, float w) {
+  return (0.240f * tdb + w * (1061.0f + 0.444f * tdb));
+}
+
+// Find the average heating and cooling outdoor ambient temperatures and RH
+// for the duct efficiency calculations, formerly done on every call.
+// Cooling is average of monthly temperautures above 65 F, heating those below.
+// If no monthly temperatures are above or below 65 to form seasonal average,
+// use the maximum or minumum monthly temperatures as the average.
+
+static void duct_psychrometrics(float drybulb[MONTHS + 1], float wetbulb[MONTHS + 1], DUCT_PSYCHROMETRICS *psy) {
+  int nhtm = 0, nclm = 0;
+  float tdb_ht = 0.0f, tdb_cl = 0.0f, RH = 0.0f, rhatmax = 0.0f;
+  float tdb_min_ht = 100.0f, tdb_max_cl = -100.0f;
+
+  for (int m = 1; m <= MONTHS; m++) {
+    float tom = drybulb[m];
+    if (tom < 65.0f) {
+      if (m == DECEMBER || m < APRIL) {
+        tdb_ht += tom;
+        nhtm++;
+      }
+    }
+    if (tom < tdb_min_ht)
+      tdb_min_ht = tom;
+    if (tom > 65.0f) {
+      tdb_cl += tom;
+      RH += relative_humidity(tom, wetbulb[m], cwd->altitude);
+      nclm++;
+    }
+    if (tom > tdb_max_cl) {
+      tdb_max_cl = tom;
+      rhatmax = relative_humidity(tdb_max_cl, wetbulb[m], cwd->altitude);
+    }
+  }
+
+  if (nhtm > 0)
+    tdb_ht /= (float)nhtm;
+  else
+    tdb_ht = tdb_min_ht;
+  if (nclm > 0) {
+    tdb_cl /= (float)nclm;
+    RH /= (float)nclm;
+  } else {
+    tdb_cl = tdb_max_cl;
+    RH = rhatmax;
+  }
+
+  psy->tdb_ht = tdb_ht;
+  psy->tdb_cl = tdb_cl;
+  psy->rh = RH;
+  psy->hout = enthalpy(tdb_cl, RH, tdb_cl, &psy->w);
+}
+
  // Routine to determine degree hours from balance point using linear interpolation between tabulated values from WX file
 
 void adjusted_monthly_degree_hours(float tbalt[][COOLING + 1][MONTHS + 1], float adht[][MONTHS + 1]) {
@@ -62,6 +62,18 @@ enum SOLAR_ORIENTATION // NEAT uses NESW ordering in arrays whereas input is NSE
   SOLAR_HORIZONTAL_TOTAL,
   SOLAR_DIFFUSE };
 
+// Seasonal outdoor psychrometrics used by the ASHRAE 152 duct efficiency
+// calculations.  They depend only on the weather file so they are computed
+// once when it is read (see duct_psychrometrics()).
+
+typedef struct {
+  float tdb_ht;   // Outdoor dry bulb temperature, heating season average F
+  float tdb_cl;   // Outdoor dry bulb temperature, cooling season average F
+  float rh;       // Seasonal (summer) relative humidity
+  float w;        // Cooling season outdoor humidity ratio (lb water / lb dry air)
+  float hout;     // Cooling season outdoor enthalpy (Btu/lb)
+} DUCT_PSYCHROMETRICS;
+
 // ****************************************************
 // The WEATHER struct is a representation of the info
 // collected by the Setup - Weather Data Site input form.
@@ -76,6 +88,7 @@ typedef struct {
   float slr_48[MONTHS + 1][SLR_DIFFUSE + 1];    // latitude 48 solar load ratio data
 
   // weather file .WX data
+  char weather_file[SHORT_NAME_LEN + 1];      // WX file the data was read from, a repeat read of it is skipped
   char city_name[CITYNAME_LEN];               // city name from the WX file
   float north_latitude;                       // (Degrees) = Degrees north latitude
   float altitude;                             // (feet) = Altitude of weather city
@@ -107,6 +120,9 @@ typedef struct {
 
   float avg_drybulb_temp_55;                  // avg dry bulb temp F for all months where avg_drybulb_temp[i] < 55F
 
+  DUCT_PSYCHROMETRICS duct_psy_monthly;       // from avg_drybulb_temp[] and avg_wetbulb_temp[] (NEAT)
+  DUCT_PSYCHROMETRICS duct_psy_bins;          // from avg_temp[] and avg_wet_temp[] (MHEA)
+
   float hdd65;          // ( Deg F - Days) = HDD base 65 F
   float cdd75;          // ( Deg F - Days) = CDD base 75 F
   float cdd74;          // ( Deg F - Days) = CDD base 74 F
@@ -119,8 +135,10 @@ typedef struct {
 } CWD;    // Common Weather Data
 
 void read_weather_file(WTH *w);
+const char *check_weather_file(const char *file);
 float relative_humidity(float drybt, float wetbt, float alt);
 float enthalpy(float dbt, float RH, float tambR, float *wout);
+float moist_air_enthalpy(float tdb, float w);
 void adjusted_monthly_degree_hours(float tbalt[][COOLING + 1][MONTHS + 1], float adht[][MONTHS + 1]);
 float interpolate_degree_hours(float balance_temp, int heat_cool, int day_night, int month);
 int doy(int month, int day);
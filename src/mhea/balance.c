@@ -27,6 +27,31 @@
 
 #include "wa_engine.h"
 
+#define OVERHANG_RATIOS 5 // shading ratio columns of the overhang modifier
+
+static void overhang_table(float fLatitude);
+static int overhang_ratio_index(float fShadingRatio);
+
+/***************************************************/
+/*  This array of coefficients is for calculating  */
+/*   the Overhang Modifier (see p. 47.2)                */
+/***************************************************/
+static const float fB[OVERHANG_RATIOS][7] = {
+    {1.113f, 5.1346f, 34.787f, 110.97f, 188.87f, 164.35f, 57.283f}, /* For fRatioW2H == 1/8 */
+    {1.389f, 10.235f, 57.238f, 153.67f, 223.11f, 167.96f, 51.280f}, /* For fRatioW2H == 1/4 */
+    {1.349f, 7.8189f, 28.720f, 42.75f, 27.37f, 5.710f, 0.0f},       /* For fRatioW2H == 3/8 */
+    {1.325f, 6.7539f, 19.550f, 20.28f, 6.9f, 0.0f, 0.0f},           /* For fRatioW2H == 1/2 */
+    {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}};                    /* For fRatioW2H > 1 */
+
+/*****************************
+Overhang modifiers by month and shading ratio column for the weather
+station in use.  They depend only on the latitude, so the table is built
+once per station instead of on every component_solar_gain() call.
+*****************************/
+static float fOverhangMod_Table[MONTHS + 1][OVERHANG_RATIOS];
+static float fOverhangMod_Latitude;
+static int flgOverhangMod_Table = FALSE;
+
 /*******************  FUNCTION NAME:  SolarGain  *************************/
 /**         DATE:  3/9/93                                                               **/
 /**           BY:    SLF                                                                    **/
@@ -42,7 +67,6 @@ float component_solar_gain(int iComponent, int iMonth, float fShadingRatioAwn, f
   /**********************************/
   int i, iOrien; /* Counting variables */
 
-  float fB[5][7];            /* Overhang Modifier Coefficients */
   float fOverhangMod;        /* Overhang Modifier (for South */
                              /*  Facing Surfaces) (unitless) */
   float fOverhangMod0 = 0.0; /* Overhang Modifier for window */
@@ -54,10 +78,6 @@ float component_solar_gain(int iComponent, int iMonth, float fShadingRatioAwn, f
   float fSolarFluxTotal, fSolarFluxDiffuse, fSolarFluxDirect;
   float fSG = 0.0;          /* Solar Gain (Btu/h) */
   float fTransmisMod = 0.0; /* Transmissivity Modifier (frac.) */
-  float fDeclination;       /* Solar Declination (degrees) */
-  float fSolarAngle;        /* Solar Noon Zenith Angle (degrees */
-  float fN[MONTHS + 1] =            /* Day of Year - for Solar Decl. */
-      {0, 15.0, 45.0, 75.0, 106.0, 136.0, 167.0, 197.0, 228.0, 259.0, 289.0, 320.0, 350.0};
 
   /**NW, 8/8/95:  The seasonal modifier for glazing transmission has been
   estimated as follows - Single and Double glazed coefficients were averaged for
@@ -67,7 +87,7 @@ float component_solar_gain(int iComponent, int iMonth, float fShadingRatioAwn, f
   in solar aperture calculations (UA_WIN.C).  EAST/WEST seasonal corrections are weaker
   based on Balcomb's corelation and have therefore been set to a constant 1.0. **/
 
-  float fNrmlTmod[MONTHS + 1] = /* Normalized transmission modifier data */
+  static const float fNrmlTmod[MONTHS + 1] = /* Normalized transmission modifier data */
       {0, 1.00F, 0.98F, 0.94F, 0.88F, 0.83F, 0.82F, 0.83F, 0.82F, 0.84F, 0.90F, 0.96F, 0.99F};
   // NW, 8/10/95, test ramp for higher summer solar to match observed trend
   //     from DOE2
@@ -103,57 +123,11 @@ float component_solar_gain(int iComponent, int iMonth, float fShadingRatioAwn, f
   // if (mdi->gnl.wind_shielding == WS_EXPOSED)
   //   fExposure = 1.0;
 
-  /***************************************************/
-  /*  This array of coefficients is for calculating  */
-  /*   the Overhang Modifier (see p. 47.2)                */
-  /***************************************************/
-
-  /* For fRatioW2H == 1/8 */
-  fB[0][0] = 1.113f;
-  fB[0][1] = 5.1346f;
-  fB[0][2] = 34.787f;
-  fB[0][3] = 110.97f;
-  fB[0][4] = 188.87f;
-  fB[0][5] = 164.35f;
-  fB[0][6] = 57.283f;
-  /* For fRatioW2H == 1/4 */
-  fB[1][0] = 1.389f;
-  fB[1][1] = 10.235f;
-  fB[1][2] = 57.238f;
-  fB[1][3] = 153.67f;
-  fB[1][4] = 223.11f;
-  fB[1][5] = 167.96f;
-  fB[1][6] = 51.280f;
-  /* For fRatioW2H == 3/8 */
-  fB[2][0] = 1.349f;
-  fB[2][1] = 7.8189f;
-  fB[2][2] = 28.720f;
-  fB[2][3] = 42.75f;
-  fB[2][4] = 27.37f;
-  fB[2][5] = 5.710f;
-  fB[2][6] = 0.0f;
-  /* For fRatioW2H == 1/2 */
-  fB[3][0] = 1.325f;
-  fB[3][1] = 6.7539f;
-  fB[3][2] = 19.550f;
-  fB[3][3] = 20.28f;
-  fB[3][4] = 6.9f;
-  fB[3][5] = 0.0f;
-  fB[3][6] = 0.0f;
-  /* For fRatioW2H > 1 */
-  fB[4][0] = 0.0f;
-  fB[4][1] = 0.0f;
-  fB[4][2] = 0.0f;
-  fB[4][3] = 0.0f;
-  fB[4][4] = 0.0f;
-  fB[4][5] = 0.0f;
-  fB[4][6] = 0.0f;
-
-  /*****************************/
-  /*  Solar Noon Zenith Angle  */
-  /*****************************/
-  fDeclination = 23.45f * (float)sin(2.0f * PI * (284.0f + fN[iMonth]) / 365.0f);
-  fSolarAngle = (fLatitude - fDeclination) / 100.0f;
+  /*********************************/
+  /*  Overhang Modifiers by month  */
+  /*********************************/
+  if (!flgOverhangMod_Table || fLatitude != fOverhangMod_Latitude)
+    overhang_table(fLatitude);
 
   /*************************************/
   /*  Orientation specific components  */
@@ -209,20 +183,8 @@ float component_solar_gain(int iComponent, int iMonth, float fShadingRatioAwn, f
           if ((fShadingRatioW2H == 0.0) || (fShadingRatioL == 0.0))
             fOverhangMod = 1.0;
           else {
-            if (fShadingRatioW2H <= (3.0 / 16.0))
-              i = 0; /* Use values for 1/8 */
-            else if (fShadingRatioW2H <= (5.0 / 16.0))
-              i = 1; /* Use values for 1/4 */
-            else if (fShadingRatioW2H <= (7.0 / 16.0))
-              i = 2; /* Use values for 3/8 */
-            else if (fShadingRatioW2H < 1.0)
-              i = 3; /* Use values for 1/2 */
-            else     /* fShadingRatioW2H >= 1.0  */
-              i = 4; /* Use values for 1 */
-            fOverhangMod = (fB[i][0] * (float)pow(fSolarAngle, 0)) - (fB[i][1] * (float)pow(fSolarAngle, 1)) +
-                           (fB[i][2] * (float)pow(fSolarAngle, 2)) - (fB[i][3] * (float)pow(fSolarAngle, 3)) +
-                           (fB[i][4] * (float)pow(fSolarAngle, 4)) - (fB[i][5] * (float)pow(fSolarAngle, 5)) +
-                           (fB[i][6] * (float)pow(fSolarAngle, 6));
+            i = overhang_ratio_index(fShadingRatioW2H);
+            fOverhangMod = fOverhangMod_Table[iMonth][i];
           }
         }
         if (iComponent == 2) /* iWINDOW */
@@ -241,20 +203,8 @@ float component_solar_gain(int iComponent, int iMonth, float fShadingRatioAwn, f
           Some or all of south windows are shaded by awnings.
           *******************/
           {
-            if (fShadingRatioAwn <= (3.0 / 16.0))
-              i = 0; /* Use values for 1/8 */
-            else if (fShadingRatioAwn <= (5.0 / 16.0))
-              i = 1; /* Use values for 1/4 */
-            else if (fShadingRatioAwn <= (7.0 / 16.0))
-              i = 2; /* Use values for 3/8 */
-            else if (fShadingRatioAwn < 1.0)
-              i = 3; /* Use values for 1/2 */
-            else     /* fShadingRatioAwn >= 1.0  */
-              i = 4; /* Use values for 1 */
-            fOverhangMod = (fB[i][0] * (float)pow(fSolarAngle, 0)) - (fB[i][1] * (float)pow(fSolarAngle, 1)) +
-                           (fB[i][2] * (float)pow(fSolarAngle, 2)) - (fB[i][3] * (float)pow(fSolarAngle, 3)) +
-                           (fB[i][4] * (float)pow(fSolarAngle, 4)) - (fB[i][5] * (float)pow(fSolarAngle, 5)) +
-                           (fB[i][6] * (float)pow(fSolarAngle, 6));
+            i = overhang_ratio_index(fShadingRatioAwn);
+            fOverhangMod = fOverhangMod_Table[iMonth][i];
           }
           if (fShadingRatioW2H > 0.0)
           /*****************
@@ -346,6 +296,52 @@ float component_solar_gain(int iComponent, int iMonth, float fShadingRatioAwn, f
 
 } /* End of function component_solar_gain() */
 
+/*******************  FUNCTION NAME:  overhang_table  *************************/
+/** DESCRIPTION:    Evaluates the overhang modifier polynomial (p. 47.2) for **/
+/**                 each month and shading ratio column at the station      **/
+/**                 latitude.                                                **/
+/*****************************************************************************/
+static void overhang_table(float fLatitude) {
+  float fDeclination; /* Solar Declination (degrees) */
+  float fSolarAngle;  /* Solar Noon Zenith Angle (degrees */
+  static const float fN[MONTHS + 1] = /* Day of Year - for Solar Decl. */
+      {0, 15.0, 45.0, 75.0, 106.0, 136.0, 167.0, 197.0, 228.0, 259.0, 289.0, 320.0, 350.0};
+
+  for (int iMonth = 1; iMonth <= MONTHS; iMonth++) {
+    /*****************************/
+    /*  Solar Noon Zenith Angle  */
+    /*****************************/
+    fDeclination = 23.45f * (float)sin(2.0f * PI * (284.0f + fN[iMonth]) / 365.0f);
+    fSolarAngle = (fLatitude - fDeclination) / 100.0f;
+
+    for (int i = 0; i < OVERHANG_RATIOS; i++)
+      fOverhangMod_Table[iMonth][i] = (fB[i][0] * (float)pow(fSolarAngle, 0)) - (fB[i][1] * (float)pow(fSolarAngle, 1)) +
+                                      (fB[i][2] * (float)pow(fSolarAngle, 2)) - (fB[i][3] * (float)pow(fSolarAngle, 3)) +
+                                      (fB[i][4] * (float)pow(fSolarAngle, 4)) - (fB[i][5] * (float)pow(fSolarAngle, 5)) +
+                                      (fB[i][6] * (float)pow(fSolarAngle, 6));
+  }
+
+  fOverhangMod_Latitude = fLatitude;
+  flgOverhangMod_Table = TRUE;
+}
+
+/*******************  FUNCTION NAME:  overhang_ratio_index  *******************/
+/** DESCRIPTION:    Column of the overhang modifier table for a shading     **/
+/**                 ratio.                                                   **/
+/*****************************************************************************/
+static int overhang_ratio_index(float fShadingRatio) {
+  if (fShadingRatio <= (3.0 / 16.0))
+    return 0; /* Use values for 1/8 */
+  else if (fShadingRatio <= (5.0 / 16.0))
+    return 1; /* Use values for 1/4 */
+  else if (fShadingRatio <= (7.0 / 16.0))
+    return 2; /* Use values for 3/8 */
+  else if (fShadingRatio < 1.0)
+    return 3; /* Use values for 1/2 */
+  else        /* fShadingRatio >= 1.0  */
+    return 4; /* Use values for 1 */
+}
+
 /*******************  FUNCTION NAME:  sky_radiation_losses  *******************/
 /**         DATE:  March 1993                                                           **/
 /**           BY:    JG                                                                 **/
@@ -419,6 +415,7 @@ void mhea_infiltration_losses(int iSeason, int iMonth, float fElevation, float f
       fACH;                       // Air Changes per Hour calculated in this function.
   float fDuctFraction = 1.0;      // Outside duct fraction.
   float fwindsp;                  // Monthly average wind speed (mhp)
+  float fwindsp_pow;              // Wind speed term of the leakage rate, the same for every window and door
 
   float fwn_cfm_tot;              // Total window plus windows in addition leakage rate under natural conditions
   static float STfwnCfmTot[MONTHS + 1];  // Prior pass' total window inf. If current change subtract difference from whole house loss
@@ -454,23 +451,24 @@ void mhea_infiltration_losses(int iSeason, int iMonth, float fElevation, float f
   for (i = BIN_00_04; i <= BIN_20_24; i++) // time of day bins
     fwindsp += fWindSpeed[i];
   fwindsp /= 6.0f;
+  fwindsp_pow = (float)POWC(fwindsp, 1.6);
 
   // All windows infiltration CFM
   fwn_cfm_tot = 0.0f;
   for (j = 0; j < mdi->num_win; j++) {
-    fwn_cfm_tot += 0.1f * mdi->win[j].leak_coef * (float)POWC(fwindsp, 1.6) * mir->window_cfm_adjustment * window_perimeter(&mdi->win[j]) / fS;
+    fwn_cfm_tot += 0.1f * mdi->win[j].leak_coef * fwindsp_pow * mir->window_cfm_adjustment * window_perimeter(&mdi->win[j]) / fS;
   }
   for (j = 0; j < mdi->num_awn; j++) {
-    fwn_cfm_tot += 0.1f * mdi->awn[j].leak_coef * (float)POWC(fwindsp, 1.6) * mir->window_cfm_adjustment * window_perimeter(&mdi->awn[j]) / fS;
+    fwn_cfm_tot += 0.1f * mdi->awn[j].leak_coef * fwindsp_pow * mir->window_cfm_adjustment * window_perimeter(&mdi->awn[j]) / fS;
   }
 
   // All doors infiltration CFM
   fdr_cfm_tot = 0.0f;
   for (j = 0; j < mdi->num_dor; j++) {
-    fdr_cfm_tot += 0.1f * mdi->dor[j].leak_coef * (float)POWC(fwindsp, 1.6) * mir->window_cfm_adjustment * door_perimeter(&mdi->dor[j]) / fS;
+    fdr_cfm_tot += 0.1f * mdi->dor[j].leak_coef * fwindsp_pow * mir->window_cfm_adjustment * door_perimeter(&mdi->dor[j]) / fS;
   }
   for (j = 0; j < mdi->num_adr; j++) {
-    fdr_cfm_tot += 0.1f * mdi->adr[j].leak_coef * (float)POWC(fwindsp, 1.6) * mir->window_cfm_adjustment * door_perimeter(&mdi->adr[j]) / fS;
+    fdr_cfm_tot += 0.1f * mdi->adr[j].leak_coef * fwindsp_pow * mir->window_cfm_adjustment * door_perimeter(&mdi->adr[j]) / fS;
   }
 
   /*********************
@@ -738,10 +736,9 @@ void mhea_infiltration_losses(int iSeason, int iMonth, float fElevation, float f
 
   // Do not reduce below zero #354
   if (*fInfMassFlow < 0.0) {
-    static int added_message = FALSE;
-    if (added_message == FALSE) {
+    if (!(mor->once_message & MSG_ONCE_ZERO_INFILTRATION)) {
       add_mhea_message("Infiltration mass flow (other than windows and doors) is ZERO.  Perhaps you have too much window and door leakiness relative to your blower door values.");
-      added_message = TRUE;
+      mor->once_message |= MSG_ONCE_ZERO_INFILTRATION;
     }
   *fInfMassFlow = 10.0;    // don't want to trip over later assert failure so this is a minimum airflow #369
   }
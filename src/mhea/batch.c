@@ -0,0 +1,808 @@
+/***************************************************************************
+* MODULE:       batch.c            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        A batch of MHEA audits reduced to fleet aggregates.  Each
+*               audit is run in turn and its results folded into the
+*               reducers as soon as it is done, so only the aggregates are
+*               kept: per group (keys taken from the audit input and the
+*               results) the count, sum, minimum and maximum of each value,
+*               a histogram over given bin edges and a quantile sketch.
+*
+*               Every one of those merges by adding up, so a large fleet
+*               can be split over several engine processes (the workers),
+*               each writing its aggregates in partial form, and the
+*               partials merged by one more batch into the final document.
+*
+*               The quantile sketch keeps counts in buckets whose bounds
+*               grow by a constant factor, so each quantile is within
+*               FLEET_SKETCH_ALPHA of its value relative to it.
+****************************************************************************/
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "wa_engine.h"
+
+#define FLEET_MAX_REDUCERS 16    // reducers in a batch spec
+#define FLEET_MAX_KEYS 8         // group by keys of a reducer
+#define FLEET_MAX_VALUES 16      // values a reducer summarizes
+#define FLEET_MAX_QUANTILES 16   // quantiles reported for each value
+#define FLEET_MAX_BINS 64        // histogram bin edges of a value
+#define FLEET_KEY_LEN 1024       // all the key texts of a group together
+#define FLEET_SKETCH_ALPHA 0.01  // relative accuracy of the quantiles
+#define FLEET_SKETCH_MIN 1.0e-6  // smaller magnitudes count as zero
+#define FLEET_SKETCH_BUCKETS 2048 // up to FLEET_SKETCH_MIN * 6e17
+
+enum FLEET_STATS {
+  FLEET_COUNT = 1,
+  FLEET_SUM = 2,
+  FLEET_MEAN = 4,
+  FLEET_MIN = 8,
+  FLEET_MAX = 16,
+  FLEET_QUANTILES = 32,
+  FLEET_HISTOGRAM = 64
+};
+
+static const struct {
+  const char *name;
+  enum FLEET_STATS stat;
+} fleet_stat_names[] = {{"count", FLEET_COUNT}, {"sum", FLEET_SUM},             {"mean", FLEET_MEAN},
+                        {"min", FLEET_MIN},     {"max", FLEET_MAX},             {"quantiles", FLEET_QUANTILES},
+                        {"histogram", FLEET_HISTOGRAM}};
+
+typedef struct {
+  long zero;                       // values too small to place
+  long pos[FLEET_SKETCH_BUCKETS];  // bucket k holds values to FLEET_SKETCH_MIN * gamma^k
+  long neg[FLEET_SKETCH_BUCKETS];  // and the negative values by magnitude
+} FLEET_SKETCH;
+
+typedef struct {
+  const char *result;           // JSON pointer into the result row
+  int stats;                    // FLEET_STATS written
+  double bin[FLEET_MAX_BINS];   // histogram bin edges, increasing
+  int num_bin;
+} FLEET_VALUE;
+
+typedef struct {
+  long count;            // rows with the value
+  double sum, min, max;
+  FLEET_SKETCH *sketch;  // when quantiles are written
+  long *histogram;       // below the first edge, between each, above the last
+} FLEET_STAT;
+
+typedef struct {
+  char key[FLEET_KEY_LEN]; // key texts, separated by \x1f
+  cJSON *jkey;             // and as an array of strings
+  long rows;
+  FLEET_STAT *stat;        // for each value
+} FLEET_GROUP;
+
+typedef struct {
+  const char *name;
+  const char *each;              // rows are the elements of this results array, or the results
+  struct {
+    int input;                   // from the audit input, else the result row
+    const char *pointer;
+  } key[FLEET_MAX_KEYS];
+  int num_key;
+  FLEET_VALUE value[FLEET_MAX_VALUES];
+  int num_value;
+  double quantile[FLEET_MAX_QUANTILES]; // percent
+  int num_quantile;
+  FLEET_GROUP *group;
+  int num_group, max_group;
+} FLEET_REDUCER;
+
+static double log_gamma; // of the sketch's bucket growth factor
+
+static cJSON *batch_audit(cJSON *json_input, cJSON *json_schema, int row, const char **error);
+static cJSON *batch_audit_run(cJSON *json_input, cJSON *json_schema, int row);
+static int fleet_reducers(cJSON *jspec, FLEET_REDUCER *reducer);
+static void fleet_reduce(FLEET_REDUCER *r, cJSON *json_input, cJSON *jresult);
+static void fleet_add_row(FLEET_REDUCER *r, cJSON *json_input, cJSON *jrow);
+static FLEET_GROUP *fleet_group(FLEET_REDUCER *r, const char *key, cJSON *jkey);
+static void fleet_add(FLEET_STAT *s, const FLEET_VALUE *v, double x);
+static void fleet_merge(FLEET_REDUCER *reducer, int num_reducer, cJSON *jpartial);
+static void fleet_merge_stat(FLEET_STAT *s, const FLEET_VALUE *v, cJSON *jstat);
+static cJSON *fleet_aggregate(FLEET_REDUCER *r, int partial);
+static cJSON *fleet_stat(FLEET_REDUCER *r, FLEET_STAT *s, const FLEET_VALUE *v, int partial);
+static cJSON *sketch_buckets(const long *bucket);
+static double sketch_quantile(const FLEET_SKETCH *sketch, long count, double pct);
+static void key_text(cJSON *item, char *text, size_t len);
+static void fleet_free(FLEET_REDUCER *r);
+
+/***************************************************************************
+ ** Function Name: run_mhea_batch
+ **
+ **  DESCRIPTION:  Run a batch of audits and reduce their results.  The
+ **                spec file holds
+ **
+ **                  {"audits": "audits.txt",
+ **                   "results": "none",
+ **                   "reducers": [
+ **                    {"name": "savings_by_measure", "each": "/measures",
+ **                     "group_by": [{"input": "/weather_location/state"},
+ **                                  {"result": "/measure"}],
+ **                     "values": [
+ **                       {"result": "/savings", "stats": ["count", "sum", "mean"]},
+ **                       {"result": "/sir", "stats": ["quantiles", "histogram"],
+ **                        "bins": [0, 1, 2, 5]}],
+ **                     "quantiles": [5, 50, 95]}]}
+ **
+ **                audits is a file listing the audit input JSON files, one
+ **                per line (blank lines and lines starting with # are
+ **                skipped), or an array of them.  A reducer's rows are the
+ **                elements of the each array of an audit's results, or the
+ **                results themselves when there is no each.  Its keys and
+ **                values are JSON pointers into the audit input or the
+ **                row; a value that is missing or not a number is not
+ **                counted.  results is none, rows (a sweep_row() for each
+ **                audit) or full (all of each audit's results).  With
+ **                "partial": true the aggregates are written in the form
+ **                "merge": [FILE, ...] folds back in, with the same
+ **                reducers, before the audits of this batch.
+ **
+ **                An audit that cannot be read or does not pass the input
+ **                schema is not run: it is listed in failures with the
+ **                reason, counted in failed, and the batch goes on.  Each
+ **                audit is run in a child process (not on Windows, where
+ **                it is run in this one), so one that stops the engine on
+ **                an ASSERT is listed the same way, with the ASSERT
+ **                message, and the aggregates so far are kept.
+ **************************************************************************/
+void run_mhea_batch(const char *spec_path, cJSON *json_schema) {
+  cJSON *jspec = parse_json_file(spec_path);
+  cJSON *jaudits = cJSON_GetObjectItem(jspec, "audits");
+  cJSON *jmode = cJSON_GetObjectItem(jspec, "results");
+  cJSON *jmerge = cJSON_GetObjectItem(jspec, "merge");
+  cJSON *jroot = cJSON_CreateObject();
+  cJSON *jbatch = cJSON_CreateObject();
+  cJSON *jresults = NULL, *jfailures = cJSON_CreateArray(), *jlist, *jitem;
+  FLEET_REDUCER *reducer;
+  FILE *list = NULL;
+  char line[PATH_LEN];
+  int num_reducer, partial = cJSON_IsTrue(cJSON_GetObjectItem(jspec, "partial"));
+  int full = FALSE, num_audit = 0, num_failed = 0;
+  char *output;
+
+  log_gamma = log((1.0 + FLEET_SKETCH_ALPHA) / (1.0 - FLEET_SKETCH_ALPHA));
+
+  ASSERT((reducer = (FLEET_REDUCER *)calloc(FLEET_MAX_REDUCERS, sizeof(FLEET_REDUCER))), sprintf(msg, "Out of memory on the batch reducers"));
+  num_reducer = fleet_reducers(jspec, reducer);
+
+  if (jmode) {
+    ASSERT(cJSON_IsString(jmode) && (strcmp(jmode->valuestring, "none") == 0 || strcmp(jmode->valuestring, "rows") == 0 ||
+                                     strcmp(jmode->valuestring, "full") == 0),
+           sprintf(msg, "Batch results must be none, rows or full"));
+    if (strcmp(jmode->valuestring, "none") != 0)
+      jresults = cJSON_CreateArray();
+    full = strcmp(jmode->valuestring, "full") == 0;
+  }
+
+  if (jmerge) { // other workers' partial aggregates
+    ASSERT(cJSON_IsArray(jmerge), sprintf(msg, "Batch merge must be an array of partial aggregate files"));
+    cJSON_ArrayForEach(jitem, jmerge) {
+      cJSON *jpartial, *jpbatch, *jfailure;
+      ASSERT(cJSON_IsString(jitem), sprintf(msg, "Batch merge must be an array of partial aggregate files"));
+      jpartial = parse_json_file(jitem->valuestring);
+      jpbatch = cJSON_GetObjectItem(jpartial, "batch");
+      ASSERT(cJSON_IsTrue(cJSON_GetObjectItem(jpbatch, "partial")), sprintf(msg, "Not partial batch aggregates: %s", jitem->valuestring));
+      num_audit += cJSON_GetObjectItem(jpbatch, "audits") ? cJSON_GetObjectItem(jpbatch, "audits")->valueint : 0;
+      num_failed += cJSON_GetObjectItem(jpbatch, "failed") ? cJSON_GetObjectItem(jpbatch, "failed")->valueint : 0;
+      cJSON_ArrayForEach(jfailure, cJSON_GetObjectItem(jpbatch, "failures"))
+        cJSON_AddItemToArray(jfailures, cJSON_Duplicate(jfailure, TRUE));
+      fleet_merge(reducer, num_reducer, cJSON_GetObjectItem(jpbatch, "aggregates"));
+      cJSON_Delete(jpartial);
+    }
+  }
+
+  if (cJSON_IsString(jaudits)) {
+    list = fopen(jaudits->valuestring, "r");
+    ASSERT(list, sprintf(msg, "Failed to open the batch audit list: %s code:%d:%s", jaudits->valuestring, errno, strerror(errno)));
+  } else {
+    ASSERT(jaudits == NULL || cJSON_IsArray(jaudits), sprintf(msg, "Batch audits must be a list file or an array of audit files"));
+  }
+  jitem = cJSON_IsArray(jaudits) ? jaudits->child : NULL;
+
+  for (;;) { // each audit
+    const char *path, *error;
+    cJSON *json_input, *jrun = NULL, *jresult;
+
+    if (list) {
+      char *p = line;
+      int n;
+      if (!fgets(line, sizeof(line), list))
+        break;
+      while (isspace((unsigned char)*p))
+        p++;
+      n = (int)strlen(p);
+      while (n > 0 && isspace((unsigned char)p[n - 1]))
+        p[--n] = '\0';
+      if (n == 0 || p[0] == '#')
+        continue;
+      path = p;
+    } else {
+      if (jitem == NULL)
+        break;
+      ASSERT(cJSON_IsString(jitem), sprintf(msg, "Batch audits must be an array of audit file names"));
+      path = jitem->valuestring;
+      jitem = jitem->next;
+    }
+
+    if (cmds.debug_level & D_NORMAL)
+      fprintf(stderr, "\n\nBATCH: audit %d %s", num_audit + 1, path);
+
+    json_input = try_parse_json_file(path, &error);
+    if (error == NULL)
+      error = json_schema_check(json_input, json_schema);
+    if (error == NULL)
+      jrun = batch_audit(json_input, json_schema, jresults && !full, &error);
+    if (error) { // noted and left out, the batch goes on
+      cJSON *jfailure = cJSON_CreateObject();
+      if (cmds.debug_level & D_NORMAL)
+        fprintf(stderr, "\nBATCH: audit %s failed: %s", path, error);
+      cJSON_AddStringToObject(jfailure, "file", path);
+      cJSON_AddStringToObject(jfailure, "error", error);
+      cJSON_AddItemToArray(jfailures, jfailure);
+      num_failed++;
+      cJSON_Delete(json_input);
+      continue;
+    }
+
+    num_audit++;
+
+    jresult = cJSON_DetachItemFromObject(jrun, "result");
+    for (int r = 0; r < num_reducer; r++)
+      fleet_reduce(&reducer[r], json_input, jresult);
+
+    if (jresults && full) {
+      cJSON_AddStringToObject(jresult, "file", path);
+      cJSON_AddItemToArray(jresults, jresult);
+    } else {
+      if (jresults) {
+        cJSON *jrow = cJSON_DetachItemFromObject(jrun, "row");
+        cJSON_AddStringToObject(jrow, "file", path);
+        cJSON_AddItemToObject(jrow, "audit_id", cJSON_DetachItemFromObject(jrun, "audit_id"));
+        cJSON_AddItemToArray(jresults, jrow);
+      }
+      cJSON_Delete(jresult);
+    }
+    cJSON_Delete(jrun);
+    cJSON_Delete(json_input);
+  }
+  if (list)
+    fclose(list);
+
+  if (strlen(cmds.run_identifier)) cJSON_AddStringToObject(jroot, "run_identifier", cmds.run_identifier);
+  cJSON_AddItemToObject(jroot, "batch", jbatch);
+  cJSON_AddNumberToObject(jbatch, "audits", num_audit);
+  cJSON_AddNumberToObject(jbatch, "failed", num_failed);
+  cJSON_AddItemToObject(jbatch, "failures", jfailures);
+  if (partial)
+    cJSON_AddBoolToObject(jbatch, "partial", TRUE);
+  cJSON_AddItemToObject(jbatch, "aggregates", jlist = cJSON_CreateArray());
+  for (int r = 0; r < num_reducer; r++) {
+    cJSON_AddItemToArray(jlist, fleet_aggregate(&reducer[r], partial));
+    fleet_free(&reducer[r]);
+  }
+  if (jresults)
+    cJSON_AddItemToObject(jbatch, "results", jresults);
+  free(reducer);
+
+  if (cmds.format_json_output)
+    output = cJSON_Print(jroot);
+  else
+    output = cJSON_PrintUnformatted(jroot);
+
+  write_results_to_file(output);
+
+  if (output) free(output);
+  cJSON_Delete(jroot);
+  cJSON_Delete(jspec);
+}
+
+// Run one audit, in a child process where there is fork().  Returns
+// {"result": the JSON results, "row": its sweep_row() and "audit_id" when
+// row is set}, or NULL with error set to why the run stopped.
+static cJSON *batch_audit(cJSON *json_input, cJSON *json_schema, int row, const char **error) {
+#ifdef _WIN32
+  *error = NULL;
+  return batch_audit_run(json_input, json_schema, row);
+#else
+  static char reason[MAX_ASSERT_MESSAGE_LEN];
+  cJSON *jrun = NULL, *jmessage;
+  char *buffer = NULL;
+  size_t len = 0, size = 0;
+  ssize_t n;
+  int fd[2], status;
+  pid_t pid;
+
+  *error = reason;
+  ASSERT(pipe(fd) == 0, sprintf(msg, "Failed to make the batch audit pipe code:%d:%s", errno, strerror(errno)));
+  fflush(stdout);
+  fflush(stderr);
+  pid = fork();
+  ASSERT(pid >= 0, sprintf(msg, "Failed to start the batch audit process code:%d:%s", errno, strerror(errno)));
+
+  if (pid == 0) { // the results, or the ASSERT failure output, go up the pipe
+    char *output;
+    close(fd[0]);
+    dup2(fd[1], STDOUT_FILENO);
+    close(fd[1]);
+    cmds.output_file_path = STD_OUTPUT;
+    jrun = batch_audit_run(json_input, json_schema, row);
+    output = cJSON_PrintUnformatted(jrun);
+    fprintf(stdout, "%s", output);
+    fflush(stdout);
+    _exit(EXIT_SUCCESS);
+  }
+
+  close(fd[1]);
+  for (;;) { // all of it before the wait, the child blocks on a full pipe
+    if (len + 1 >= size) {
+      size = size ? 2 * size : 65536;
+      ASSERT((buffer = (char *)realloc(buffer, size)), sprintf(msg, "Out of memory on the batch audit results"));
+    }
+    n = read(fd[0], buffer + len, size - len - 1);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      break;
+    len += (size_t)n;
+  }
+  buffer[len] = '\0';
+  close(fd[0]);
+  while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+    ;
+
+  if (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS && (jrun = cJSON_Parse(buffer)) && cJSON_GetObjectItem(jrun, "result")) {
+    *error = NULL;
+  } else {
+    cJSON_Delete(jrun);
+    jrun = cJSON_Parse(buffer);
+    if (cJSON_IsString(jmessage = cJSON_GetObjectItem(jrun, "message")))
+      snprintf(reason, sizeof(reason), "%s", jmessage->valuestring);
+    else if (WIFSIGNALED(status))
+      snprintf(reason, sizeof(reason), "Audit run stopped by signal %d", WTERMSIG(status));
+    else
+      snprintf(reason, sizeof(reason), "Audit run exited with code %d", WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+    cJSON_Delete(jrun);
+    jrun = NULL;
+  }
+  free(buffer);
+  return jrun;
+#endif
+}
+
+static cJSON *batch_audit_run(cJSON *json_input, cJSON *json_schema, int row) {
+  cJSON *jrun = cJSON_CreateObject();
+
+  memset(mdi, 0, sizeof(MDI));
+  mhea_json_read(mdi, json_input, json_schema);
+  sweep_run();
+
+  cJSON_AddItemToObject(jrun, "result", mhea_json_result(mdi, mor));
+  if (row) {
+    cJSON_AddItemToObject(jrun, "row", sweep_row());
+    cJSON_AddNumberToObject(jrun, "audit_id", mdi->gnl.audit_id);
+  }
+  return jrun;
+}
+
+// Fill reducer from the spec's reducers list, pointers into the spec tree.
+// Returns the number of reducers.
+static int fleet_reducers(cJSON *jspec, FLEET_REDUCER *reducer) {
+  static const double default_pct[] = {5, 25, 50, 75, 95};
+  cJSON *jlist = cJSON_GetObjectItem(jspec, "reducers");
+  cJSON *jred;
+  int num = 0;
+
+  ASSERT(cJSON_IsArray(jlist) && cJSON_GetArraySize(jlist) > 0, sprintf(msg, "Batch needs a reducers array"));
+  ASSERT(cJSON_GetArraySize(jlist) <= FLEET_MAX_REDUCERS, sprintf(msg, "Batch has more than %d reducers", FLEET_MAX_REDUCERS));
+
+  cJSON_ArrayForEach(jred, jlist) {
+    FLEET_REDUCER *r = &reducer[num++];
+    cJSON *jname = cJSON_GetObjectItem(jred, "name");
+    cJSON *jeach = cJSON_GetObjectItem(jred, "each");
+    cJSON *jkeys = cJSON_GetObjectItem(jred, "group_by");
+    cJSON *jvalues = cJSON_GetObjectItem(jred, "values");
+    cJSON *jpct = cJSON_GetObjectItem(jred, "quantiles");
+    cJSON *jitem;
+
+    ASSERT(cJSON_IsString(jname), sprintf(msg, "Batch reducer %d needs a name", num));
+    r->name = jname->valuestring;
+    for (int i = 0; i < num - 1; i++)
+      ASSERT(strcmp(reducer[i].name, r->name) != 0, sprintf(msg, "Batch reducer name %s is used twice", r->name));
+    ASSERT(jeach == NULL || cJSON_IsString(jeach), sprintf(msg, "Batch reducer %s each must be a JSON pointer", r->name));
+    r->each = jeach ? jeach->valuestring : NULL;
+
+    ASSERT(jkeys == NULL || (cJSON_IsArray(jkeys) && cJSON_GetArraySize(jkeys) <= FLEET_MAX_KEYS),
+           sprintf(msg, "Batch reducer %s group_by must be an array of up to %d keys", r->name, FLEET_MAX_KEYS));
+    cJSON_ArrayForEach(jitem, jkeys) {
+      cJSON *jin = cJSON_GetObjectItem(jitem, "input");
+      cJSON *jres = cJSON_GetObjectItem(jitem, "result");
+      ASSERT(cJSON_IsString(jin) != cJSON_IsString(jres),
+             sprintf(msg, "Batch reducer %s keys need one of an input or a result JSON pointer", r->name));
+      r->key[r->num_key].input = cJSON_IsString(jin);
+      r->key[r->num_key].pointer = cJSON_IsString(jin) ? jin->valuestring : jres->valuestring;
+      r->num_key++;
+    }
+
+    ASSERT(cJSON_IsArray(jvalues) && cJSON_GetArraySize(jvalues) > 0 && cJSON_GetArraySize(jvalues) <= FLEET_MAX_VALUES,
+           sprintf(msg, "Batch reducer %s needs a values array of 1 to %d values", r->name, FLEET_MAX_VALUES));
+    cJSON_ArrayForEach(jitem, jvalues) {
+      FLEET_VALUE *v = &r->value[r->num_value++];
+      cJSON *jres = cJSON_GetObjectItem(jitem, "result");
+      cJSON *jstats = cJSON_GetObjectItem(jitem, "stats");
+      cJSON *jbins = cJSON_GetObjectItem(jitem, "bins");
+      cJSON *js;
+
+      ASSERT(cJSON_IsString(jres), sprintf(msg, "Batch reducer %s values need a result JSON pointer", r->name));
+      v->result = jres->valuestring;
+      v->stats = jstats ? 0 : FLEET_COUNT | FLEET_SUM | FLEET_MEAN;
+      cJSON_ArrayForEach(js, jstats) {
+        int found = FALSE;
+        for (size_t i = 0; i < sizeof(fleet_stat_names) / sizeof(fleet_stat_names[0]); i++) {
+          if (cJSON_IsString(js) && strcmp(js->valuestring, fleet_stat_names[i].name) == 0) {
+            v->stats |= fleet_stat_names[i].stat;
+            found = TRUE;
+          }
+        }
+        ASSERT(found, sprintf(msg, "Batch reducer %s %s has an unknown statistic", r->name, v->result));
+      }
+      if (v->stats & FLEET_HISTOGRAM) {
+        ASSERT(cJSON_IsArray(jbins) && cJSON_GetArraySize(jbins) > 0 && cJSON_GetArraySize(jbins) <= FLEET_MAX_BINS,
+               sprintf(msg, "Batch reducer %s %s histogram needs 1 to %d bin edges", r->name, v->result, FLEET_MAX_BINS));
+        cJSON_ArrayForEach(js, jbins) {
+          ASSERT(cJSON_IsNumber(js) && (v->num_bin == 0 || js->valuedouble > v->bin[v->num_bin - 1]),
+                 sprintf(msg, "Batch reducer %s %s bin edges must be increasing numbers", r->name, v->result));
+          v->bin[v->num_bin++] = js->valuedouble;
+        }
+      }
+    }
+
+    if (jpct) {
+      ASSERT(cJSON_IsArray(jpct) && cJSON_GetArraySize(jpct) > 0 && cJSON_GetArraySize(jpct) <= FLEET_MAX_QUANTILES,
+             sprintf(msg, "Batch reducer %s quantiles must be an array of 1 to %d numbers", r->name, FLEET_MAX_QUANTILES));
+      cJSON_ArrayForEach(jitem, jpct) {
+        ASSERT(cJSON_IsNumber(jitem) && jitem->valuedouble >= 0.0 && jitem->valuedouble <= 100.0,
+               sprintf(msg, "Batch reducer %s quantiles must be from 0 to 100", r->name));
+        r->quantile[r->num_quantile++] = jitem->valuedouble;
+      }
+    } else {
+      for (; r->num_quantile < (int)(sizeof(default_pct) / sizeof(default_pct[0])); r->num_quantile++)
+        r->quantile[r->num_quantile] = default_pct[r->num_quantile];
+    }
+  }
+  return num;
+}
+
+// Fold one audit's results into the reducer
+static void fleet_reduce(FLEET_REDUCER *r, cJSON *json_input, cJSON *jresult) {
+  cJSON *jrow;
+
+  if (r->each == NULL) {
+    fleet_add_row(r, json_input, jresult);
+    return;
+  }
+  cJSON_ArrayForEach(jrow, json_pointer_item(jresult, r->each)) {
+    fleet_add_row(r, json_input, jrow);
+  }
+}
+
+static void fleet_add_row(FLEET_REDUCER *r, cJSON *json_input, cJSON *jrow) {
+  FLEET_GROUP *group;
+  char key[FLEET_KEY_LEN] = "";
+  char text[FLEET_KEY_LEN];
+  cJSON *jkey = cJSON_CreateArray();
+
+  for (int k = 0; k < r->num_key; k++) {
+    key_text(json_pointer_item(r->key[k].input ? json_input : jrow, r->key[k].pointer), text, sizeof(text));
+    cJSON_AddItemToArray(jkey, cJSON_CreateString(text));
+    if (k > 0)
+      strncat(key, "\x1f", sizeof(key) - strlen(key) - 1);
+    strncat(key, text, sizeof(key) - strlen(key) - 1);
+  }
+  group = fleet_group(r, key, jkey);
+  group->rows++;
+
+  for (int v = 0; v < r->num_value; v++) {
+    cJSON *jval = json_pointer_item(jrow, r->value[v].result);
+    if (cJSON_IsNumber(jval))
+      fleet_add(&group->stat[v], &r->value[v], jval->valuedouble);
+  }
+}
+
+// The reducer's group with the key, added when it is new.  Takes jkey.
+static FLEET_GROUP *fleet_group(FLEET_REDUCER *r, const char *key, cJSON *jkey) {
+  FLEET_GROUP *group;
+
+  for (int g = 0; g < r->num_group; g++) {
+    if (strcmp(r->group[g].key, key) == 0) {
+      cJSON_Delete(jkey);
+      return &r->group[g];
+    }
+  }
+
+  if (r->num_group == r->max_group) {
+    r->max_group = r->max_group ? 2 * r->max_group : 16;
+    ASSERT((r->group = (FLEET_GROUP *)realloc(r->group, r->max_group * sizeof(FLEET_GROUP))), sprintf(msg, "Out of memory on the batch groups"));
+  }
+  group = &r->group[r->num_group++];
+  memset(group, 0, sizeof(FLEET_GROUP));
+  snprintf(group->key, sizeof(group->key), "%s", key); // built to fit by the callers
+  group->jkey = jkey;
+  ASSERT((group->stat = (FLEET_STAT *)calloc(r->num_value, sizeof(FLEET_STAT))), sprintf(msg, "Out of memory on the batch groups"));
+  for (int v = 0; v < r->num_value; v++) {
+    if (r->value[v].stats & FLEET_QUANTILES)
+      ASSERT((group->stat[v].sketch = (FLEET_SKETCH *)calloc(1, sizeof(FLEET_SKETCH))), sprintf(msg, "Out of memory on the batch quantiles"));
+    if (r->value[v].stats & FLEET_HISTOGRAM)
+      ASSERT((group->stat[v].histogram = (long *)calloc(r->value[v].num_bin + 1, sizeof(long))), sprintf(msg, "Out of memory on the batch histograms"));
+  }
+  return group;
+}
+
+static void fleet_add(FLEET_STAT *s, const FLEET_VALUE *v, double x) {
+  if (s->count == 0 || x < s->min) s->min = x;
+  if (s->count == 0 || x > s->max) s->max = x;
+  s->count++;
+  s->sum += x;
+
+  if (s->sketch) {
+    double mag = fabs(x);
+    if (mag < FLEET_SKETCH_MIN) {
+      s->sketch->zero++;
+    } else {
+      int k = (int)ceil(log(mag / FLEET_SKETCH_MIN) / log_gamma);
+      k = MIN(MAX(k, 0), FLEET_SKETCH_BUCKETS - 1);
+      if (x > 0.0)
+        s->sketch->pos[k]++;
+      else
+        s->sketch->neg[k]++;
+    }
+  }
+
+  if (s->histogram) {
+    int b = 0;
+    while (b < v->num_bin && x >= v->bin[b])
+      b++;
+    s->histogram[b]++;
+  }
+}
+
+// Fold partial aggregates, as fleet_aggregate() writes them, into the reducers
+static void fleet_merge(FLEET_REDUCER *reducer, int num_reducer, cJSON *jpartial) {
+  cJSON *jagg;
+
+  cJSON_ArrayForEach(jagg, jpartial) {
+    cJSON *jname = cJSON_GetObjectItem(jagg, "name");
+    FLEET_REDUCER *r = NULL;
+    cJSON *jgroup;
+
+    for (int i = 0; i < num_reducer && r == NULL; i++)
+      if (cJSON_IsString(jname) && strcmp(reducer[i].name, jname->valuestring) == 0)
+        r = &reducer[i];
+    ASSERT(r, sprintf(msg, "Partial aggregates of a reducer not in the batch: %s", cJSON_IsString(jname) ? jname->valuestring : "(no name)"));
+
+    cJSON_ArrayForEach(jgroup, cJSON_GetObjectItem(jagg, "groups")) {
+      cJSON *jkey = cJSON_GetObjectItem(jgroup, "key");
+      cJSON *jvalues = cJSON_GetObjectItem(jgroup, "values");
+      cJSON *jtext;
+      FLEET_GROUP *group;
+      char key[FLEET_KEY_LEN] = "";
+      int k = 0;
+
+      ASSERT(cJSON_GetArraySize(jkey) == r->num_key, sprintf(msg, "Partial aggregates of %s have other keys", r->name));
+      cJSON_ArrayForEach(jtext, jkey) {
+        ASSERT(cJSON_IsString(jtext), sprintf(msg, "Partial aggregates of %s have other keys", r->name));
+        if (k++ > 0)
+          strncat(key, "\x1f", sizeof(key) - strlen(key) - 1);
+        strncat(key, jtext->valuestring, sizeof(key) - strlen(key) - 1);
+      }
+      group = fleet_group(r, key, cJSON_Duplicate(jkey, TRUE));
+      group->rows += (long)cJSON_GetObjectItem(jgroup, "rows")->valuedouble;
+
+      for (int v = 0; v < r->num_value; v++)
+        fleet_merge_stat(&group->stat[v], &r->value[v], cJSON_GetObjectItem(jvalues, r->value[v].result));
+    }
+  }
+}
+
+static void fleet_merge_stat(FLEET_STAT *s, const FLEET_VALUE *v, cJSON *jstat) {
+  cJSON *jcount = cJSON_GetObjectItem(jstat, "count");
+  cJSON *jsketch = cJSON_GetObjectItem(jstat, "sketch");
+  cJSON *jhist = cJSON_GetObjectItem(jstat, "histogram");
+  long count;
+
+  ASSERT(cJSON_IsNumber(jcount), sprintf(msg, "Partial aggregates have no %s", v->result));
+  count = (long)jcount->valuedouble;
+  if (count == 0)
+    return;
+
+  if (s->count == 0 || cJSON_GetObjectItem(jstat, "min")->valuedouble < s->min) s->min = cJSON_GetObjectItem(jstat, "min")->valuedouble;
+  if (s->count == 0 || cJSON_GetObjectItem(jstat, "max")->valuedouble > s->max) s->max = cJSON_GetObjectItem(jstat, "max")->valuedouble;
+  s->count += count;
+  s->sum += cJSON_GetObjectItem(jstat, "sum")->valuedouble;
+
+  if (s->sketch) {
+    cJSON *jb;
+    ASSERT(jsketch, sprintf(msg, "Partial aggregates of %s have no quantile sketch", v->result));
+    s->sketch->zero += (long)cJSON_GetObjectItem(jsketch, "zero")->valuedouble;
+    cJSON_ArrayForEach(jb, cJSON_GetObjectItem(jsketch, "pos"))
+      s->sketch->pos[cJSON_GetArrayItem(jb, 0)->valueint] += (long)cJSON_GetArrayItem(jb, 1)->valuedouble;
+    cJSON_ArrayForEach(jb, cJSON_GetObjectItem(jsketch, "neg"))
+      s->sketch->neg[cJSON_GetArrayItem(jb, 0)->valueint] += (long)cJSON_GetArrayItem(jb, 1)->valuedouble;
+  }
+
+  if (s->histogram) {
+    ASSERT(cJSON_GetArraySize(jhist) == v->num_bin + 1, sprintf(msg, "Partial aggregates of %s have other bins", v->result));
+    for (int b = 0; b <= v->num_bin; b++)
+      s->histogram[b] += (long)cJSON_GetArrayItem(jhist, b)->valuedouble;
+  }
+}
+
+// The reducer's groups as JSON, partial for merging
+static cJSON *fleet_aggregate(FLEET_REDUCER *r, int partial) {
+  cJSON *jagg = cJSON_CreateObject();
+  cJSON *jkeys = cJSON_CreateArray();
+  cJSON *jgroups = cJSON_CreateArray();
+
+  for (int k = 0; k < r->num_key; k++) {
+    cJSON *jkey = cJSON_CreateObject();
+    cJSON_AddStringToObject(jkey, r->key[k].input ? "input" : "result", r->key[k].pointer);
+    cJSON_AddItemToArray(jkeys, jkey);
+  }
+  cJSON_AddStringToObject(jagg, "name", r->name);
+  cJSON_AddItemToObject(jagg, "group_by", jkeys);
+  cJSON_AddNumberToObject(jagg, "num_group", r->num_group);
+  cJSON_AddItemToObject(jagg, "groups", jgroups);
+
+  for (int g = 0; g < r->num_group; g++) {
+    FLEET_GROUP *group = &r->group[g];
+    cJSON *jgroup = cJSON_CreateObject();
+    cJSON *jvalues = cJSON_CreateObject();
+
+    cJSON_AddItemToObject(jgroup, "key", cJSON_Duplicate(group->jkey, TRUE));
+    cJSON_AddNumberToObject(jgroup, "rows", group->rows);
+    for (int v = 0; v < r->num_value; v++)
+      cJSON_AddItemToObject(jvalues, r->value[v].result, fleet_stat(r, &group->stat[v], &r->value[v], partial));
+    cJSON_AddItemToObject(jgroup, "values", jvalues);
+    cJSON_AddItemToArray(jgroups, jgroup);
+  }
+  return jagg;
+}
+
+static cJSON *fleet_stat(FLEET_REDUCER *r, FLEET_STAT *s, const FLEET_VALUE *v, int partial) {
+  cJSON *jstat = cJSON_CreateObject();
+
+  if (partial) { // everything, to merge
+    cJSON_AddNumberToObject(jstat, "count", s->count);
+    cJSON_AddNumberToObject(jstat, "sum", s->sum);
+    cJSON_AddNumberToObject(jstat, "min", s->min);
+    cJSON_AddNumberToObject(jstat, "max", s->max);
+    if (s->sketch) {
+      cJSON *jsketch = cJSON_CreateObject();
+      cJSON_AddNumberToObject(jsketch, "zero", s->sketch->zero);
+      cJSON_AddItemToObject(jsketch, "pos", sketch_buckets(s->sketch->pos));
+      cJSON_AddItemToObject(jsketch, "neg", sketch_buckets(s->sketch->neg));
+      cJSON_AddItemToObject(jstat, "sketch", jsketch);
+    }
+    if (s->histogram) {
+      cJSON *jhist = cJSON_CreateArray();
+      for (int b = 0; b <= v->num_bin; b++)
+        cJSON_AddItemToArray(jhist, cJSON_CreateNumber(s->histogram[b]));
+      cJSON_AddItemToObject(jstat, "histogram", jhist);
+    }
+    return jstat;
+  }
+
+  // clang-format off
+  if (v->stats & FLEET_COUNT) cJSON_AddNumberToObject(jstat, "count", s->count);
+  if (v->stats & FLEET_SUM)   cJSON_AddNumberToObject(jstat, "sum", WA_DBL_FMT(s->sum, 4));
+  if (s->count == 0) {
+    if (v->stats & FLEET_MEAN) cJSON_AddNullToObject(jstat, "mean");
+    if (v->stats & FLEET_MIN)  cJSON_AddNullToObject(jstat, "min");
+    if (v->stats & FLEET_MAX)  cJSON_AddNullToObject(jstat, "max");
+  } else {
+    if (v->stats & FLEET_MEAN) cJSON_AddNumberToObject(jstat, "mean", WA_DBL_FMT(s->sum / s->count, 4));
+    if (v->stats & FLEET_MIN)  cJSON_AddNumberToObject(jstat, "min", s->min);
+    if (v->stats & FLEET_MAX)  cJSON_AddNumberToObject(jstat, "max", s->max);
+  }
+  // clang-format on
+
+  if (v->stats & FLEET_QUANTILES) {
+    cJSON *jq = cJSON_CreateObject();
+    for (int q = 0; q < r->num_quantile; q++) {
+      char name[32];
+      snprintf(name, sizeof(name), "%g", r->quantile[q]);
+      if (s->count == 0)
+        cJSON_AddNullToObject(jq, name);
+      else
+        cJSON_AddNumberToObject(jq, name, WA_DBL_FMT(MIN(MAX(sketch_quantile(s->sketch, s->count, r->quantile[q]), s->min), s->max), 4));
+    }
+    cJSON_AddItemToObject(jstat, "quantiles", jq);
+  }
+
+  if (v->stats & FLEET_HISTOGRAM) {
+    cJSON *jhist = cJSON_CreateObject();
+    cJSON *jcounts = cJSON_CreateArray();
+    for (int b = 0; b <= v->num_bin; b++)
+      cJSON_AddItemToArray(jcounts, cJSON_CreateNumber(s->histogram[b]));
+    cJSON_AddItemToObject(jhist, "edges", cJSON_CreateDoubleArray(v->bin, v->num_bin));
+    cJSON_AddItemToObject(jhist, "counts", jcounts);
+    cJSON_AddItemToObject(jstat, "histogram", jhist);
+  }
+  return jstat;
+}
+
+// The buckets holding values as [index, count] pairs
+static cJSON *sketch_buckets(const long *bucket) {
+  cJSON *jarray = cJSON_CreateArray();
+
+  for (int k = 0; k < FLEET_SKETCH_BUCKETS; k++) {
+    if (bucket[k]) {
+      double pair[2] = {k, (double)bucket[k]};
+      cJSON_AddItemToArray(jarray, cJSON_CreateDoubleArray(pair, 2));
+    }
+  }
+  return jarray;
+}
+
+// The pct percentile of the count values in the sketch, from the most
+// negative value up
+static double sketch_quantile(const FLEET_SKETCH *sketch, long count, double pct) {
+  double rank = pct / 100.0 * (count - 1);
+  double gamma = exp(log_gamma);
+  long seen = 0;
+
+  for (int k = FLEET_SKETCH_BUCKETS - 1; k >= 0; k--) {
+    seen += sketch->neg[k];
+    if (seen > rank)
+      return -FLEET_SKETCH_MIN * 2.0 * pow(gamma, k) / (gamma + 1.0);
+  }
+  seen += sketch->zero;
+  if (seen > rank)
+    return 0.0;
+  for (int k = 0; k < FLEET_SKETCH_BUCKETS; k++) {
+    seen += sketch->pos[k];
+    if (seen > rank)
+      return FLEET_SKETCH_MIN * 2.0 * pow(gamma, k) / (gamma + 1.0);
+  }
+  return 0.0; // not reached with count values in the sketch
+}
+
+// A key as text, null when the input or result has no such item
+static void key_text(cJSON *item, char *text, size_t len) {
+  if (cJSON_IsString(item))
+    snprintf(text, len, "%s", item->valuestring);
+  else if (cJSON_IsNumber(item))
+    snprintf(text, len, "%g", item->valuedouble);
+  else if (cJSON_IsBool(item))
+    snprintf(text, len, "%s", cJSON_IsTrue(item) ? "true" : "false");
+  else
+    snprintf(text, len, "null");
+}
+
+static void fleet_free(FLEET_REDUCER *r) {
+  for (int g = 0; g < r->num_group; g++) {
+    for (int v = 0; v < r->num_value; v++) {
+      free(r->group[g].stat[v].sketch);
+      free(r->group[g].stat[v].histogram);
+    }
+    free(r->group[g].stat);
+    cJSON_Delete(r->group[g].jkey);
+  }
+  free(r->group);
+  r->group = NULL;
+  r->num_group = r->max_group = 0;
+}
@@ -0,0 +1,13 @@
+/***************************************************************************
+* MODULE:       batch.h            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        MHEA batches of audits reduced to fleet aggregates
+****************************************************************************/
+#ifndef _BATCH_H
+#define _BATCH_H
+
+void run_mhea_batch(const char *spec_path, cJSON *json_schema);
+
+#endif
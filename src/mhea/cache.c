@@ -0,0 +1,189 @@
+/***************************************************************************
+* MODULE:       cache.c            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        Cache of MHEA first pass results across runs (-q DIR).
+*               The first pass is most of a run's energy use calls and
+*               depends only on the dwelling, the weather and the engine,
+*               so an audit submitted again (the same dwelling with other
+*               fuel prices, bills, limits or identifiers) can replay the
+*               pass a previous run saved instead of repeating it.  Each
+*               entry is a file in DIR named by the hash of everything the
+*               pass reads; an entry from another engine build, or for
+*               another dwelling, is simply never looked up.  Fuel prices
+*               and rates are hashed on their own: an entry saved at other
+*               prices is re-priced as the economic scenarios are (see
+*               reprice_first_pass_retrofits()).
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wa_engine.h"
+
+#define CACHE_MAGIC "MHEAFP2" // first bytes of an entry, changed with its layout
+#define CACHE_BUILD_LEN 64    // of the build id kept in an entry
+
+typedef struct {
+  char magic[sizeof(CACHE_MAGIC)];
+  char version[sizeof(WA_VERSION)];
+  char build[CACHE_BUILD_LEN]; // build_id, cut to fit
+  unsigned long long key;   // see first_pass_key()
+  unsigned long long price; // see fuel_price_key()
+} CACHE_HEADER;
+
+static int cache_enabled(void);
+static unsigned long long first_pass_key(void);
+static unsigned long long fuel_price_key(void);
+static void entry_path(char *path, unsigned long long key);
+
+static unsigned long long entry_key; // of the run's dwelling, kept from the lookup for the store
+
+/***************************************************************************
+ ** Function Name: load_cached_first_pass
+ **
+ **  DESCRIPTION:  Stands in for first_pass_retrofits() when -q DIR holds
+ **                an entry for this dwelling, weather and engine.  Called
+ **                where the first pass would start; returns TRUE if the
+ **                pass was replayed, FALSE if it still has to be run.
+ **************************************************************************/
+int load_cached_first_pass(void) {
+  char path[FILENAME_MAX];
+  CACHE_HEADER header;
+  FILE *fp;
+  int ok;
+
+  if (!cache_enabled())
+    return FALSE;
+
+  entry_key = first_pass_key();
+  entry_path(path, entry_key);
+
+  if ((fp = fopen(path, "rb")) == NULL)
+    return FALSE;
+
+  ok = fread(&header, sizeof(header), 1, fp) == 1 && memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) == 0 &&
+       strcmp(header.version, WA_VERSION) == 0 && strncmp(header.build, build_id, sizeof(header.build) - 1) == 0 &&
+       header.key == entry_key;
+
+  // the measure report lists first pass SIRs, which re-pricing would not rewrite
+  if (ok && header.price != fuel_price_key() && strcmp(cmds.mhea_measure_file_path, NO_OUTPUT) != 0)
+    ok = FALSE;
+
+  ok = ok && replay_first_pass(fp, header.price != fuel_price_key());
+
+  fclose(fp);
+  return ok;
+}
+
+/***************************************************************************
+ ** Function Name: store_cached_first_pass
+ **
+ **  DESCRIPTION:  Save the first pass just run in -q DIR for later runs.
+ **                The entry is written under a temporary name and renamed
+ **                so a run never reads one half written.  A cache that
+ **                can not be written does not stop the run.
+ **************************************************************************/
+void store_cached_first_pass(void) {
+  char path[FILENAME_MAX];
+  char temp[FILENAME_MAX + 8];
+  CACHE_HEADER header;
+  FILE *fp;
+  int ok;
+
+  if (!cache_enabled())
+    return;
+
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+  STRCPY(header.version, WA_VERSION);
+  snprintf(header.build, sizeof(header.build), "%s", build_id);
+  header.key = entry_key;
+  header.price = fuel_price_key();
+
+  entry_path(path, entry_key);
+  sprintf(temp, "%s.tmp", path);
+
+  if ((fp = fopen(temp, "wb")) == NULL)
+    return;
+
+  ok = fwrite(&header, sizeof(header), 1, fp) == 1 && save_first_pass(fp);
+  ok = (fclose(fp) == 0) && ok;
+
+  remove(path); // rename() will not replace a file everywhere
+  if (!ok || rename(temp, path) != 0)
+    remove(temp);
+}
+
+// Debug output comes from the pass itself, so a replayed one has none
+static int cache_enabled(void) {
+  return strcmp(cmds.first_pass_cache_path, NO_OUTPUT) != 0 && cmds.debug_level == D_SILENT;
+}
+
+// Everything the first pass reads: the dwelling as the run has set it up,
+// less what only later steps use or is priced separately, the weather as
+// loaded, and the engine build.  WA_VERSION and the struct sizes stay the
+// same through most engine changes, so the build id, which follows the sources,
+// is in the key too.
+static unsigned long long first_pass_key(void) {
+  unsigned long long h = HASH_SEED;
+  size_t sizes[2] = {sizeof(MDI), sizeof(MIR)};
+  int report = strcmp(cmds.mhea_measure_file_path, NO_OUTPUT) != 0;
+  MDI *dwelling;
+
+  ASSERT((dwelling = (MDI *)malloc(sizeof(MDI))), sprintf(msg, "Out of memory on MDI"));
+  memcpy(dwelling, mdi, sizeof(MDI));
+
+  dwelling->gnl.audit_id = 0; // pass through only
+  dwelling->gnl.audit_number = 0;
+  dwelling->gnl.do_billing_adjust = NO; // read after the first pass
+  memset(&dwelling->ubh, 0, sizeof(dwelling->ubh));
+  dwelling->num_urh = 0;
+  memset(dwelling->urh, 0, sizeof(dwelling->urh));
+  memset(&dwelling->ubc, 0, sizeof(dwelling->ubc));
+  dwelling->num_urc = 0;
+  memset(dwelling->urc, 0, sizeof(dwelling->urc));
+  dwelling->num_scn = 0;
+  memset(dwelling->scn, 0, sizeof(dwelling->scn));
+  dwelling->key.spending_limit = 0.0f;
+  dwelling->key.minimum_acceptable_sir = 0.0f;
+
+  memset(&dwelling->fcs, 0, sizeof(dwelling->fcs)); // see fuel_price_key()
+  memset(&dwelling->rer, 0, sizeof(dwelling->rer));
+  dwelling->num_fer = 0;
+  memset(dwelling->fer, 0, sizeof(dwelling->fer));
+  dwelling->key.real_discount_rate = 0.0f;
+
+  h = hash_bytes(h, CACHE_MAGIC WA_VERSION, strlen(CACHE_MAGIC WA_VERSION));
+  h = hash_bytes(h, build_id, strlen(build_id));
+  h = hash_bytes(h, sizes, sizeof(sizes));
+  h = hash_bytes(h, dwelling, sizeof(MDI));
+  h = hash_bytes(h, cwd, sizeof(CWD));
+  h = hash_bytes(h, &cmds.regression_test, sizeof(int)); // both change the measure report
+  h = hash_bytes(h, &report, sizeof(int));
+
+  free(dwelling);
+  return h;
+}
+
+// The fuel prices and rates the first pass SIRs were figured at
+static unsigned long long fuel_price_key(void) {
+  unsigned long long h = HASH_SEED;
+
+  h = hash_bytes(h, &mdi->fcs, sizeof(mdi->fcs));
+  h = hash_bytes(h, &mdi->rer, sizeof(mdi->rer));
+  h = hash_bytes(h, &mdi->num_fer, sizeof(mdi->num_fer));
+  h = hash_bytes(h, mdi->fer, sizeof(mdi->fer));
+  h = hash_bytes(h, &mdi->key.real_discount_rate, sizeof(mdi->key.real_discount_rate));
+  return h;
+}
+
+static void entry_path(char *path, unsigned long long key) {
+  const char *dir = cmds.first_pass_cache_path;
+  size_t len = strlen(dir);
+  int slash = len > 0 && (dir[len - 1] == '/' || dir[len - 1] == '\\');
+
+  ASSERT(len + 32 < FILENAME_MAX, sprintf(msg, "MHEA first pass cache directory name too long: %s", dir));
+  sprintf(path, "%s%s%016llx.mfp", dir, slash ? "" : "/", key);
+}
@@ -0,0 +1,14 @@
+/***************************************************************************
+* MODULE:       cache.h            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        MHEA first pass results kept across runs
+****************************************************************************/
+#ifndef _CACHE_H
+#define _CACHE_H
+
+int load_cached_first_pass(void);
+void store_cached_first_pass(void);
+
+#endif
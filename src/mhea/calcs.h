@@ -30,10 +30,22 @@ void get_degree_hours(float fNumDays, float fBaseTemps[], float fDH_Day[], float
 int get_hourly_loads(int iflgSeason, float fDayLength, float fCondLoss, float fInfilLoss, float fDegHourDay, float fDegHourNight,
              int *flgSetBack, float fTempDelta, float *fHourLoadDay, float *fHourLoadNight);
 
-void get_heating_consumption(int, int, int, float, float, float, float, float, float, float, float *, float *);
-int get_cooling_consumption(int, int, int, float, float, float, float, float, float, float, float, float, float, float *, float *,
-                   float *);
+// Monthly results of the load calculations that feed the batched consumption
+// calls, base zero by month
+typedef struct {
+  int iSeason[MONTHS];
+  int iflgSetBack[MONTHS];
+  float fNightSetpoint[MONTHS]; // heating night setpoint (F)
+  float fInfMassFlow[MONTHS];   // infiltration (CFM)
+  float fHourLoadDay[MONTHS];   // average hourly loads (Btu/h)
+  float fHourLoadNight[MONTHS];
+} MONTH_LOADS;
+
+void get_heating_consumption_months(const MONTH_LOADS *loads, float fDistlossfactor, float fHtgEnerUse_Day[],
+                                    float fHtgEnerUse_Night[]);
+void get_cooling_consumption_months(const MONTH_LOADS *loads, float *fDuctEffClg, float fClgEnergyDay[], float fClgEnergyNight[]);
 
 float get_cooling_cop(int units, float efficiency_cop, float efficiency_seer, float efficiency_eer);
+void mhea_high_load(int iSeason, int zMonth);
 
 #endif // _CALCS_H
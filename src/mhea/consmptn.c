@@ -17,7 +17,50 @@
 
 #include "wa_engine.h"
 
-/*******************  FUNCTION NAME:  get_heating_consumption  **********************/
+// Month-invariant heating equipment data, set up once per energy call
+typedef struct {
+  float fInCapacity; // Input capacity (W)
+  float fEfficiency; // Rated or steady state efficiency, or COP for heat pumps
+  float fFanpower;   // Circulating fan power (W)
+} HTG_EQUIPMENT;
+
+typedef struct {
+  HTG_EQUIPMENT pri;
+  HTG_EQUIPMENT sec;
+} HTG_SETUP;
+
+// Month-invariant cooling equipment data, set up once per energy call
+typedef struct {
+  float fP_Fan;             // Fan power (kW)
+  float fAirRate;           // Air flow rate (m^3/s)
+  float fAirFlow;           // Air flow rate through the evaporator (kg/s)
+  float fRatedCoolCapacity; // Rated total capacity (kW)
+  float fRatedCOP;          // Rated COP
+  float fDistlossfactor;    // Loss factor due to ducts & insulation
+  float fClgDuctLocation;   // Factor based on duct location
+  float fClgDuctInsulation; // Factor based on duct insulation
+} CLG_EQUIPMENT;
+
+typedef struct {
+  int flgNone;         // TRUE if there is no primary cooling equipment
+  CLG_EQUIPMENT pri;
+  CLG_EQUIPMENT sec;
+  float fDayCoolSet;   // Day & night time dry-bulb setpoints (deg C)
+  float fNightCoolSet;
+  float fPressure;     // Total pressure of moist air (psia)
+  double dDensity;     // Altitude adjustment to air density
+} CLG_SETUP;
+
+static void heating_setup(HTG_SETUP *setup);
+static void heating_month(const HTG_SETUP *setup, int iSeason, int iflgSetBack, int zMonth, float fNumDays, float fTempOut_Day,
+                          float fTempOut_Night, float fHourLoadDay, float fHourLoadNight, float fDistlossfactor, float *fHtgEnerUse_Day,
+                          float *fHtgEnerUse_Night);
+static void cooling_setup(float fElevation, float *fDuctEffClg, CLG_SETUP *setup);
+static void cooling_month(const CLG_SETUP *setup, int iSeason, int flgSetBack, int zMonth, float fNumDays, float fElevation,
+                          float fInfMassFlow, float fTwbOutside, float fTdbOutsideDay, float fTdbOutsideNight, float fClgHourLoadDay,
+                          float fClgHourLoadNight, float *fClgEnergyDay, float *fClgEnergyNight);
+
+/*******************  MHEA heating consumption  *****************************/
 /**       DATE: 3/12/93                                                   **/
 /**              BY:    JP/SLF/NW                                         **/
 /** DESCRIPTION:    See pages 60 - 66 in Notes by Sheila Hayter.          **/
@@ -30,9 +73,79 @@
 /**      4/08  MBG  -  modified to allow adjustment of heat pump hspf to  **/
 /**                     climate differences using design temperature.     **/
 /***************************************************************************/
-void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNumDays, float fElevation, float fTempOut_Day,
-                    float fTempOut_Night, float fHourLoadDay, float fHourLoadNight, float fDistlossfactor, float *fHtgEnerUse_Day,
-                    float *fHtgEnerUse_Night) {
+/*******************  FUNCTION NAME:  heating_setup  ******************************/
+/** DESCRIPTION:  Fills in the heating equipment data that does not change   **/
+/**               from month to month: input capacity, efficiency and fan    **/
+/**               power for the primary and secondary systems.              **/
+/********************************************************************************/
+static void heating_setup(HTG_SETUP *setup) {
+
+  /******************
+  Fan Power (W)
+  ******************/
+  if (mdi->htg.fuel_type == WOOD || mdi->htg.fuel_type == COAL)
+    setup->pri.fFanpower = 0.0;
+  else /* all other equipment types */
+    setup->pri.fFanpower = 60.0;
+
+  /***************
+  Get the equipment input capacity and
+  convert to Metric units (kBtu/h to W).
+  Issue #156 avoid garbage value for fInCapacity
+  ***************/
+
+  if (mdi->htg.fuel_type != WOOD && mdi->htg.fuel_type != COAL) {
+    setup->pri.fInCapacity = (float)(mdi->htg.capacity * W_PER_KBTUH);
+  } else {
+    setup->pri.fInCapacity = 0;
+  }
+
+  // Here is the heating equipment efficiency assignment, MJF 2/28/00
+  // This also holds the Heat Pump COP, MJF 6/02
+  // Add climate adjustment to HSPF.  MBG 4/08
+
+  if (mdi->htg.eff_units == HE_COP) {
+    setup->pri.fEfficiency = mdi->htg.efficiency_cop;
+  } else if (mdi->htg.eff_units == HE_HSPF) {
+    setup->pri.fEfficiency = mdi->htg.efficiency_hspf;
+    //adjust_hspf(mir->fW_Dsgn_T_New, &fEfficiency);
+    adjust_hspf(cwd->winter_hp_design_temp, &setup->pri.fEfficiency);
+    setup->pri.fEfficiency /= 3.413F;
+  } else {
+    setup->pri.fEfficiency = (float)(mdi->htg.efficiency_percent / 100.0);
+  }
+
+  /***************
+  Secondary system, same conversions
+  ***************/
+
+  if (mdi->ht2.fuel_type == WOOD || mdi->ht2.fuel_type == COAL)
+    setup->sec.fFanpower = 0.0;
+  else /* all other equipment types */
+    setup->sec.fFanpower = 60.0;
+
+  if (mdi->ht2.fuel_type != WOOD && mdi->ht2.fuel_type != COAL) {
+    setup->sec.fInCapacity = (float)(mdi->ht2.capacity * W_PER_KBTUH);
+  } else {
+    setup->sec.fInCapacity = 0;
+  }
+
+  if (mdi->ht2.eff_units == HE_COP) {
+    setup->sec.fEfficiency = mdi->ht2.efficiency_cop;
+  } else if (mdi->ht2.eff_units == HE_HSPF) {
+    setup->sec.fEfficiency = (float)(mdi->ht2.efficiency_hspf / 3.413);
+  } else {
+    setup->sec.fEfficiency = (float)(mdi->ht2.efficiency_percent / 100.0);
+  }
+}
+
+/*******************  FUNCTION NAME:  heating_month  ******************************/
+/** DESCRIPTION:  Heating energy use for one month given the equipment data  **/
+/**               from heating_setup().                                      **/
+/********************************************************************************/
+static void heating_month(const HTG_SETUP *setup, int iSeason, int iflgSetBack, int zMonth, float fNumDays, float fTempOut_Day,
+                          float fTempOut_Night, float fHourLoadDay, float fHourLoadNight, float fDistlossfactor, float *fHtgEnerUse_Day,
+                          float *fHtgEnerUse_Night) {
 
   int iMonth = zMonth + 1;   // base 1 from base 0 month
   /*****************************************************************/
@@ -47,11 +160,11 @@ void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNu
       fTInsideNight,         // Inside nighttime temperature (deg C) 
       fTOutsideDay,          // Average outdoor daytime temperature (C)  
       fTOutsideNight;        // Average outdoor nighttime temperature (C) 
-  float fInCapacity,         // Input Capacity of heating equipment (W) 
+  float fInCapacity = 0,     // Input Capacity of heating equipment (W) 
       fOutCapacity;          // Ouput Capacity of heating equipment (W) 
                              //  float fAdjustEff1,          // Efficiency adjustment for retrofit 
                              //        fAdjustEff2,
-  float fEfficiency;         // Rated or steady state efficiency (no units), or COP for Heat Pumps
+  float fEfficiency = 0;     // Rated or steady state efficiency (no units), or COP for Heat Pumps
 
   float fSensibleHtgLoad_Day, fSensibleHtgLoad_Night, fLoadSB;
 
@@ -161,10 +274,7 @@ void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNu
   /******************
   Fan Power (W)
   ******************/
-  if (mdi->htg.fuel_type == WOOD || mdi->htg.fuel_type == COAL)
-    fFanpower = 0.0;
-  else /* all other equipment types */
-    fFanpower = 60.0;
+  fFanpower = setup->pri.fFanpower;
 
   /***********************
   If the percent of heat supplied by the primary equipment is
@@ -181,31 +291,11 @@ void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNu
   else { // Long else encompassing all primary system consumption calcs
 
     /***************
-    Get the equipment input capacity and
-    convert to Metric units (kBtu/h to W).
-    Issue #156 avoid garbage value for fInCapacity
+    Equipment input capacity (W) and efficiency from heating_setup()
     ***************/
 
-    if (mdi->htg.fuel_type != WOOD && mdi->htg.fuel_type != COAL) {
-      fInCapacity = (float)(mdi->htg.capacity * W_PER_KBTUH);
-    } else {
-      fInCapacity = 0;
-    }
-
-    // Here is the heating equipment efficiency assignment, MJF 2/28/00
-    // This also holds the Heat Pump COP, MJF 6/02
-    // Add climate adjustment to HSPF.  MBG 4/08
-
-    if (mdi->htg.eff_units == HE_COP) {
-      fEfficiency = mdi->htg.efficiency_cop;
-    } else if (mdi->htg.eff_units == HE_HSPF) {
-      fEfficiency = mdi->htg.efficiency_hspf;
-      //adjust_hspf(mir->fW_Dsgn_T_New, &fEfficiency);
-      adjust_hspf(cwd->winter_hp_design_temp, &fEfficiency);
-      fEfficiency /= 3.413F;
-    } else {
-      fEfficiency = (float)(mdi->htg.efficiency_percent / 100.0);
-    }
+    fInCapacity = setup->pri.fInCapacity;
+    fEfficiency = setup->pri.fEfficiency;
 
     // Apply furnace tuneup measure if implemented.
     // Modified MBG 7/07 from flat percentage specified by user
@@ -331,19 +421,8 @@ void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNu
         then the heating equipment does not meet the load.  Flags are
         set here to print this condition in the savings output file.
         ***************/
-        if (mir->flgWhichPass == BASE_CASE) {
-          if (fPLRDay >= 1.0 || fPLRNight >= 1.0) {
-            mir->flgPreHighHTGLoad = TRUE;
-            mir->iPreHighLoadMonths[zMonth] = TRUE;
-          }
-        } else if (mir->flgWhichPass == CUMULATIVE) {
-          if (fPLRDay >= 1.0 || fPLRNight >= 1.0) {
-            mir->flgPostHighHTGLoad = TRUE;
-            mir->iPostHighLoadMonths[zMonth] = TRUE;
-          }
-          //              else
-          //                  mir->iPostHighLoadMonths[zMonth] = FALSE;
-        }
+        if (fPLRDay >= 1.0 || fPLRNight >= 1.0)
+          mhea_high_load(HEATING, zMonth);
 
       } else if (mdi->htg.fuel_type == COAL || mdi->htg.fuel_type == WOOD) {
 
@@ -373,19 +452,8 @@ void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNu
         then the heating equipment does not meet the load.  Flags are
         set here to print this condition in the savings output file.
         ***************/
-        if (mir->flgWhichPass == BASE_CASE) {
-          if (fPLRDay >= 1.0 || fPLRNight >= 1.0) {
-            mir->flgPreHighHTGLoad = TRUE;
-            mir->iPreHighLoadMonths[zMonth] = TRUE;
-          }
-        } else if (mir->flgWhichPass == CUMULATIVE) {
-          if (fPLRDay >= 1.0 || fPLRNight >= 1.0) {
-            mir->flgPostHighHTGLoad = TRUE;
-            mir->iPostHighLoadMonths[zMonth] = TRUE;
-          }
-          //              else
-          //                  mir->iPostHighLoadMonths[zMonth] = FALSE;
-        }
+        if (fPLRDay >= 1.0 || fPLRNight >= 1.0)
+          mhea_high_load(HEATING, zMonth);
       }
 
       /*******************
@@ -555,26 +623,11 @@ void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNu
       fSensibleHtgLoad_Night = (float)((fHourLoadNight * WH_PER_BTU) * (1.0 - (fPercentPrimaryHeat / 100.0)));
 
       /***************
-      Get the equipment input capacity and
-      convert to Metric units (kBtu/h to W).
+      Equipment input capacity (W) and efficiency from heating_setup()
       ***************/
 
-      if (mdi->ht2.fuel_type != WOOD && mdi->ht2.fuel_type != COAL) {
-        fInCapacity = (float)(mdi->ht2.capacity * W_PER_KBTUH);
-      } else {
-        fInCapacity = 0;
-      }
-
-      // Here is the heating equipment efficiency assignment, MJF 2/28/00
-      // This also holds the Heat Pump COP, MJF 6/02
-
-      if (mdi->ht2.eff_units == HE_COP) {
-        fEfficiency = mdi->ht2.efficiency_cop;
-      } else if (mdi->ht2.eff_units == HE_HSPF) {
-        fEfficiency = (float)(mdi->ht2.efficiency_hspf / 3.413);
-      } else {
-        fEfficiency = (float)(mdi->ht2.efficiency_percent / 100.0);
-      }
+      fInCapacity = setup->sec.fInCapacity;
+      fEfficiency = setup->sec.fEfficiency;
 
       // Apply furnace tuneup measure here if applicable... Mark T,
       // said to remove the connection between primary and secondary system
@@ -636,10 +689,7 @@ void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNu
         /******************
         Fan Power (W)
         ******************/
-        if (mdi->ht2.fuel_type == WOOD || mdi->ht2.fuel_type == COAL)
-          fFanpower = 0.0;
-        else /* all other equipment types */
-          fFanpower = 60.0;
+        fFanpower = setup->sec.fFanpower;
 
         /****************************
         Overall distribution loss factor is 0.0 for secondary system.
@@ -842,7 +892,7 @@ void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNu
   return;
 }
 
-/*******************  FUNCTION NAME:  get_cooling_consumption  ********************/
+/*******************  MHEA cooling consumption  *****************************/
 /**       DATE: 3/12/93     07/29/93                                                **/
 /**          BY:    CH/JG - ERG International, Inc.                             **/
 /** DESCRIPTION:    Cooling load algorithms for WAM software                    **/
@@ -898,154 +948,54 @@ void get_heating_consumption(int iSeason, int iflgSetBack, int zMonth, float fNu
 // fClgHourLoadDay  Daytime cooling load in Btuh.
 // fClgHourLoadNight    Nighttime cooling load in Btuh.
 
-int get_cooling_consumption(int iSeason, int flgSetBack, int zMonth, float fNumDays, float fElevation, float fVolumeCathCeiling,
-                   float fVolumeAddition, float fInfMassFlow, float fTwbOutside, float fTdbOutsideDay, float fTdbOutsideNight,
-                   float fClgHourLoadDay, float fClgHourLoadNight, float *fDuctEffClg, float *fClgEnergyDay,
-                   float *fClgEnergyNight) {
+/*******************  FUNCTION NAME:  cooling_setup  ******************************/
+/** DESCRIPTION:  Fills in the cooling equipment data that does not change   **/
+/**               from month to month: air flow, fan power, rated capacity  **/
+/**               and COP, and distribution losses for the primary and      **/
+/**               secondary systems.  The secondary system starts from the   **/
+/**               primary values, as the per-month code always did.          **/
+/********************************************************************************/
+static void cooling_setup(float fElevation, float *fDuctEffClg, CLG_SETUP *setup) {
 
-  float fHomeWidth = 0.0;
-  int i = 0;
-  int iMonth = zMonth + 1;        // base 1 month from zero based month
+  float fHomeWidth = mdi->gnl.width;
+  CLG_EQUIPMENT *pri = &setup->pri;
+  CLG_EQUIPMENT *sec = &setup->sec;
 
-  float fClgLoadDay = 0.0;
-  float fClgLoadNight = 0.0;
-  float fMetLoadDay = 0.0; 
-  float fMetLoadNight = 0.0; 
-  float fCoolLoad = 0.0; 
-  float fClgLoad = 0.0;           // Day or night clg load
-  float fDayHours = 0.0;          // Day hrs. value dependent on flgSetBack
-  float fNightHours = 0.0;        // Night hrs. value dependent on flgSetBack
-  int flgDay = 0;                 // Flags daytime or nighttime (1 = day)
-  float fRatedCoolCapacity = 0.0; // Rated total clg capacity (Btu/h)
-  float fRatedCOP = 0.0;          // Rated COP of clg equipment
-  float fDayCoolSet = 0.0;        // Day & night time dry-bulb clg setpoints
-  float fNightCoolSet = 0.0;
-  float fDistlossfactor = 0.0;    // Loss factor due to ducts & insulation
-  float fClgDuctLocation = 0.0;   // Factor based on duct location
-  float fClgDuctInsulation = 0.0; // Factor based on duct insulation
-  float fSetpoint = 0.0;          // Clg day/night setpoint
-  float fTdbOutside = 0.0;        // Outdoor dry bulb air temp for day/night
+  memset(setup, 0, sizeof(CLG_SETUP));
 
-  // VARIABLES USED IN ENERGY CONSUMPTION CALCULATIONS
-
-  float fP_Fan = 0.0;           // Fan Power in kW
-  float fPhi1 = 0.0;
-  float fPhi2 = 0.0;
-  float fPhi3 = 0.0;
-  float fTwi_star = 0.0;        // Apparatus wet bulb temp of circulating room air above evap saturation
-  float fTwi = 0.0;             // Inside wet bulb temperature in deg C
-  float fT_dc = 0.0;            // Mixed air temp entering the coil in deg C
-  float fAirRate = 0.0;         // Air flow rate in CMS (m^3/s)
-  float fAirFlow = 0.0;         // Air flow rate through the evaporator in kg per sec
-  float fNewInfMassFlow = 0.0;  // Infiltration mass flow rate multiplied by conversion factors
-  float fBy_pass = 0.40;        // By-pass factor at rated conditions
-  float fAlpha = 0.0;           // Intermediate calculation for Twi_star
-  float fBeta = 0.0;            // Intermediate calculation for Twi_star
-  float fGamma = 0.0;           // Intermediate calculation for Twi_star
-  float fTotal_cap = 0.0;       // Total adjusted cooling capacity in kW
-  float fSens_cap = 0.0;        // Adjusted sensible cooling capacity in kW
-  float fW_in = 0.0;            // Inside wet bulb temperature in deg C
-  float fPlr = 0.0;             // Part-load ratio
-  float fW_out = 0.0;           // Outside humidity ratio
-  float fP_ws = 0.0;            // Pressure of saturated pure water in psia
-  float fPressure = 0.0;        // Total pressure of moist air in psia
-  float fStep_one = 0.0;        // Intermediate calculation for fP_ws
-  float fStep_two = 0.0;        // Intermediate calculation for fP_ws
-  float fHours = 0.0;           // scratch variable for setback adjustment
-  float fTwbOutside_C = 0.0;    // Outside wetbulb temperature in deg C.
-
-  // Compute outside wetbulb temperature in deg C. Corrected MBG 8/03.
-
-  fTwbOutside_C = (float)((fTwbOutside - 32.0) * (5.0 / 9.0));
-
-  /*******************
-  Determine whether or not there is setback.
-  *******************/
-  if (flgSetBack == TRUE) // there is a setback.
-  {
-    fNightHours = mdi->key.length_of_night_thermostat_setback;
-    fDayHours = 24.0f - fNightHours;
-  } else // No setback.
-    fDayHours = fNightHours = 12.0;
-
-  /** 11/10/97, NLW - adjustment of setback calculations **/
-
-  fHours = 12.0;
-
-  fHomeWidth = mdi->gnl.width;
+  /*************************
+  If the CLG file doesn't exist or there is no
+  cooling equipment, there is nothing to set up.
+  *************************/
+  setup->flgNone = (mir->flgNoCLG == TRUE || mdi->clg.equip_type == CE_NONE);
+  if (setup->flgNone)
+    return;
 
   /******************
   Get fan power (convert W to kW).
   ******************/
-  fP_Fan = (float)(mdi->key.cooling_system_fan_power / 1000.0);
-
-  /*************************
-  Get the Primary Cooling Equipment data.
-  If the CLG file doesn't exist, set
-  cooling energy use to 0 and return.
-  *************************/
-  if (mir->flgNoCLG == TRUE) {
-    *fClgEnergyDay = 0.0;
-    *fClgEnergyNight = 0.0;
-    return (0);
-  }
-
-  /************************
-  If no cooling equipment or heating season,
-  set cooling energy use to 0 and return.
-  *************************/
-  if ((mdi->clg.equip_type == CE_NONE) || iSeason == HEATING) {
-    *fClgEnergyDay = 0.0;
-    *fClgEnergyNight = 0.0;
-    return (0);
-  }
+  pri->fP_Fan = (float)(mdi->key.cooling_system_fan_power / 1000.0);
 
   /**************************
   Get day and night cooling setpoints and convert to degrees Celcius.
   **************************/
-  fDayCoolSet = (float)((mdi->key.cooling_setpoint_day - 32.0) * (5.0 / 9.0));
-  fNightCoolSet = (float)((mdi->key.cooling_setpoint_night - 32.0) * (5.0 / 9.0));
+  setup->fDayCoolSet = (float)((mdi->key.cooling_setpoint_day - 32.0) * (5.0 / 9.0));
+  setup->fNightCoolSet = (float)((mdi->key.cooling_setpoint_night - 32.0) * (5.0 / 9.0));
 
-  /*********************
-  Reduce cooling load to the percent of the home cooled by system and convert
-  to metric (kWh) units and give new variable name.
-  *********************/
-  fClgLoadDay = (float)((fClgHourLoadDay / (float)BTU_PER_KWH) * (mdi->clg.percent_area_room_ac / 100.0));
-  fClgLoadNight = (float)((fClgHourLoadNight / (float)BTU_PER_KWH) * (mdi->clg.percent_area_room_ac / 100.0));
+  setup->fPressure = (float)(((-0.000938 * fElevation) + 29.737) / 2.036);
+  setup->dDensity = exp(-0.0001219755 * fElevation * 0.3048);
 
   /******************
-  Compute the air flow rate (meters^3/sec.) and hours of operation for room
+  Compute the air flow rate (meters^3/sec.) for room
   air-conditioners. Remember that capacities are in kBTU/h
   *******************/
   if (mdi->clg.equip_type == CE_ROOMAC) {
-    fAirRate = 0; // to avoid a compiler warning about uninitialized variables
     if (mdi->clg.capacity <= 16.0)
-      fAirRate = (float)(400.0 * CFMTOCMS);
+      pri->fAirRate = (float)(400.0 * CFMTOCMS);
     else if ((mdi->clg.capacity > 16.0) && (mdi->clg.capacity <= 26.0))
-      fAirRate = (float)(700.0 * CFMTOCMS);
+      pri->fAirRate = (float)(700.0 * CFMTOCMS);
     else if (mdi->clg.capacity > 26.0)
-      fAirRate = (float)(1000.0 * CFMTOCMS);
-
-    /** Per conversation w/ Sheila Hayter, NREL, 8/28/97, disable this redefinition
-        of operation hours for room AC units.
-
-            switch( zMonth )  //per tech notes page 72.1 - distr. of 750 op hours
-                              //  based on national avg.
-                {
-                case  0: fDayHours =   0.0;          fNightHours = 0.0; break;
-                case  1: fDayHours =   0.0;          fNightHours = 0.0; break;
-                case  2: fDayHours =   0.0;          fNightHours = 0.0; break;
-                case  3: fDayHours =  75.0/fNumDays; fNightHours = 0.0; break;
-                case  4: fDayHours =  75.0/fNumDays; fNightHours = 0.0; break;
-                case  5: fDayHours = 100.0/fNumDays; fNightHours = 0.0; break;
-                case  6: fDayHours = 200.0/fNumDays; fNightHours = 0.0; break;
-                case  7: fDayHours = 200.0/fNumDays; fNightHours = 0.0; break;
-                case  8: fDayHours = 100.0/fNumDays; fNightHours = 0.0; break;
-                case  9: fDayHours =   0.0;          fNightHours = 0.0; break;
-                case 10: fDayHours =   0.0;          fNightHours = 0.0; break;
-                case 11: fDayHours =   0.0;          fNightHours = 0.0; break;
-                }
-    **/
+      pri->fAirRate = (float)(1000.0 * CFMTOCMS);
   }
 
   // 8/8/97,NLW Modify air flow rates and fan power for evap cooling equip.
@@ -1055,79 +1005,68 @@ int get_cooling_consumption(int iSeason, int flgSetBack, int zMonth, float fNumD
   //         1/2HP, 115V, 3235CFM
 
   else if (mdi->clg.equip_type == CE_EVAPORATIVE)
-    //      /* Air Flow Rate in m^3/s (volume in ft^3 * conversion factor). */
-    //      fAirRate = fVolume * 0.2943;
     if (fHomeWidth < 20.0) {
-      fAirRate = (float)(1785.0 * CFMTOCMS);
-      fP_Fan = 0.250;
+      pri->fAirRate = (float)(1785.0 * CFMTOCMS);
+      pri->fP_Fan = 0.250;
     } else {
-      fP_Fan = 0.375;
-      fAirRate = (float)(3235.0 * CFMTOCMS);
+      pri->fP_Fan = 0.375;
+      pri->fAirRate = (float)(3235.0 * CFMTOCMS);
     }
   else /* all other cooling equipment types */
   {
     if (fHomeWidth < 20.0)
-      fAirRate = (float)(2500.0 * CFMTOCMS);
+      pri->fAirRate = (float)(2500.0 * CFMTOCMS);
     else
-      fAirRate = (float)(5000.0 * CFMTOCMS);
+      pri->fAirRate = (float)(5000.0 * CFMTOCMS);
   }
 
   /***********************
   Set fAirFlow (kg/s) = fAirRate (m^3/s) * adjusted air density.
   ***********************/
-  fAirFlow = (float)(fAirRate * AIR_DENSITY * exp(-0.0001219755 * fElevation * 0.3048));
-
-  fNewInfMassFlow = (float)(fInfMassFlow * CFMTOCMS * AIR_DENSITY * exp(-0.0001219755 * fElevation * 0.3048));
+  pri->fAirFlow = (float)(pri->fAirRate * AIR_DENSITY * setup->dDensity);
 
   /**********************
   Convert Capacity from Btuh to kW to keep in consistent units.
   Accommodate efficiencies entered as COP, EER, or SEER (MBG 1/30/03)
   Add climate adjustment to SEER.  MBG 4/08
   **********************/
-  fRatedCoolCapacity = mdi->clg.capacity * 1000.0f / (float)BTU_PER_KWH;
-  fRatedCOP = get_cooling_cop(mdi->clg.eff_units, mdi->clg.efficiency_cop, mdi->clg.efficiency_seer, mdi->clg.efficiency_eer);
-
-  // changed to account for specific COP coming from the
-  // clr replacement strucure 7/09 for 8.6
-
-  // #334 set in measure.c now
-  //if (mir->flgRetrofits[M_CMS_TUNE_COOLING_SYSTEM])
-  //  fRatedCOP = 3.0;
+  pri->fRatedCoolCapacity = mdi->clg.capacity * 1000.0f / (float)BTU_PER_KWH;
+  pri->fRatedCOP = get_cooling_cop(mdi->clg.eff_units, mdi->clg.efficiency_cop, mdi->clg.efficiency_seer, mdi->clg.efficiency_eer);
 
   /****************************
   Determine overall distribution loss factor
   ******************************/
   if (mdi->clg.equip_type == CE_EVAPORATIVE || mdi->clg.equip_type == CE_ROOMAC)
-    fDistlossfactor = 0.0;
+    pri->fDistlossfactor = 0.0;
   else /* centralAC or heatPump */
   {
     if (mdi->clg.duct_location == DL_FLOOR)
-      fClgDuctLocation = 0.50;
+      pri->fClgDuctLocation = 0.50;
     if (mdi->clg.duct_location == DL_CEILING)
-      fClgDuctLocation = 0.75;
+      pri->fClgDuctLocation = 0.75;
     if (mdi->clg.duct_location == DL_NONE)
-      fClgDuctLocation = 0.0;
+      pri->fClgDuctLocation = 0.0;
 
     if (mdi->clg.duct_insl == DI_ABOVE || mdi->clg.duct_insl == DI_BELOW || mdi->clg.duct_insl == DI_NONE)
-      fClgDuctInsulation = 50.0;
+      pri->fClgDuctInsulation = 50.0;
     else /* mdi->clg.duct_insl == DI_AROUND */
     {
       if (mdi->clg.duct_location == DL_FLOOR) {
         if ((mdi->flr.belly_mineral_insl >= 2.0) ||
             ((mdi->flr.belly_mineral_insl + mdi->flr.belly_loose_insl) >= mdi->flr.belly_depth))
-          fClgDuctInsulation = 8.75; /* for 2" insulation or more */
+          pri->fClgDuctInsulation = 8.75; /* for 2" insulation or more */
         else
-          fClgDuctInsulation = 25.0; /* for 1" insulation */
+          pri->fClgDuctInsulation = 25.0; /* for 1" insulation */
       }
       if (mdi->clg.duct_location == DL_CEILING) {
         if ((mdi->rof.mineral_insl >= 2.0) || ((mdi->rof.mineral_insl + mdi->rof.loose_insl) >= 8.0))
-          fClgDuctInsulation = 8.75; /* for 2" insulation or more */
+          pri->fClgDuctInsulation = 8.75; /* for 2" insulation or more */
         else
-          fClgDuctInsulation = 25.0; /* for 1" insulation */
+          pri->fClgDuctInsulation = 25.0; /* for 1" insulation */
       }
     }
 
-    fDistlossfactor = (float)(fClgDuctLocation * fClgDuctInsulation / 100.0);
+    pri->fDistlossfactor = (float)(pri->fClgDuctLocation * pri->fClgDuctInsulation / 100.0);
 
     // 5/8/95, NW - added an adjustment factor of 0.40 to reduce maximum distribution
     //          loss factor.  Per NREL TP-253-4490 (page 12) the worst-case effective
@@ -1136,22 +1075,181 @@ int get_cooling_consumption(int iSeason, int flgSetBack, int zMonth, float fNumD
     // NW,8/31/95: Update adjustment factor to 0.55 after correction of billing
     //      adjustment problem which biased previous measure savings results
 
-    fDistlossfactor *= 0.30F;
+    pri->fDistlossfactor *= 0.30F;
     /* If user has requested ducts to be evaluated from his input data, replace
      *   constant duct loss factors with those computed from ASHREA 152P
      *    MBG 11/7/01 - applied to cooling 12/18/02  */
 
     if (mdi->inf.evaluate_duct_sealing == YES) { // Duct measurements available
       if (mir->flgRetrofits[M_CMS_SEAL_DUCTS])     // Duct sealing measure active
-        fDistlossfactor = 1.0f - *(fDuctEffClg + 1);
+        pri->fDistlossfactor = 1.0f - *(fDuctEffClg + 1);
       else // Duct sealing measure not active
-        fDistlossfactor = 1.0f - *(fDuctEffClg + 0);
+        pri->fDistlossfactor = 1.0f - *(fDuctEffClg + 0);
     } else { // Use standard duct loss adjustments
       if (mir->flgRetrofits[M_CMS_SEAL_DUCTS])
-        fDistlossfactor *= (float)(1.0 - (mdi->key.duct_sealing_distribution_loss_reduction / 100.0));
+        pri->fDistlossfactor *= (float)(1.0 - (mdi->key.duct_sealing_distribution_loss_reduction / 100.0));
+    }
+  }
+
+  /*************************
+  Secondary Cooling Equipment data.  Fan power and air rate carry over
+  from the primary system unless the secondary sets its own.
+  *************************/
+  *sec = *pri;
+  sec->fDistlossfactor = 0.0; // MJF #70, secondary duct losses ignored since 2019
+
+  if (mdi->cl2.equip_type == 0 || mdi->cl2.equip_type == CE_NONE)
+    return;
+
+  if (mdi->cl2.equip_type == CE_ROOMAC) {
+    if (mdi->cl2.capacity <= 16.0)
+      sec->fAirRate = (float)(400.0 * CFMTOCMS);
+    else if ((mdi->cl2.capacity > 16.0) && (mdi->cl2.capacity <= 26.0))
+      sec->fAirRate = (float)(700.0 * CFMTOCMS);
+    else if (mdi->cl2.capacity > 26.0)
+      sec->fAirRate = (float)(1000.0 * CFMTOCMS);
+  } else if (mdi->cl2.equip_type == CE_EVAPORATIVE) {
+    if (fHomeWidth < 20.0) {
+      sec->fAirRate = (float)(1785.0 * CFMTOCMS);
+      sec->fP_Fan = 0.250;
+    } else {
+      sec->fP_Fan = 0.375;
+      sec->fAirRate = (float)(3235.0 * CFMTOCMS);
     }
+  } else /* all other cooling equipment types */
+  {
+    if (fHomeWidth < 20.0)
+      sec->fAirRate = (float)(2500.0 * CFMTOCMS);
+    else
+      sec->fAirRate = (float)(5000.0 * CFMTOCMS);
   }
 
+  sec->fAirFlow = (float)(sec->fAirRate * AIR_DENSITY * setup->dDensity);
+
+  sec->fRatedCoolCapacity = mdi->cl2.capacity * 1000.0f / (float)BTU_PER_KWH;
+  sec->fRatedCOP = get_cooling_cop(mdi->cl2.eff_units, mdi->cl2.efficiency_cop, mdi->cl2.efficiency_seer, mdi->cl2.efficiency_eer);
+}
+
+/*******************  FUNCTION NAME:  cooling_month  ******************************/
+/** DESCRIPTION:  Cooling energy use for one month given the equipment data  **/
+/**               from cooling_setup().                                      **/
+/********************************************************************************/
+static void cooling_month(const CLG_SETUP *setup, int iSeason, int flgSetBack, int zMonth, float fNumDays, float fElevation,
+                          float fInfMassFlow, float fTwbOutside, float fTdbOutsideDay, float fTdbOutsideNight, float fClgHourLoadDay,
+                          float fClgHourLoadNight, float *fClgEnergyDay, float *fClgEnergyNight) {
+
+  int i = 0;
+  int iMonth = zMonth + 1;        // base 1 month from zero based month
+
+  float fClgLoadDay = 0.0;
+  float fClgLoadNight = 0.0;
+  float fMetLoadDay = 0.0; 
+  float fMetLoadNight = 0.0; 
+  float fCoolLoad = 0.0; 
+  float fClgLoad = 0.0;           // Day or night clg load
+  float fDayHours = 0.0;          // Day hrs. value dependent on flgSetBack
+  float fNightHours = 0.0;        // Night hrs. value dependent on flgSetBack
+  int flgDay = 0;                 // Flags daytime or nighttime (1 = day)
+  float fRatedCoolCapacity = 0.0; // Rated total clg capacity (Btu/h)
+  float fRatedCOP = 0.0;          // Rated COP of clg equipment
+  float fDayCoolSet = 0.0;        // Day & night time dry-bulb clg setpoints
+  float fNightCoolSet = 0.0;
+  float fDistlossfactor = 0.0;    // Loss factor due to ducts & insulation
+  float fClgDuctLocation = 0.0;   // Factor based on duct location
+  float fClgDuctInsulation = 0.0; // Factor based on duct insulation
+  float fSetpoint = 0.0;          // Clg day/night setpoint
+  float fTdbOutside = 0.0;        // Outdoor dry bulb air temp for day/night
+
+  // VARIABLES USED IN ENERGY CONSUMPTION CALCULATIONS
+
+  float fP_Fan = 0.0;           // Fan Power in kW
+  float fPhi1 = 0.0;
+  float fPhi2 = 0.0;
+  float fPhi3 = 0.0;
+  float fTwi_star = 0.0;        // Apparatus wet bulb temp of circulating room air above evap saturation
+  float fTwi = 0.0;             // Inside wet bulb temperature in deg C
+  float fT_dc = 0.0;            // Mixed air temp entering the coil in deg C
+  float fAirRate = 0.0;         // Air flow rate in CMS (m^3/s)
+  float fAirFlow = 0.0;         // Air flow rate through the evaporator in kg per sec
+  float fNewInfMassFlow = 0.0;  // Infiltration mass flow rate multiplied by conversion factors
+  float fBy_pass = 0.40;        // By-pass factor at rated conditions
+  float fAlpha = 0.0;           // Intermediate calculation for Twi_star
+  float fBeta = 0.0;            // Intermediate calculation for Twi_star
+  float fGamma = 0.0;           // Intermediate calculation for Twi_star
+  float fTotal_cap = 0.0;       // Total adjusted cooling capacity in kW
+  float fSens_cap = 0.0;        // Adjusted sensible cooling capacity in kW
+  float fW_in = 0.0;            // Inside wet bulb temperature in deg C
+  float fPlr = 0.0;             // Part-load ratio
+  float fW_out = 0.0;           // Outside humidity ratio
+  float fP_ws = 0.0;            // Pressure of saturated pure water in psia
+  float fPressure = 0.0;        // Total pressure of moist air in psia
+  float fStep_one = 0.0;        // Intermediate calculation for fP_ws
+  float fStep_two = 0.0;        // Intermediate calculation for fP_ws
+  float fHours = 0.0;           // scratch variable for setback adjustment
+  float fTwbOutside_C = 0.0;    // Outside wetbulb temperature in deg C.
+
+  // Compute outside wetbulb temperature in deg C. Corrected MBG 8/03.
+
+  fTwbOutside_C = (float)((fTwbOutside - 32.0) * (5.0 / 9.0));
+
+  /*******************
+  Determine whether or not there is setback.
+  *******************/
+  if (flgSetBack == TRUE) // there is a setback.
+  {
+    fNightHours = mdi->key.length_of_night_thermostat_setback;
+    fDayHours = 24.0f - fNightHours;
+  } else // No setback.
+    fDayHours = fNightHours = 12.0;
+
+  /** 11/10/97, NLW - adjustment of setback calculations **/
+
+  fHours = 12.0;
+
+  /*************************
+  If there is no cooling equipment or it is the heating
+  season, set cooling energy use to 0 and return.
+  *************************/
+  if (setup->flgNone || iSeason == HEATING) {
+    *fClgEnergyDay = 0.0;
+    *fClgEnergyNight = 0.0;
+    return;
+  }
+
+  /**************************
+  Primary equipment data from cooling_setup()
+  **************************/
+  fP_Fan = setup->pri.fP_Fan;
+  fAirRate = setup->pri.fAirRate;
+  fAirFlow = setup->pri.fAirFlow;
+  fRatedCoolCapacity = setup->pri.fRatedCoolCapacity;
+  fRatedCOP = setup->pri.fRatedCOP;
+  fDistlossfactor = setup->pri.fDistlossfactor;
+  fClgDuctLocation = setup->pri.fClgDuctLocation;
+  fClgDuctInsulation = setup->pri.fClgDuctInsulation;
+  fDayCoolSet = setup->fDayCoolSet;
+  fNightCoolSet = setup->fNightCoolSet;
+  fPressure = setup->fPressure;
+
+  fNewInfMassFlow = (float)(fInfMassFlow * CFMTOCMS * AIR_DENSITY * setup->dDensity);
+
+  /*********************
+  Calculate the pressure of saturated water at the outdoor wet bulb
+  (fTwbOutside is still in degrees F).  Same for day and night.
+  **********************/
+  fStep_one = (float)((0.1289706 / 10000.0) * pow((459.67 + fTwbOutside), 2));
+  fStep_two = (float)((0.2478068 / 100000000.0) * pow((459.67 + fTwbOutside), 3));
+
+  fP_ws = (float)(exp((-10440.4 / (float)(459.67 + fTwbOutside)) - 11.2946669 - (0.02700133 * (459.67 + fTwbOutside)) +
+                      fStep_one - fStep_two + (6.5459673 * log(459.67 + fTwbOutside))));
+
+  /*********************
+  Reduce cooling load to the percent of the home cooled by system and convert
+  to metric (kWh) units and give new variable name.
+  *********************/
+  fClgLoadDay = (float)((fClgHourLoadDay / (float)BTU_PER_KWH) * (mdi->clg.percent_area_room_ac / 100.0));
+  fClgLoadNight = (float)((fClgHourLoadNight / (float)BTU_PER_KWH) * (mdi->clg.percent_area_room_ac / 100.0));
+
   /********************************************************
    If originally given an SEER, eliminate conversion of intantaneous to
    seasonal value.  Use the seasonal SEER given on input (MBG-1/30/03)
@@ -1211,14 +1309,6 @@ int get_cooling_consumption(int iSeason, int flgSetBack, int zMonth, float fNumD
       Calculate the outdoor humidity ratio (fW_out).
       (fTwbOutside is still in degrees F for the fW_out calcs.)
       **********************/
-      fStep_one = (float)((0.1289706 / 10000.0) * pow((459.67 + fTwbOutside), 2));
-      fStep_two = (float)((0.2478068 / 100000000.0) * pow((459.67 + fTwbOutside), 3));
-
-      fP_ws = (float)(exp((-10440.4 / (float)(459.67 + fTwbOutside)) - 11.2946669 - (0.02700133 * (459.67 + fTwbOutside)) +
-                          fStep_one - fStep_two + (6.5459673 * log(459.67 + fTwbOutside))));
-
-      fPressure = (float)(((-0.000938 * fElevation) + 29.737) / 2.036);
-
       ASSERT((fPressure - fP_ws) != 0, sprintf(msg, "Assertion Failure"));
       fW_out = (float)((((1093 - 0.556 * fTwbOutside) * (0.62198 * fP_ws / (float)(fPressure - fP_ws))) -
                         (0.24 * (fTdbOutside - fTwbOutside))) /
@@ -1325,21 +1415,8 @@ int get_cooling_consumption(int iSeason, int flgSetBack, int zMonth, float fNumD
       then the cooling equipment does not meet the load.  Flags are
       set here to print this condition in the savings output file.
       ***************/
-      if (mir->flgWhichPass == BASE_CASE) {
-        if (fPlr >= 1.0) {
-          mir->flgPreHighCLGLoad = TRUE;
-          mir->iPreHighLoadMonths[zMonth] = TRUE;
-        }
-        //              else
-        //                  mir->iPreHighLoadMonths[zMonth] = FALSE;
-      } else if (mir->flgWhichPass == CUMULATIVE) {
-        if (fPlr >= 1.0) {
-          mir->flgPostHighCLGLoad = TRUE;
-          mir->iPostHighLoadMonths[zMonth] = TRUE;
-        }
-        //              else
-        //                  mir->iPostHighLoadMonths[zMonth] = FALSE;
-      }
+      if (fPlr >= 1.0)
+        mhea_high_load(COOLING, zMonth);
 
       /***********************
       Total cooling day/night energy use for the month and
@@ -1446,149 +1523,14 @@ int get_cooling_consumption(int iSeason, int flgSetBack, int zMonth, float fNumD
   } else { // start of a very long else clause IF there IS secondary cooling equip
 
     /*********************
-    If secondary equipment type is Room AC, then compute the air flow rate
-    (meters^3/sec.) and the hours of operation.
+    Secondary equipment data from cooling_setup()
     *********************/
-    if (mdi->cl2.equip_type == CE_ROOMAC) {
-      if (mdi->cl2.capacity <= 16.0)
-        fAirRate = (float)(400.0 * CFMTOCMS);
-      else if ((mdi->cl2.capacity > 16.0) && (mdi->cl2.capacity <= 26.0))
-        fAirRate = (float)(700.0 * CFMTOCMS);
-      else if (mdi->cl2.capacity > 26.0)
-        fAirRate = (float)(1000.0 * CFMTOCMS);
-
-      /** remove reduced operation hours for room AC - see note is primary cooling section
-      // 8/28/    97, NLW
-
-      switch( zMonth )
-          {
-          case  0: fDayHours =   0.0;          fNightHours = 0.0; break;
-          case  1: fDayHours =   0.0;          fNightHours = 0.0; break;
-          case  2: fDayHours =   0.0;          fNightHours = 0.0; break;
-          case  3: fDayHours =  75.0/fNumDays; fNightHours = 0.0; break;
-          case  4: fDayHours =  75.0/fNumDays; fNightHours = 0.0; break;
-          case  5: fDayHours = 100.0/fNumDays; fNightHours = 0.0; break;
-          case  6: fDayHours = 200.0/fNumDays; fNightHours = 0.0; break;
-          case  7: fDayHours = 200.0/fNumDays; fNightHours = 0.0; break;
-          case  8: fDayHours = 100.0/fNumDays; fNightHours = 0.0; break;
-          case  9: fDayHours =   0.0;          fNightHours = 0.0; break;
-          case 10: fDayHours =   0.0;          fNightHours = 0.0; break;
-          case 11: fDayHours =   0.0;          fNightHours = 0.0; break;
-          }
-                  **/
-
-    } else if (mdi->cl2.equip_type == CE_EVAPORATIVE) {
-
-      /* Air Flow Rate in m^3/s (volume in ft^3 * conversion factor). */
-      // fAirRate = fVolume * 0.2943;
-      // 8/8/97,NLW Modify air flow rates and fan power for evap cooling equip.
-      //   Based on units listed in 1997 RS MEANS Mech Cost Data (p271)
-      //   two unit sizes will be used:
-      //         1/3HP, 115V, 1785CFM and
-      //         1/2HP, 115V, 3235CFM
-
-      if (fHomeWidth < 20.0) {
-        fAirRate = (float)(1785.0 * CFMTOCMS);
-        fP_Fan = 0.250;
-      } else {
-        fP_Fan = 0.375;
-        fAirRate = (float)(3235.0 * CFMTOCMS);
-      }
-    }
-
-    else /* all other cooling equipment types */
-    {
-      if (fHomeWidth < 20.0)
-        fAirRate = (float)(2500.0 * CFMTOCMS);
-      else
-        fAirRate = (float)(5000.0 * CFMTOCMS);
-    }
-
-    /***********************
-    Set fAirFlow = fAirRate (m^/s) * adjusted air density (kg/m^3).
-    ***********************/
-    fAirFlow = (float)(fAirRate * AIR_DENSITY * exp(-0.0001219755 * fElevation * 0.3048));
-
-    fNewInfMassFlow = (float)(fInfMassFlow * CFMTOCMS * AIR_DENSITY * exp(-0.0001219755 * fElevation * 0.3048));
-
-    /**********************
-    Convert Capacity from Btuh to kW to keep in consistent units.
-    Accommodate efficiencies entered as COP, EER, or SEER (MBG 1/30/03)
-    **********************/
-    fRatedCoolCapacity = mdi->cl2.capacity * 1000.0f / (float)BTU_PER_KWH;
-    // if (mdi->cl2.eff_units == CE_COP)
-    //   fRatedCOP = mdi->cl2.eff;
-    // else
-    //   fRatedCOP = (float)(mdi->cl2.eff / 3.413);
-    fRatedCOP = get_cooling_cop(mdi->cl2.eff_units, mdi->cl2.efficiency_cop, mdi->cl2.efficiency_seer, mdi->cl2.efficiency_eer);
-
-    // changed to account for specific COP coming from the
-    // clr replacement strucure 7/09 for 8.6
-    //
-    // if( mir->flgRetrofits[M_CMS_TUNE_COOLING_SYSTEM] ||
-    //    mir->flgRetrofits[M_CMS_REPLACE_DX_COOLING_EQUIP])
-    //    fRatedCOP = 3.0;
-
-    // #334 The cooling system tune up now effects the mdi in measure.c
-    // if (mir->flgRetrofits[M_CMS_TUNE_COOLING_SYSTEM])
-    //   fRatedCOP = 3.0;
-
-    /****************************
-    Determine overall distribution loss factor
-    ******************************/
-    if (mdi->cl2.equip_type == CE_EVAPORATIVE || mdi->cl2.equip_type == CE_ROOMAC)
-      fDistlossfactor = 0.0;
-    else /* centralAC or heatPump */
-    {
-
-      fDistlossfactor = 0.0;      // MJF #70
-
-      // Retained for possible secondary system duct loss consideration, but as of 2019, ignore
-      // duct lost factor for ducted secondary cooling systems (should be pretty rare for manufactured house
-      // with the exception of addtions)
-
-      // if (mdi->cl2.clg_duct_location == DL_FLOOR)
-      //   fClgDuctLocation = 0.50;
-      // if (mdi->cl2.clg_duct_location == DL_CEILING)
-      //   fClgDuctLocation = 0.75;
-      // if (mdi->cl2.clg_duct_location == DL_NONE || mdi->cl2.clg_duct_location == 0)
-      //   fClgDuctLocation = 0.0;
-
-      // if (mdi->cl2.clg_duct_insl == DI_ABOVE || mdi->cl2.clg_duct_insl == DI_BELOW || mdi->cl2.clg_duct_insl == DI_NONE ||
-      //     mdi->cl2.clg_duct_insl == 0)
-      //   fClgDuctInsulation = 50.0;
-      // else /* mdi->cl2.clg_duct_insl == DI_AROUND */
-      // {
-      //   if (mdi->cl2.clg_duct_location == DL_FLOOR) {
-      //     if ((mdi->flr.belly_mineral_insl >= 2.0) ||
-      //         ((mdi->flr.belly_mineral_insl + mdi->flr.belly_loose_insl) >= mdi->flr.belly_depth))
-      //       fClgDuctInsulation = 8.75; /* for 2" insulation or more */
-      //     else
-      //       fClgDuctInsulation = 25.0; /* for 1" insulation */
-      //   }
-      //   if (mdi->cl2.clg_duct_location == DL_CEILING) {
-      //     if ((mdi->rof.mineral_insl >= 2.0) || ((mdi->rof.mineral_insl + mdi->rof.loose_insl) >= 8.0))
-      //       fClgDuctInsulation = 8.75; /* for 2" insulation or more */
-      //     else
-      //       fClgDuctInsulation = 25.0; /* for 1" insulation */
-      //   }
-      // }
-
-      // fDistlossfactor = (float)(fClgDuctLocation * fClgDuctInsulation / 100.0);
-
-      // // 5/8/95, NW - added an adjustment factor of 0.40 to reduce maximum distribution
-      // //         loss factor.  Per NREL TP-253-4490 (page 12) the worst-case effective
-      // //         furnace efficiency should be approx. 56%.
-
-      // // NW,8/31/95: Update adjustment factor to 0.55 after correction of billing
-      // //         adjustment problem which biased previous measure savings results
-
-      // fDistlossfactor *= 0.30F;
-
-      // if (mir->flgRetrofits[M_CMS_SEAL_DUCTS])
-      //   fDistlossfactor *= (float)(1.0 - (mdi->key.duct_sealing_distribution_loss_reduction / 100.0));
-
-    }
+    fP_Fan = setup->sec.fP_Fan;
+    fAirRate = setup->sec.fAirRate;
+    fAirFlow = setup->sec.fAirFlow;
+    fRatedCoolCapacity = setup->sec.fRatedCoolCapacity;
+    fRatedCOP = setup->sec.fRatedCOP;
+    fDistlossfactor = setup->sec.fDistlossfactor;
 
     /********************************************************
      If originally given an SEER, eliminate conversion of intantaneous to
@@ -1648,14 +1590,6 @@ int get_cooling_consumption(int iSeason, int flgSetBack, int zMonth, float fNumD
         Calculate the outdoor humidity ratio (fW_out).
         (fTwbOutside is still in degrees F for the fW_out calcs.)
         **********************/
-        fStep_one = (float)((0.1289706 / 10000.0) * pow((459.67 + fTwbOutside), 2));
-        fStep_two = (float)((0.2478068 / 100000000.0) * pow((459.67 + fTwbOutside), 3));
-
-        fP_ws = (float)(exp((-10440.4 / (float)(459.67 + fTwbOutside)) - 11.2946669 - (0.02700133 * (459.67 + fTwbOutside)) +
-                            fStep_one - fStep_two + (6.5459673 * log(459.67 + fTwbOutside))));
-
-        fPressure = (float)(((-0.000938 * fElevation) + 29.737) / 2.036);
-
         ASSERT((fPressure - fP_ws) != 0, sprintf(msg, "Assertion Failure"));
         fW_out = (float)((((1093 - 0.556 * fTwbOutside) * (0.62198 * fP_ws / (float)(fPressure - fP_ws))) -
                           (0.24 * (fTdbOutside - fTwbOutside))) /
@@ -1813,9 +1747,56 @@ int get_cooling_consumption(int iSeason, int flgSetBack, int zMonth, float fNumD
 
   }     // end of very LONG if clause for secondary cooling system
 
-  return (0);
+  return;
+
+} // End void cooling_month( ... float *fClgEnergyDay ... ) user function.
+
+/*******************  FUNCTION NAME:  get_heating_consumption_months  ************/
+/** DESCRIPTION:  Heating energy use (Btu) for all twelve months of one       **/
+/**               energy call.  The equipment data is set up once rather     **/
+/**               than per month as get_heating_consumption() once did, with  **/
+/**               the same results.  The arrays are base zero by month.       **/
+/*********************************************************************************/
+void get_heating_consumption_months(const MONTH_LOADS *loads, float fDistlossfactor, float fHtgEnerUse_Day[],
+                                    float fHtgEnerUse_Night[]) {
+
+  HTG_SETUP setup;
 
-} // End void get_cooling_consumption( ... float *fClgEnergyDay ... ) user function.
+  heating_setup(&setup);
+
+  for (int zMonth = 0; zMonth < MONTHS; zMonth++) {
+    int iMonth = zMonth + 1;
+
+    // the setback interpolation reads the month's night setpoint from the MIR
+    mir->fNightSetpoint = loads->fNightSetpoint[zMonth];
+
+    heating_month(&setup, loads->iSeason[zMonth], loads->iflgSetBack[zMonth], zMonth, cwd->days_in_month[iMonth],
+                  cwd->avg_daytime_temp[iMonth], cwd->avg_nighttime_temp[iMonth], loads->fHourLoadDay[zMonth],
+                  loads->fHourLoadNight[zMonth], fDistlossfactor, &fHtgEnerUse_Day[zMonth], &fHtgEnerUse_Night[zMonth]);
+  }
+}
+
+/*******************  FUNCTION NAME:  get_cooling_consumption_months  ************/
+/** DESCRIPTION:  Cooling energy use (Btu) for all twelve months of one       **/
+/**               energy call.  Equipment air flow, capacity, COP and duct    **/
+/**               losses are set up once rather than per month as            **/
+/**               get_cooling_consumption() once did, with the same results. **/
+/*********************************************************************************/
+void get_cooling_consumption_months(const MONTH_LOADS *loads, float *fDuctEffClg, float fClgEnergyDay[], float fClgEnergyNight[]) {
+
+  CLG_SETUP setup;
+
+  cooling_setup(cwd->altitude, fDuctEffClg, &setup);
+
+  for (int zMonth = 0; zMonth < MONTHS; zMonth++) {
+    int iMonth = zMonth + 1;
+
+    cooling_month(&setup, loads->iSeason[zMonth], loads->iflgSetBack[zMonth], zMonth, cwd->days_in_month[iMonth], cwd->altitude,
+                  loads->fInfMassFlow[zMonth], cwd->avg_wet_temp[iMonth], cwd->avg_daytime_temp[iMonth],
+                  cwd->avg_nighttime_temp[iMonth], loads->fHourLoadDay[zMonth], loads->fHourLoadNight[zMonth],
+                  &fClgEnergyDay[zMonth], &fClgEnergyNight[zMonth]);
+  }
+}
 
 float get_cooling_cop(int units, float efficiency_cop, float efficiency_seer, float efficiency_eer) {
   float fRatedCOP;
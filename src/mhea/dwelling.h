@@ -105,6 +105,7 @@ typedef struct {
   // Computed fields
   float leak_coef;   // Leakiness coefficient of window
   int imeas_applied; // Number of Window measure applied to window
+  int code_id;       // interned component code, see component_code_id()
 } M_WIN;
 
 // *******************************************
@@ -129,6 +130,7 @@ typedef struct {
 
   // computed fields MJF 3/2019
   float leak_coef;                     // leakage coefficient for door
+  int code_id;                         // interned component code, see component_code_id()
 } M_DOR;
 
 // ***********************************************
@@ -437,9 +439,23 @@ typedef struct {
   
   float low_flow_shower_head_flow_rate;               
   float water_heater_wrap_added_r_value;              
-  float refrigerator_defrost_cycle_energy;            
+  float refrigerator_defrost_cycle_energy;
 } M_KEY;
 
+// ****************************************************
+// An economic scenario is another set of fuel prices, escalation
+// rates and discount rate to evaluate the audit's measures with.
+// Anything the scenario leaves out is the audit's own.
+// ****************************************************
+
+typedef struct {
+  char name[MEASURENAME_LEN + 1]; // scenario name for the results
+  FCS fcs;                        // fuel prices and heat contents
+  RER rer;                        // referenced escalation rates, year 0 for the audit's
+  FER fer[FUEL_TYPES];            // the escalation rates used
+  float real_discount_rate;       // percent
+} M_SCN;
+
 
 // ---------------drum roll please-------------------------
 
@@ -503,6 +519,9 @@ typedef struct {
   int num_fer;
   FER fer[FUEL_TYPES];
 
+  int num_scn;
+  M_SCN scn[MHEA_MAX_SCENARIOS]; // optional economic scenarios, see scenario.c
+
   int num_cms;
   CMS cms[MHEA_MAX_CMS];
 
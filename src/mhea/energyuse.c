@@ -8,6 +8,7 @@
 /**     11/06/97 NLW - Modified getloads call to pass setback delta_T  **/
 /**                                                                                         **/
 /*************************************************************************/
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -15,9 +16,34 @@
 #include "wa_engine.h"
 
 static int iMonthSeason[12];
+static int iHighLoadMonths[2]; // months, by bit, the current call's equipment missed the load; [0] heating, [1] cooling
 
+enum COMPONENT { iFLOOR, iWALL, iWINDOW, iDOOR, iROOF, COMPONENTS };
+
+static void compute_energy_use(void);
 static void get_distribution_losses(float *fDuctEffHtg, float *fDuctEffClg, float *fDistlossfactor_Htg, float *fDistlossfactor_Clg);
 
+static void energy_memo_clear(void);
+static int energy_memo_state(float **state);
+static unsigned long long energy_memo_key(void);
+static int energy_memo_hit(unsigned long long key);
+static void energy_memo_store(unsigned long long key);
+static void set_high_load(int iSeason, int zMonth);
+
+static void cached_ua_floor(float *fUA_FLR_S, float *fUA_FLR_W);
+static void cached_ua_wall(float *fVolumeAddition, float *fUA_WAL_S, float *fUA_WAL_W, float *fSA_WAL_S_N, float *fSA_WAL_S_S,
+                           float *fSA_WAL_S_E, float *fSA_WAL_S_W, float *fSA_WAL_W_N, float *fSA_WAL_W_S, float *fSA_WAL_W_E,
+                           float *fSA_WAL_W_W, float *fShadingRatioL, float *fShadingRatioW2H);
+static void cached_ua_window(float *fUA_WIN_S, float *fUA_WIN_W, float *fSA_WIN_S_N, float *fSA_WIN_S_S, float *fSA_WIN_S_E,
+                             float *fSA_WIN_S_W, float *fSA_WIN_W_N, float *fSA_WIN_W_S, float *fSA_WIN_W_E, float *fSA_WIN_W_W,
+                             float *fShadingRatioAwn, float *fShadingRatioPch);
+static void cached_ua_door(float *fUA_DOR_S, float *fUA_DOR_W, float *fSA_DOR_S_N, float *fSA_DOR_S_S, float *fSA_DOR_S_E,
+                           float *fSA_DOR_S_W, float *fSA_DOR_W_N, float *fSA_DOR_W_S, float *fSA_DOR_W_E, float *fSA_DOR_W_W);
+static void cached_ua_roof(float fHeatCapacity, float *fVolumeCathCeiling, float *fUA_ROF_S, float *fUA_ROF_W, float *fSA_ROF_S,
+                           float *fSA_ROF_W);
+static void cached_solar_gains(int iComponent, float fShadingRatioAwn, float fShadingRatioL, float fShadingRatioW2H, float fSA_N,
+                               float fSA_S, float fSA_E, float fSA_W, float fSA_ROF, float fSG[MONTHS]);
+
 /***************************************************************************
 ** Function Name: get_base_load
 **          Date: October 2, 2001
@@ -50,6 +76,61 @@ void get_base_load(void) {
 **               Does not compute the base loads (electric)
 **************************************************************************/
 void mhea_energy_use(void) {
+  unsigned long long key;
+
+  mor->energy_calc_counter++;    // #94
+  performance_count(PC_ENERGY_CALLS); // the counter above is saved and restored around package searches
+
+  if (mir->flgWhichPass == BASE_CASE)
+    energy_memo_clear();
+
+  iHighLoadMonths[0] = iHighLoadMonths[1] = 0;
+
+  if (mir->flgWhichPass == BASE_CASE || (cmds.debug_level & D_MHEA_ENERGY_DETAIL)) {
+    compute_energy_use();
+    return;
+  }
+
+  key = energy_memo_key();
+  if (energy_memo_hit(key))
+    return;
+
+  compute_energy_use();
+  energy_memo_store(key);
+}
+
+/***************************************************************************
+** Function Name: mhea_high_load
+**
+**  DESCRIPTION: Called by the consumption routines when the heating or
+**               cooling equipment cannot meet the load in a month (part
+**               load ratio clipped to 1.0).  Sets the flags printed in the
+**               savings output and keeps the month for the energy use memo.
+**************************************************************************/
+void mhea_high_load(int iSeason, int zMonth) {
+  iHighLoadMonths[iSeason == COOLING] |= 1 << zMonth;
+  set_high_load(iSeason, zMonth);
+}
+
+// The flags are only kept for the base case and the cumulative pass
+static void set_high_load(int iSeason, int zMonth) {
+  if (mir->flgWhichPass == BASE_CASE) {
+    if (iSeason == COOLING)
+      mir->flgPreHighCLGLoad = TRUE;
+    else
+      mir->flgPreHighHTGLoad = TRUE;
+    mir->iPreHighLoadMonths[zMonth] = TRUE;
+  } else if (mir->flgWhichPass == CUMULATIVE) {
+    if (iSeason == COOLING)
+      mir->flgPostHighCLGLoad = TRUE;
+    else
+      mir->flgPostHighHTGLoad = TRUE;
+    mir->iPostHighLoadMonths[zMonth] = TRUE;
+  }
+}
+
+// The bin method calculation behind mhea_energy_use()
+static void compute_energy_use(void) {
   float fAirHeatCap; /* Vol. specific heat cap. of air */
   //float fTempOutDay, fTempOutNight, fTempWetbulb;
   float fDH_Day[9], /* Avg Degree-Hours per Day/night */
@@ -61,7 +142,6 @@ void mhea_energy_use(void) {
   
   //enum { COOLING = -1, HEATING = 1 } iSeason;
   int iSeason;
-  enum { iFLOOR, iWALL, iWINDOW, iDOOR, iROOF } iComponent;
 
   float fUA_FLR_S = 0.0, /* UA value for the Floor */
       fUA_FLR_W = 0.0;   /*  in Summer and Winter  */
@@ -100,6 +180,8 @@ void mhea_energy_use(void) {
       fSA_ROF_W = 0.0,   /*  & Ceiling in Summer & Winter */
       fSA_ROF = 0.0;
   float fSG_ROF = 0.0; /* Solar Gain for the Roof */
+  float fSG_WAL_Month[MONTHS], fSG_WIN_Month[MONTHS], /* Monthly Solar Gains by component */
+      fSG_DOR_Month[MONTHS], fSG_ROF_Month[MONTHS];
 
   float fVolumeCathCeiling = 0.0, /* Volume of Cathedral Ceiling */
       fVolumeAddition = 0.0;      /* Volume of Home Addition */
@@ -142,8 +224,9 @@ void mhea_energy_use(void) {
   float fTBalanceDay = 0.0, fTBalanceNight = 0.0;
   float fDegHourDay = 0.0, fDegHourNight = 0.0;
   float fHourLoadDay = 0.0, fHourLoadNight = 0.0;
-  float fHtgEnerUseDay = 0.0, fHtgEnerUseNight = 0.0;
-  float fClgEnerUseDay = 0.0, fClgEnerUseNight = 0.0;
+  float fHtgEnerUseDay[MONTHS], fHtgEnerUseNight[MONTHS];
+  float fClgEnerUseDay[MONTHS], fClgEnerUseNight[MONTHS];
+  MONTH_LOADS loads;
 
   float fTotalLoadHtg = 0.0, // used in debug code only
       fTotalLoadClg = 0.0;
@@ -156,8 +239,6 @@ void mhea_energy_use(void) {
   int iDuctStatus = 0;
   float fDuct_Loss_Factr = 0.0;
 
-  mor->energy_calc_counter++;    // #94
-
   /****************************************************/
   /*  Initialize passed variables to zero in order to */
   /*  avoid cumulative affects in the retrofits code  */
@@ -193,18 +274,18 @@ void mhea_energy_use(void) {
   /*   Solar Apertures  (1/ft^2)                */
   /**********************************************/
 
-  ua_floor(&fUA_FLR_S, &fUA_FLR_W);
+  cached_ua_floor(&fUA_FLR_S, &fUA_FLR_W);
 
-  ua_wall(&fVolumeAddition, &fUA_WAL_S, &fUA_WAL_W, &fSA_WAL_S_N, &fSA_WAL_S_S, &fSA_WAL_S_E, &fSA_WAL_S_W, &fSA_WAL_W_N,
-          &fSA_WAL_W_S, &fSA_WAL_W_E, &fSA_WAL_W_W, &fShadingRatioL, &fShadingRatioW2H);
+  cached_ua_wall(&fVolumeAddition, &fUA_WAL_S, &fUA_WAL_W, &fSA_WAL_S_N, &fSA_WAL_S_S, &fSA_WAL_S_E, &fSA_WAL_S_W, &fSA_WAL_W_N,
+                 &fSA_WAL_W_S, &fSA_WAL_W_E, &fSA_WAL_W_W, &fShadingRatioL, &fShadingRatioW2H);
 
-  ua_window(&fUA_WIN_S, &fUA_WIN_W, &fSA_WIN_S_N, &fSA_WIN_S_S, &fSA_WIN_S_E, &fSA_WIN_S_W, &fSA_WIN_W_N, &fSA_WIN_W_S,
-            &fSA_WIN_W_E, &fSA_WIN_W_W, &fShadingRatioAwn, &fShadingRatioPch);
+  cached_ua_window(&fUA_WIN_S, &fUA_WIN_W, &fSA_WIN_S_N, &fSA_WIN_S_S, &fSA_WIN_S_E, &fSA_WIN_S_W, &fSA_WIN_W_N, &fSA_WIN_W_S,
+                   &fSA_WIN_W_E, &fSA_WIN_W_W, &fShadingRatioAwn, &fShadingRatioPch);
 
-  ua_door(&fUA_DOR_S, &fUA_DOR_W, &fSA_DOR_S_N, &fSA_DOR_S_S, &fSA_DOR_S_E, &fSA_DOR_S_W, &fSA_DOR_W_N, &fSA_DOR_W_S,
-          &fSA_DOR_W_E, &fSA_DOR_W_W);
+  cached_ua_door(&fUA_DOR_S, &fUA_DOR_W, &fSA_DOR_S_N, &fSA_DOR_S_S, &fSA_DOR_S_E, &fSA_DOR_S_W, &fSA_DOR_W_N, &fSA_DOR_W_S,
+                 &fSA_DOR_W_E, &fSA_DOR_W_W);
 
-  ua_roof(fAirHeatCap, &fVolumeCathCeiling, &fUA_ROF_S, &fUA_ROF_W, &fSA_ROF_S, &fSA_ROF_W);
+  cached_ua_roof(fAirHeatCap, &fVolumeCathCeiling, &fUA_ROF_S, &fUA_ROF_W, &fSA_ROF_S, &fSA_ROF_W);
 
   fUA_VertS_S = fUA_WAL_S + fUA_WIN_S + fUA_DOR_S;
   fUA_VertS_W = fUA_WAL_W + fUA_WIN_W + fUA_DOR_W;
@@ -268,6 +349,43 @@ void mhea_energy_use(void) {
   fFreeHeatDay = mdi->key.free_heat_from_interior_sources_day;
   fFreeHeatNight = mdi->key.free_heat_from_interior_sources_night;
 
+  /***************
+  Average UA and SA values.
+  ***************/
+  fSA_WAL_N = (float)((fSA_WAL_W_N + fSA_WAL_S_N) / 2.0);
+  fSA_WAL_S = (float)((fSA_WAL_W_S + fSA_WAL_S_S) / 2.0);
+  fSA_WAL_E = (float)((fSA_WAL_W_E + fSA_WAL_S_E) / 2.0);
+  fSA_WAL_W = (float)((fSA_WAL_W_W + fSA_WAL_S_W) / 2.0);
+  fSA_WIN_N = (float)((fSA_WIN_W_N + fSA_WIN_S_N) / 2.0);
+  fSA_WIN_S = (float)((fSA_WIN_W_S + fSA_WIN_S_S) / 2.0);
+  fSA_WIN_E = (float)((fSA_WIN_W_E + fSA_WIN_S_E) / 2.0);
+  fSA_WIN_W = (float)((fSA_WIN_W_W + fSA_WIN_S_W) / 2.0);
+  fSA_DOR_N = (float)((fSA_DOR_W_N + fSA_DOR_S_N) / 2.0);
+  fSA_DOR_S = (float)((fSA_DOR_W_S + fSA_DOR_S_S) / 2.0);
+  fSA_DOR_E = (float)((fSA_DOR_W_E + fSA_DOR_S_E) / 2.0);
+  fSA_DOR_W = (float)((fSA_DOR_W_W + fSA_DOR_S_W) / 2.0);
+
+  fSA_ROF = (float)((fSA_ROF_W + fSA_ROF_S) / 2.0);
+  fUA_ROF = (float)((fUA_ROF_W + fUA_ROF_S) / 2.0);
+  fUA_VertS = (float)((fUA_VertS_W + fUA_VertS_S) / 2.0);
+  fConductionHeatLoss = (float)((fConductionHeatLoss_W + fConductionHeatLoss_S) / 2.0);
+
+  /**************************/
+  /*  Solar Gains  (Btu/h)  */
+  /**************************/
+
+  // Whole year of monthly gains for each component, carried from the last calls
+  // with the same apertures (see cached_solar_gains())
+
+  cached_solar_gains(iWALL, 0.0, fShadingRatioL, fShadingRatioW2H, fSA_WAL_N, fSA_WAL_S, fSA_WAL_E, fSA_WAL_W, 0.0, fSG_WAL_Month);
+
+  cached_solar_gains(iWINDOW, mdi->key.ratio_of_awning_depth_to_window_height, fShadingRatioAwn, fShadingRatioPch, fSA_WIN_N,
+                     fSA_WIN_S, fSA_WIN_E, fSA_WIN_W, 0.0, fSG_WIN_Month);
+
+  cached_solar_gains(iDOOR, 0.0, fShadingRatioL, fShadingRatioW2H, fSA_DOR_N, fSA_DOR_S, fSA_DOR_E, fSA_DOR_W, 0.0, fSG_DOR_Month);
+
+  cached_solar_gains(iROOF, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, fSA_ROF, fSG_ROF_Month);
+
   /********************************************/
   /*  Determine if Heating or Cooling Season  */
   /********************************************/
@@ -294,48 +412,10 @@ void mhea_energy_use(void) {
     else
       mir->fNightSetpoint = mdi->key.heating_setpoint_night;
 
-    /***************
-    Average UA and SA values.
-    ***************/
-    fSA_WAL_N = (float)((fSA_WAL_W_N + fSA_WAL_S_N) / 2.0);
-    fSA_WAL_S = (float)((fSA_WAL_W_S + fSA_WAL_S_S) / 2.0);
-    fSA_WAL_E = (float)((fSA_WAL_W_E + fSA_WAL_S_E) / 2.0);
-    fSA_WAL_W = (float)((fSA_WAL_W_W + fSA_WAL_S_W) / 2.0);
-    fSA_WIN_N = (float)((fSA_WIN_W_N + fSA_WIN_S_N) / 2.0);
-    fSA_WIN_S = (float)((fSA_WIN_W_S + fSA_WIN_S_S) / 2.0);
-    fSA_WIN_E = (float)((fSA_WIN_W_E + fSA_WIN_S_E) / 2.0);
-    fSA_WIN_W = (float)((fSA_WIN_W_W + fSA_WIN_S_W) / 2.0);
-    fSA_DOR_N = (float)((fSA_DOR_W_N + fSA_DOR_S_N) / 2.0);
-    fSA_DOR_S = (float)((fSA_DOR_W_S + fSA_DOR_S_S) / 2.0);
-    fSA_DOR_E = (float)((fSA_DOR_W_E + fSA_DOR_S_E) / 2.0);
-    fSA_DOR_W = (float)((fSA_DOR_W_W + fSA_DOR_S_W) / 2.0);
-
-    fSA_ROF = (float)((fSA_ROF_W + fSA_ROF_S) / 2.0);
-    fUA_ROF = (float)((fUA_ROF_W + fUA_ROF_S) / 2.0);
-    fUA_VertS = (float)((fUA_VertS_W + fUA_VertS_S) / 2.0);
-    fConductionHeatLoss = (float)((fConductionHeatLoss_W + fConductionHeatLoss_S) / 2.0);
-
-    /**************************/
-    /*  Solar Gains  (Btu/h)  */
-    /**************************/
-
-    iComponent = iWALL;
-    fSG_WAL = component_solar_gain(iComponent, iMonth, 0.0, fShadingRatioL, fShadingRatioW2H, cwd->avg_solar_horizontal[iMonth],
-                        cwd->solar_load_ratio[iMonth], cwd->north_latitude, fSA_WAL_N, fSA_WAL_S, fSA_WAL_E, fSA_WAL_W, 0.0);
-
-    iComponent = iWINDOW;
-    fSG_WIN = component_solar_gain(iComponent, iMonth, mdi->key.ratio_of_awning_depth_to_window_height, fShadingRatioAwn,
-                        fShadingRatioPch, cwd->avg_solar_horizontal[iMonth], cwd->solar_load_ratio[iMonth], cwd->north_latitude, fSA_WIN_N, fSA_WIN_S,
-                        fSA_WIN_E, fSA_WIN_W, 0.0);
-
-    iComponent = iDOOR;
-    fSG_DOR = component_solar_gain(iComponent, iMonth, 0.0, fShadingRatioL, fShadingRatioW2H, cwd->avg_solar_horizontal[iMonth],
-                        cwd->solar_load_ratio[iMonth], cwd->north_latitude, fSA_DOR_N, fSA_DOR_S, fSA_DOR_E, fSA_DOR_W, 0.0);
-
-    iComponent = iROOF;
-    fSG_ROF = component_solar_gain(iComponent, iMonth, 0.0, 0.0, 0.0, cwd->avg_solar_horizontal[iMonth], cwd->solar_load_ratio[iMonth], cwd->north_latitude, 0.0,
-                        0.0, 0.0, 0.0, fSA_ROF);
-
+    fSG_WAL = fSG_WAL_Month[zMonth];
+    fSG_WIN = fSG_WIN_Month[zMonth];
+    fSG_DOR = fSG_DOR_Month[zMonth];
+    fSG_ROF = fSG_ROF_Month[zMonth];
     fSolarGainTotal = fSG_WAL + fSG_WIN + fSG_DOR + fSG_ROF;
 
     /**************************************/
@@ -502,7 +582,7 @@ void mhea_energy_use(void) {
       if (mdi->htg.duct_location != DL_NONE || mdi->clg.duct_location == DL_NONE)
         //iretvalue = duct_efficMHEA(Weather, fElevation, fW_Dsgn_T, fS_Dsgn_T, mir->fQduct50, fDuctEffHtg, fDuctEffClg);
         //duct_efficiency_MHEA(Weather, cwd->altitude, cwd->heating_design_temp, fS_Dsgn_T, mir->fQduct50, fDuctEffHtg, fDuctEffClg);
-        duct_efficiency_MHEA(cwd->altitude, cwd->heating_design_temp, cwd->cooling_design_temp, mir->fQduct50, fDuctEffHtg, fDuctEffClg);
+        duct_efficiency_MHEA(cwd->heating_design_temp, cwd->cooling_design_temp, mir->fQduct50, fDuctEffHtg, fDuctEffClg);
 
   /*********************
   Call get_distribution_losses() to compute default duct distribution loss
@@ -512,7 +592,7 @@ void mhea_energy_use(void) {
   get_distribution_losses(fDuctEffHtg, fDuctEffClg, &fDistlossfactor_Htg, &fDistlossfactor_Clg);
 
   /* Since the cooling dist. loss factors have proven unreliable, use the heating
-  * factor also for cooling.  fDuctEffClg is the input to get_cooling_consumption() */
+  * factor also for cooling.  fDuctEffClg is the input to get_cooling_consumption_months() */
 
   *(fDuctEffClg + 0) = *(fDuctEffHtg + 0), *(fDuctEffClg + 1) = *(fDuctEffHtg + 1);
 
@@ -664,21 +744,17 @@ void mhea_energy_use(void) {
     /*  Solar Gains  (Btu/h)  */
     /**************************/
 
-    iComponent = iWALL;
-    fSG_WAL = component_solar_gain(iComponent, iMonth, 0.0, fShadingRatioL, fShadingRatioW2H, cwd->avg_solar_horizontal[iMonth],
+    fSG_WAL = component_solar_gain(iWALL, iMonth, 0.0, fShadingRatioL, fShadingRatioW2H, cwd->avg_solar_horizontal[iMonth],
                         cwd->solar_load_ratio[iMonth], cwd->north_latitude, fSA_WAL_N, fSA_WAL_S, fSA_WAL_E, fSA_WAL_W, 0.0);
 
-    iComponent = iWINDOW;
-    fSG_WIN = component_solar_gain(iComponent, iMonth, mdi->key.ratio_of_awning_depth_to_window_height, fShadingRatioAwn,
+    fSG_WIN = component_solar_gain(iWINDOW, iMonth, mdi->key.ratio_of_awning_depth_to_window_height, fShadingRatioAwn,
                         fShadingRatioPch, cwd->avg_solar_horizontal[iMonth], cwd->solar_load_ratio[iMonth], cwd->north_latitude, fSA_WIN_N, fSA_WIN_S,
                         fSA_WIN_E, fSA_WIN_W, 0.0);
 
-    iComponent = iDOOR;
-    fSG_DOR = component_solar_gain(iComponent, iMonth, 0.0, fShadingRatioL, fShadingRatioW2H, cwd->avg_solar_horizontal[iMonth],
+    fSG_DOR = component_solar_gain(iDOOR, iMonth, 0.0, fShadingRatioL, fShadingRatioW2H, cwd->avg_solar_horizontal[iMonth],
                         cwd->solar_load_ratio[iMonth], cwd->north_latitude, fSA_DOR_N, fSA_DOR_S, fSA_DOR_E, fSA_DOR_W, 0.0);
 
-    iComponent = iROOF;
-    fSG_ROF = component_solar_gain(iComponent, iMonth, 0.0, 0.0, 0.0, cwd->avg_solar_horizontal[iMonth], cwd->solar_load_ratio[iMonth], cwd->north_latitude, 0.0,
+    fSG_ROF = component_solar_gain(iROOF, iMonth, 0.0, 0.0, 0.0, cwd->avg_solar_horizontal[iMonth], cwd->solar_load_ratio[iMonth], cwd->north_latitude, 0.0,
                         0.0, 0.0, 0.0, fSA_ROF);
 
     fSolarGainTotal = fSG_WAL + fSG_WIN + fSG_DOR + fSG_ROF;
@@ -755,24 +831,17 @@ void mhea_energy_use(void) {
     get_hourly_loads(iSeason, mdi->key.length_of_night_thermostat_setback, fConductionHeatLoss, fQILoss, fDegHourDay,
              fDegHourNight, &iflgSetBack, mdi->key.thermostat_setback_amount, &fHourLoadDay, &fHourLoadNight);
 
-    /*************************************************/
-    /*  Energy Consumption for Heating  (Btu/month)  */
-    /*  (Values are passed in English units          */
-    /*    and calculations are in metric units)       */
-    /*************************************************/
-
-    get_heating_consumption(iSeason, iflgSetBack, zMonth, cwd->days_in_month[iMonth], cwd->altitude, cwd->avg_daytime_temp[iMonth], cwd->avg_nighttime_temp[iMonth], fHourLoadDay,
-                   fHourLoadNight, fDistlossfactor_Htg, &fHtgEnerUseDay, &fHtgEnerUseNight);
+    /*********************************************/
+    /*  Keep the month's results for the batched */
+    /*  consumption calls below                  */
+    /*********************************************/
 
-    /*************************************************/
-    /*  Energy Consumption for Cooling  (Btu/month)  */
-    /*  (Values are passed in English units          */
-    /*    and calculations are in metric units)       */
-    /*************************************************/
-
-    get_cooling_consumption(iSeason, iflgSetBack, zMonth, cwd->days_in_month[iMonth], cwd->altitude, fVolumeCathCeiling, fVolumeAddition, fInfMassFlow,
-                   cwd->avg_wet_temp[iMonth], cwd->avg_daytime_temp[iMonth], cwd->avg_nighttime_temp[iMonth], fHourLoadDay, fHourLoadNight, fDuctEffClg, &fClgEnerUseDay,
-                   &fClgEnerUseNight);
+    loads.iSeason[zMonth] = iSeason;
+    loads.iflgSetBack[zMonth] = iflgSetBack;
+    loads.fNightSetpoint[zMonth] = mir->fNightSetpoint;
+    loads.fInfMassFlow[zMonth] = fInfMassFlow;
+    loads.fHourLoadDay[zMonth] = fHourLoadDay;
+    loads.fHourLoadNight[zMonth] = fHourLoadNight;
 
     /**********************
     These numbers are being fixed for intermediate reporting
@@ -783,37 +852,57 @@ void mhea_energy_use(void) {
     if (fDegHourNight < 0.0)
       fDegHourNight = 0.0;
 
+    if (cmds.debug_level & D_MHEA_ENERGY_DETAIL) {
+      sprintf(mir->sMsg, "   Month:  %d      Season:, %d  \n"
+                       " Set Back Flag  =,  %d \n"
+                       " Average Inside Temp Day, Night =,  %4.1f,  %4.1f \n"
+                       " Balance Temperature for Day, Night =, %4.1f, %4.1f \n"
+                       " Degree Hour for Day, Night =,  %8.1f,  %8.1f \n",
+              iMonth, iSeason, iflgSetBack, fTSetDay, fTSetNight, fTBalanceDay, fTBalanceNight, fDegHourDay, fDegHourNight);
+      fprintf(stderr, "%s", mir->sMsg);
+    }
+
+  } // end for "for( imonth" loop
+
+  /*************************************************/
+  /*  Energy Consumption for Heating and Cooling   */
+  /*  (Btu/month), all twelve months at once.      */
+  /*  (Values are passed in English units          */
+  /*    and calculations are in metric units)       */
+  /*************************************************/
+
+  get_heating_consumption_months(&loads, fDistlossfactor_Htg, fHtgEnerUseDay, fHtgEnerUseNight);
+  get_cooling_consumption_months(&loads, fDuctEffClg, fClgEnerUseDay, fClgEnerUseNight);
+
+  for (int zMonth = 0; zMonth <= 11; zMonth++) {    // BASE ZERO MONTH <<<<=====
+    int iMonth = zMonth + 1;    // BASE ONE
+
+    // Negative loads are zeroed for reporting, as above
+    fHourLoadDay = loads.fHourLoadDay[zMonth];
+    fHourLoadNight = loads.fHourLoadNight[zMonth];
     if (fHourLoadDay < 0.0)
       fHourLoadDay = 0.0;
     if (fHourLoadNight < 0.0)
       fHourLoadNight = 0.0;
 
-    sprintf(mir->sMsg, "   Month:  %d      Season:, %d  \n"
-                     " Set Back Flag  =,  %d \n"
-                     " Average Inside Temp Day, Night =,  %4.1f,  %4.1f \n"
-                     " Balance Temperature for Day, Night =, %4.1f, %4.1f \n"
-                     " Degree Hour for Day, Night =,  %8.1f,  %8.1f \n",
-            iMonth, iSeason, iflgSetBack, fTSetDay, fTSetNight, fTBalanceDay, fTBalanceNight, fDegHourDay, fDegHourNight);
-
-    if (cmds.debug_level & D_MHEA_ENERGY_DETAIL)
-      fprintf(stderr, "%s", mir->sMsg);
-
-    sprintf(mir->sMsg, "Hourly Load for Day, Night(kBtu) =,  %8.1f,  %8.1f \n"
-                     " Htg Energy Use Day, Night(kBtu) =,  %8.1f,  %8.1f \n"
-                     " Clg Energy Use Day, Night(kBtu) =,  %8.1f,  %8.1f \n\n",
-            fHourLoadDay/1000, fHourLoadNight/1000, fHtgEnerUseDay/1000, fHtgEnerUseNight/1000, fClgEnerUseDay/1000, fClgEnerUseNight/1000);
-
-    if (cmds.debug_level & D_MHEA_ENERGY_DETAIL)
+    if (cmds.debug_level & D_MHEA_ENERGY_DETAIL) {
+      sprintf(mir->sMsg, "   Month:  %d \n"
+                       "Hourly Load for Day, Night(kBtu) =,  %8.1f,  %8.1f \n"
+                       " Htg Energy Use Day, Night(kBtu) =,  %8.1f,  %8.1f \n"
+                       " Clg Energy Use Day, Night(kBtu) =,  %8.1f,  %8.1f \n\n",
+              iMonth, fHourLoadDay/1000, fHourLoadNight/1000, fHtgEnerUseDay[zMonth]/1000, fHtgEnerUseNight[zMonth]/1000,
+              fClgEnerUseDay[zMonth]/1000, fClgEnerUseNight[zMonth]/1000);
       fprintf(stderr, "%s", mir->sMsg);
+    }
 
-    if (iSeason == HEATING)
+    if (loads.iSeason[zMonth] == HEATING)
       fTotalLoadHtg += (float)((fHourLoadDay * 12.0 * cwd->days_in_month[iMonth]) + (fHourLoadNight * 12.0 * cwd->days_in_month[iMonth]));
-    if (iSeason == COOLING)
+    if (loads.iSeason[zMonth] == COOLING)
       fTotalLoadClg += (float)((fHourLoadDay * 12.0 * cwd->days_in_month[iMonth]) + (fHourLoadNight * 12.0 * cwd->days_in_month[iMonth]));
 
     // increment
-    mir->fHeating_Energy += fHtgEnerUseDay + fHtgEnerUseNight;
-    mir->fCooling_Energy += fClgEnerUseDay + fClgEnerUseNight;
+    mir->fHeating_Energy += fHtgEnerUseDay[zMonth] + fHtgEnerUseNight[zMonth];
+    mir->fCooling_Energy += fClgEnerUseDay[zMonth] + fClgEnerUseNight[zMonth];
 
     // The monthly heating and cooling energy use values are
     // only used for billing comparison, so we only want to fill
@@ -821,8 +910,8 @@ void mhea_energy_use(void) {
 
     if (mir->flgWhichPass == BASE_CASE) {
 
-      mir->fMonthlyHtgUse[zMonth] = fHtgEnerUseDay + fHtgEnerUseNight;
-      mir->fMonthlyClgUse[zMonth] = fClgEnerUseDay + fClgEnerUseNight;
+      mir->fMonthlyHtgUse[zMonth] = fHtgEnerUseDay[zMonth] + fHtgEnerUseNight[zMonth];
+      mir->fMonthlyClgUse[zMonth] = fClgEnerUseDay[zMonth] + fClgEnerUseNight[zMonth];
 
       if (cmds.debug_level & D_MHEA_ENERGY_DETAIL) {
         sprintf(mir->sMsg, " Monthly Heating Use[%d](kBtu) =,  %8.1f \n"
@@ -831,8 +920,7 @@ void mhea_energy_use(void) {
         fprintf(stderr, "%s", mir->sMsg);
       }
     }
-
-  } // end for "for( imonth" loop
+  }
 
   if (cmds.debug_level & D_MHEA_ENERGY_DETAIL) {
     sprintf(mir->sMsg, " Annual Heating Load(kBtu) =,  %8.1f \n"
@@ -991,3 +1079,467 @@ static void get_distribution_losses(float *fDuctEffHtg, float *fDuctEffClg, floa
   //        printf("\nfDistlossfactor_old = %6.4f\nfDistlossfactor = %6.4f\n",
   //                  fDistlossfactor_old, fDistlossfactor);
 }
+
+/***************************************************************************
+ Component UA cache
+
+ mhea_energy_use() is called for every measure evaluation, but a measure
+ usually changes one envelope component group and leaves the others as they
+ are in the base house or in the package built so far.  Each ua_*() call
+ below keeps copies of exactly what it read on its last few computed calls:
+ the mdi sections, the retrofit flags it tests, the pass, and the mir fields
+ it reads or writes.  When the inputs match one of those calls its results,
+ and the mir fields as that call left them, are restored instead of
+ recomputing.  ua_floor() and ua_wall() also keep function static values set
+ on a BASE_CASE call, so a recomputed BASE_CASE call empties its group.
+
+ The cache is bypassed for D_MHEA_ENERGY_DETAIL so the detailed dumps from
+ the ua_*() routines are complete.
+**************************************************************************/
+
+#define UA_CACHE_BYTES 8192 // room for the largest set of inputs, ua_wall() with a full list of windows and doors
+#define UA_CACHE_ENTRIES 4  // computed calls remembered per component group
+#define UA_MAX_RESULTS 13
+#define UA_MAX_STATE 16
+
+enum UA_GROUP { UA_FLOOR, UA_WALL, UA_WINDOW, UA_DOOR, UA_ROOF, UA_GROUPS };
+
+typedef struct {
+  int size;
+  unsigned char bytes[UA_CACHE_BYTES];
+} UA_INPUTS;
+
+typedef struct {
+  int valid;
+  UA_INPUTS inputs;               // inputs of a computed call
+  float results[UA_MAX_RESULTS];  // values it returned
+  float state[UA_MAX_STATE];      // its mir fields as it left them
+} UA_ENTRY;
+
+typedef struct {
+  int next;                       // entry to replace on the next store
+  UA_ENTRY entry[UA_CACHE_ENTRIES];
+} UA_CACHE;
+
+static UA_CACHE ua_cache[UA_GROUPS];
+
+#define NUM_ITEMS(a) ((int)(sizeof(a) / sizeof((a)[0])))
+
+static void ua_input(UA_INPUTS *in, const void *data, size_t size) {
+  ASSERT(in->size + size <= UA_CACHE_BYTES, sprintf(msg, "UA cache inputs exceed %d bytes", UA_CACHE_BYTES));
+  memcpy(in->bytes + in->size, data, size);
+  in->size += (int)size;
+}
+
+static void ua_input_flags(UA_INPUTS *in, const int *flags, int n) {
+  for (int i = 0; i < n; i++)
+    ua_input(in, &mir->flgRetrofits[flags[i]], sizeof(int));
+}
+
+static void ua_input_state(UA_INPUTS *in, float **state, int n) {
+  for (int i = 0; i < n; i++)
+    ua_input(in, state[i], sizeof(float));
+}
+
+// The physical description of each window and door, window_type through the
+// counts facing each way.  Costs, leakage and measure bookkeeping that the
+// retrofits change are not read by the ua_*() routines.
+#define WIN_UA_FIELDS(w) &(w).window_type, offsetof(M_WIN, retrofit_option) - offsetof(M_WIN, window_type)
+#define DOR_UA_FIELDS(d) &(d).door_type, offsetof(M_DOR, replace) - offsetof(M_DOR, door_type)
+
+static void ua_input_openings(UA_INPUTS *in) {
+  ua_input(in, &mdi->num_win, sizeof(mdi->num_win));
+  ua_input(in, &mdi->num_awn, sizeof(mdi->num_awn));
+  ua_input(in, &mdi->num_dor, sizeof(mdi->num_dor));
+  ua_input(in, &mdi->num_adr, sizeof(mdi->num_adr));
+  for (int i = 0; i < mdi->num_win; i++)
+    ua_input(in, WIN_UA_FIELDS(mdi->win[i]));
+  for (int i = 0; i < mdi->num_awn; i++)
+    ua_input(in, WIN_UA_FIELDS(mdi->awn[i]));
+  for (int i = 0; i < mdi->num_dor; i++)
+    ua_input(in, DOR_UA_FIELDS(mdi->dor[i]));
+  for (int i = 0; i < mdi->num_adr; i++)
+    ua_input(in, DOR_UA_FIELDS(mdi->adr[i]));
+}
+
+// Restore the results of a computed call with the same inputs, if there is one
+static int ua_cache_hit(UA_CACHE *cache, UA_INPUTS *in, float **results, int nresults, float **state, int nstate) {
+  if (cmds.debug_level & D_MHEA_ENERGY_DETAIL)
+    return FALSE;
+  for (int e = 0; e < UA_CACHE_ENTRIES; e++) {
+    UA_ENTRY *entry = &cache->entry[e];
+    if (!entry->valid || entry->inputs.size != in->size || memcmp(entry->inputs.bytes, in->bytes, in->size) != 0)
+      continue;
+    for (int i = 0; i < nresults; i++)
+      *results[i] = entry->results[i];
+    for (int i = 0; i < nstate; i++)
+      *state[i] = entry->state[i];
+    return TRUE;
+  }
+  return FALSE;
+}
+
+static void ua_cache_store(UA_CACHE *cache, UA_INPUTS *in, float **results, int nresults, float **state, int nstate) {
+  UA_ENTRY *entry;
+
+  ASSERT(nresults <= UA_MAX_RESULTS && nstate <= UA_MAX_STATE, sprintf(msg, "UA cache result or state list too long"));
+  if (mir->flgWhichPass == BASE_CASE) {
+    for (int e = 0; e < UA_CACHE_ENTRIES; e++)
+      cache->entry[e].valid = FALSE;
+  }
+  entry = &cache->entry[cache->next];
+  cache->next = (cache->next + 1) % UA_CACHE_ENTRIES;
+
+  memcpy(entry->inputs.bytes, in->bytes, in->size);
+  entry->inputs.size = in->size;
+  for (int i = 0; i < nresults; i++)
+    entry->results[i] = *results[i];
+  for (int i = 0; i < nstate; i++)
+    entry->state[i] = *state[i];
+  entry->valid = TRUE;
+}
+
+static void cached_ua_floor(float *fUA_FLR_S, float *fUA_FLR_W) {
+  static UA_INPUTS in;
+  static const int flags[] = {M_CMS_BELLY_CELLULOSE_LOOSE_INSL, M_CMS_BELLY_CELLULOSE_LOOSE_INSL_ADD,
+                              M_CMS_BELLY_FIBERGLASS_LOOSE_INSL, M_CMS_BELLY_FIBERGLASS_LOOSE_INSL_ADD};
+  float *results[] = {fUA_FLR_S, fUA_FLR_W};
+  float *state[] = {&mir->fBellyAirSpace, &mir->fWngAirSpace, &mir->fJoistAirSpace, &mir->fBellyInsDepth,
+                    &mir->fWingInsDepth, &mir->fAFloorInsDepth, &mir->fRinBellyCelInsul, &mir->fRinBellyLFGInsul,
+                    &mir->fRinFGCompressed, &mir->fRinCompCelInsul, &mir->fRinCompBatInsul, &mir->fRinExistCelInsul,
+                    &mir->fDensExistBatInsul};
+
+  in.size = 0;
+  ua_input(&in, &mir->flgWhichPass, sizeof(mir->flgWhichPass));
+  ua_input_flags(&in, flags, NUM_ITEMS(flags));
+  ua_input_state(&in, state, NUM_ITEMS(state));
+  ua_input(&in, &mdi->key, sizeof(mdi->key));
+  ua_input(&in, &mdi->gnl, sizeof(mdi->gnl));
+  ua_input(&in, &mdi->flr, sizeof(mdi->flr));
+  ua_input(&in, &mdi->afl, sizeof(mdi->afl));
+  if (ua_cache_hit(&ua_cache[UA_FLOOR], &in, results, NUM_ITEMS(results), state, NUM_ITEMS(state)))
+    return;
+
+  ua_floor(fUA_FLR_S, fUA_FLR_W);
+  ua_cache_store(&ua_cache[UA_FLOOR], &in, results, NUM_ITEMS(results), state, NUM_ITEMS(state));
+}
+
+static void cached_ua_wall(float *fVolumeAddition, float *fUA_WAL_S, float *fUA_WAL_W, float *fSA_WAL_S_N, float *fSA_WAL_S_S,
+                           float *fSA_WAL_S_E, float *fSA_WAL_S_W, float *fSA_WAL_W_N, float *fSA_WAL_W_S, float *fSA_WAL_W_E,
+                           float *fSA_WAL_W_W, float *fShadingRatioL, float *fShadingRatioW2H) {
+  static UA_INPUTS in;
+  static const int flags[] = {M_CMS_WALL_CELLULOSE_LOOSE_INSL, M_CMS_WALL_CELLULOSE_LOOSE_INSL_ADD,
+                              M_CMS_WALL_FIBERGLASS_BATT_INSL, M_CMS_WALL_FIBERGLASS_BATT_INSL_ADD,
+                              M_CMS_WALL_FIBERGLASS_LOOSE_INSL, M_CMS_WALL_FIBERGLASS_LOOSE_INSL_ADD};
+  float *results[] = {fVolumeAddition, fUA_WAL_S, fUA_WAL_W, fSA_WAL_S_N, fSA_WAL_S_S, fSA_WAL_S_E, fSA_WAL_S_W,
+                      fSA_WAL_W_N, fSA_WAL_W_S, fSA_WAL_W_E, fSA_WAL_W_W, fShadingRatioL, fShadingRatioW2H};
+  float *state[] = {&mir->fWalInsAirSpace, &mir->fAWLInsAirSpace, &mir->fNetWalArea, &mir->fNetAWLArea,
+                    &mir->fWallInsDepth, &mir->fAWallInsDepth, &mir->fFractWallUnins, &mir->fRinFGCompressed,
+                    &mir->fRinCompCelInsul, &mir->fRinCompBatInsul, &mir->fDensExistBatInsul};
+
+  in.size = 0;
+  ua_input(&in, &mir->flgWhichPass, sizeof(mir->flgWhichPass));
+  ua_input_flags(&in, flags, NUM_ITEMS(flags));
+  ua_input_state(&in, state, NUM_ITEMS(state));
+  ua_input(&in, &mdi->key, sizeof(mdi->key));
+  ua_input(&in, &mdi->gnl, sizeof(mdi->gnl));
+  ua_input(&in, &mdi->wal, sizeof(mdi->wal));
+  ua_input(&in, &mdi->awl, sizeof(mdi->awl));
+  ua_input(&in, &mdi->rof, sizeof(mdi->rof));
+  ua_input(&in, &mdi->afl, sizeof(mdi->afl));
+  ua_input_openings(&in);
+  if (ua_cache_hit(&ua_cache[UA_WALL], &in, results, NUM_ITEMS(results), state, NUM_ITEMS(state)))
+    return;
+
+  ua_wall(fVolumeAddition, fUA_WAL_S, fUA_WAL_W, fSA_WAL_S_N, fSA_WAL_S_S, fSA_WAL_S_E, fSA_WAL_S_W, fSA_WAL_W_N, fSA_WAL_W_S,
+          fSA_WAL_W_E, fSA_WAL_W_W, fShadingRatioL, fShadingRatioW2H);
+  ua_cache_store(&ua_cache[UA_WALL], &in, results, NUM_ITEMS(results), state, NUM_ITEMS(state));
+}
+
+static void cached_ua_window(float *fUA_WIN_S, float *fUA_WIN_W, float *fSA_WIN_S_N, float *fSA_WIN_S_S, float *fSA_WIN_S_E,
+                             float *fSA_WIN_S_W, float *fSA_WIN_W_N, float *fSA_WIN_W_S, float *fSA_WIN_W_E, float *fSA_WIN_W_W,
+                             float *fShadingRatioAwn, float *fShadingRatioPch) {
+  static UA_INPUTS in;
+  static const int flags[] = {M_CMS_ADD_SHADE_SCREENS, M_CMS_ADD_SHADE_SCREENS_ADD};
+  float *results[] = {fUA_WIN_S, fUA_WIN_W, fSA_WIN_S_N, fSA_WIN_S_S, fSA_WIN_S_E, fSA_WIN_S_W,
+                      fSA_WIN_W_N, fSA_WIN_W_S, fSA_WIN_W_E, fSA_WIN_W_W, fShadingRatioAwn, fShadingRatioPch};
+
+  in.size = 0;
+  ua_input_flags(&in, flags, NUM_ITEMS(flags));
+  ua_input(&in, &mdi->key, sizeof(mdi->key));
+  ua_input_openings(&in);
+  if (ua_cache_hit(&ua_cache[UA_WINDOW], &in, results, NUM_ITEMS(results), NULL, 0))
+    return;
+
+  ua_window(fUA_WIN_S, fUA_WIN_W, fSA_WIN_S_N, fSA_WIN_S_S, fSA_WIN_S_E, fSA_WIN_S_W, fSA_WIN_W_N, fSA_WIN_W_S, fSA_WIN_W_E,
+            fSA_WIN_W_W, fShadingRatioAwn, fShadingRatioPch);
+  ua_cache_store(&ua_cache[UA_WINDOW], &in, results, NUM_ITEMS(results), NULL, 0);
+}
+
+static void cached_ua_door(float *fUA_DOR_S, float *fUA_DOR_W, float *fSA_DOR_S_N, float *fSA_DOR_S_S, float *fSA_DOR_S_E,
+                           float *fSA_DOR_S_W, float *fSA_DOR_W_N, float *fSA_DOR_W_S, float *fSA_DOR_W_E, float *fSA_DOR_W_W) {
+  static UA_INPUTS in;
+  float *results[] = {fUA_DOR_S, fUA_DOR_W, fSA_DOR_S_N, fSA_DOR_S_S, fSA_DOR_S_E,
+                      fSA_DOR_S_W, fSA_DOR_W_N, fSA_DOR_W_S, fSA_DOR_W_E, fSA_DOR_W_W};
+
+  in.size = 0;
+  ua_input(&in, &mdi->key, sizeof(mdi->key));
+  ua_input_openings(&in);
+  if (ua_cache_hit(&ua_cache[UA_DOOR], &in, results, NUM_ITEMS(results), NULL, 0))
+    return;
+
+  ua_door(fUA_DOR_S, fUA_DOR_W, fSA_DOR_S_N, fSA_DOR_S_S, fSA_DOR_S_E, fSA_DOR_S_W, fSA_DOR_W_N, fSA_DOR_W_S, fSA_DOR_W_E,
+          fSA_DOR_W_W);
+  ua_cache_store(&ua_cache[UA_DOOR], &in, results, NUM_ITEMS(results), NULL, 0);
+}
+
+static void cached_ua_roof(float fHeatCapacity, float *fVolumeCathCeiling, float *fUA_ROF_S, float *fUA_ROF_W, float *fSA_ROF_S,
+                           float *fSA_ROF_W) {
+  static UA_INPUTS in;
+  static const int flags[] = {M_CMS_ROOF_CELLULOSE_LOOSE_INSL, M_CMS_ROOF_CELLULOSE_LOOSE_INSL_ADD,
+                              M_CMS_ROOF_FIBERGLASS_LOOSE_INSL, M_CMS_ROOF_FIBERGLASS_LOOSE_INSL_ADD};
+  float *results[] = {fVolumeCathCeiling, fUA_ROF_S, fUA_ROF_W, fSA_ROF_S, fSA_ROF_W};
+  float *state[] = {&mir->fRofInsAirSpace, &mir->fARFInsAirSpace, &mir->fAreaCeilingTotal, &mir->fThicknessCeilIns,
+                    &mir->fThicknessCeilIns_Add, &mir->fRofThicknessBattIns, &mir->fRofThicknessLFGIns,
+                    &mir->fRofThicknessBattIns_Add, &mir->fRofThicknessLFGIns_Add, &mir->fRinFGCompressed,
+                    &mir->fRinCompCelInsul, &mir->fRinCompBatInsul, &mir->fRinExistCelInsul, &mir->fDensExistBatInsul};
+
+  in.size = 0;
+  ua_input(&in, &fHeatCapacity, sizeof(fHeatCapacity));
+  ua_input(&in, &mir->flgWhichPass, sizeof(mir->flgWhichPass));
+  ua_input_flags(&in, flags, NUM_ITEMS(flags));
+  ua_input_state(&in, state, NUM_ITEMS(state));
+  ua_input(&in, &mdi->key, sizeof(mdi->key));
+  ua_input(&in, &mdi->gnl, sizeof(mdi->gnl));
+  ua_input(&in, &mdi->rof, sizeof(mdi->rof));
+  ua_input(&in, &mdi->arf, sizeof(mdi->arf));
+  ua_input(&in, &mdi->awl, sizeof(mdi->awl));
+  ua_input(&in, &mdi->afl, sizeof(mdi->afl));
+  ua_input_openings(&in);
+  if (ua_cache_hit(&ua_cache[UA_ROOF], &in, results, NUM_ITEMS(results), state, NUM_ITEMS(state)))
+    return;
+
+  ua_roof(fHeatCapacity, fVolumeCathCeiling, fUA_ROF_S, fUA_ROF_W, fSA_ROF_S, fSA_ROF_W);
+  ua_cache_store(&ua_cache[UA_ROOF], &in, results, NUM_ITEMS(results), state, NUM_ITEMS(state));
+}
+
+/***************************************************************************
+ Solar gains carried forward
+
+ A component's twelve monthly solar gains depend only on its averaged solar
+ apertures, its shading ratios, the wind shielding and the weather station.
+ Most measures leave every one of those alone, so between the cumulative
+ pass evaluations of a package only the components the newly added measure
+ changed are recomputed; the rest reuse the year computed for the previous
+ package.  Gains are kept in the UA cache entries, one cache per component.
+**************************************************************************/
+static void cached_solar_gains(int iComponent, float fShadingRatioAwn, float fShadingRatioL, float fShadingRatioW2H, float fSA_N,
+                               float fSA_S, float fSA_E, float fSA_W, float fSA_ROF, float fSG[MONTHS]) {
+  static UA_CACHE sg_cache[COMPONENTS];
+  static UA_INPUTS in;
+  float aperture[] = {fShadingRatioAwn, fShadingRatioL, fShadingRatioW2H, fSA_N, fSA_S, fSA_E, fSA_W, fSA_ROF};
+  float *results[MONTHS];
+
+  for (int zMonth = 0; zMonth < MONTHS; zMonth++)
+    results[zMonth] = &fSG[zMonth];
+
+  in.size = 0;
+  ua_input(&in, aperture, sizeof(aperture));
+  ua_input(&in, &mdi->gnl.wind_shielding, sizeof(mdi->gnl.wind_shielding));
+  ua_input(&in, &cwd->north_latitude, sizeof(cwd->north_latitude));
+  ua_input(&in, cwd->avg_solar_horizontal, sizeof(cwd->avg_solar_horizontal));
+  ua_input(&in, cwd->solar_load_ratio, sizeof(cwd->solar_load_ratio));
+  if (ua_cache_hit(&sg_cache[iComponent], &in, results, MONTHS, NULL, 0))
+    return;
+
+  for (int iMonth = 1; iMonth <= MONTHS; iMonth++)
+    fSG[iMonth - 1] = component_solar_gain(iComponent, iMonth, fShadingRatioAwn, fShadingRatioL, fShadingRatioW2H,
+                                           cwd->avg_solar_horizontal[iMonth], cwd->solar_load_ratio[iMonth], cwd->north_latitude,
+                                           fSA_N, fSA_S, fSA_E, fSA_W, fSA_ROF);
+  ua_cache_store(&sg_cache[iComponent], &in, results, MONTHS, NULL, 0);
+}
+
+/***************************************************************************
+ Energy use memo
+
+ The same house is often evaluated more than once: measures that leave the
+ package unchanged, the cumulative pass retesting first pass packages, and
+ the billing adjustment rerun repeating the unadjusted passes call for call.
+ Each computed call is keyed with hash_bytes() over everything the energy
+ calculation reads that can change within a run: the retrofit flags, the
+ mdi sections it uses, and the mir values set by the measures or left by
+ earlier calls.  A later call with the same key restores the mir values the
+ computed call left instead of recomputing.
+
+ The pass is not part of the key.  Past the base case it only decides which
+ high load flags get set, so an entry keeps the months the equipment missed
+ the load and a hit sets the flags for the pass it is made in.  A window
+ measure's cumulative pass evaluation can then reuse its leakage-only call
+ or the first pass result of the same house.
+
+ BASE_CASE calls are always computed.  They set the month seasons and the
+ function static values in ua_floor(), ua_wall() and
+ mhea_infiltration_losses() that the later calls read, and they start a new
+ house and weather file, so they also empty the memo.  The billing
+ adjustment factors are not part of the key since the callers apply them to
+ the unadjusted results restored here.  The memo is bypassed for
+ D_MHEA_ENERGY_DETAIL so the detailed dumps are complete.
+**************************************************************************/
+
+#define ENERGY_MEMO_ENTRIES 256 // computed calls remembered between BASE_CASE calls
+#define ENERGY_MEMO_STATE 29
+
+typedef struct {
+  int valid;
+  unsigned long long key;           // hash of every input to the computed call
+  float fHeating_Energy;
+  float fCooling_Energy;
+  float fNightSetpoint;
+  float fCfm;
+  SIZING Htg_Sizing;                // POST_RETROFIT sizing, BASE_CASE calls are not remembered
+  int iHighLoadMonths[2];           // see mhea_high_load()
+  float state[ENERGY_MEMO_STATE];   // ua_*() working values as the call left them
+} ENERGY_MEMO;
+
+static ENERGY_MEMO energy_memo[ENERGY_MEMO_ENTRIES];
+static int energy_memo_next;   // entry to replace on the next store
+static int energy_memo_hits;
+static int energy_memo_misses;
+
+#define HASH_VALUE(h, v) hash_bytes((h), &(v), sizeof(v))
+
+static void energy_memo_clear(void) {
+  memset(energy_memo, 0, sizeof(energy_memo));
+  energy_memo_next = 0;
+  energy_memo_hits = energy_memo_misses = 0;
+}
+
+// The mir working values the ua_*() routines both read and write
+static int energy_memo_state(float **state) {
+  float *list[] = {&mir->fBellyAirSpace, &mir->fWngAirSpace, &mir->fJoistAirSpace, &mir->fBellyInsDepth,
+                   &mir->fWingInsDepth, &mir->fAFloorInsDepth, &mir->fRinBellyCelInsul, &mir->fRinBellyLFGInsul,
+                   &mir->fRinFGCompressed, &mir->fRinCompCelInsul, &mir->fRinCompBatInsul, &mir->fRinExistCelInsul,
+                   &mir->fDensExistBatInsul, &mir->fWalInsAirSpace, &mir->fAWLInsAirSpace, &mir->fNetWalArea,
+                   &mir->fNetAWLArea, &mir->fWallInsDepth, &mir->fAWallInsDepth, &mir->fFractWallUnins,
+                   &mir->fRofInsAirSpace, &mir->fARFInsAirSpace, &mir->fAreaCeilingTotal, &mir->fThicknessCeilIns,
+                   &mir->fThicknessCeilIns_Add, &mir->fRofThicknessBattIns, &mir->fRofThicknessLFGIns,
+                   &mir->fRofThicknessBattIns_Add, &mir->fRofThicknessLFGIns_Add};
+
+  ASSERT(NUM_ITEMS(list) == ENERGY_MEMO_STATE, sprintf(msg, "Energy memo state list has %d entries", NUM_ITEMS(list)));
+  memcpy(state, list, sizeof(list));
+  return NUM_ITEMS(list);
+}
+
+static unsigned long long energy_memo_key(void) {
+  unsigned long long key = HASH_SEED;
+  float *state[ENERGY_MEMO_STATE];
+  int n = energy_memo_state(state);
+
+  key = HASH_VALUE(key, mir->flgRetrofits);
+  for (int i = 0; i < n; i++)
+    key = hash_bytes(key, state[i], sizeof(float));
+
+  // set by the measures and the pre-calculations
+  key = HASH_VALUE(key, mir->fCfmUser);
+  key = HASH_VALUE(key, mir->fCfm_house);
+  key = HASH_VALUE(key, mir->fPa_house);
+  key = HASH_VALUE(key, mir->fPa_duct_op);
+  key = HASH_VALUE(key, mir->fQduct50);
+  key = HASH_VALUE(key, mir->window_cfm_adjustment);
+  key = HASH_VALUE(key, mir->flgNoCLG);
+
+  key = HASH_VALUE(key, mdi->gnl);
+  key = HASH_VALUE(key, mdi->wal);
+  key = HASH_VALUE(key, mdi->awl);
+  key = HASH_VALUE(key, mdi->rof);
+  key = HASH_VALUE(key, mdi->arf);
+  key = HASH_VALUE(key, mdi->flr);
+  key = HASH_VALUE(key, mdi->afl);
+  key = HASH_VALUE(key, mdi->htg);
+  key = HASH_VALUE(key, mdi->ht2);
+  key = HASH_VALUE(key, mdi->clg);
+  key = HASH_VALUE(key, mdi->cl2);
+  key = HASH_VALUE(key, mdi->inf);
+  key = HASH_VALUE(key, mdi->key);
+  key = HASH_VALUE(key, mdi->num_win);
+  key = HASH_VALUE(key, mdi->num_awn);
+  key = HASH_VALUE(key, mdi->num_dor);
+  key = HASH_VALUE(key, mdi->num_adr);
+  for (int i = 0; i < mdi->num_win; i++)
+    key = HASH_VALUE(hash_bytes(key, WIN_UA_FIELDS(mdi->win[i])), mdi->win[i].leak_coef);
+  for (int i = 0; i < mdi->num_awn; i++)
+    key = HASH_VALUE(hash_bytes(key, WIN_UA_FIELDS(mdi->awn[i])), mdi->awn[i].leak_coef);
+  for (int i = 0; i < mdi->num_dor; i++)
+    key = HASH_VALUE(hash_bytes(key, DOR_UA_FIELDS(mdi->dor[i])), mdi->dor[i].leak_coef);
+  for (int i = 0; i < mdi->num_adr; i++)
+    key = HASH_VALUE(hash_bytes(key, DOR_UA_FIELDS(mdi->adr[i])), mdi->adr[i].leak_coef);
+  return key;
+}
+
+// Restore the results of a computed call with the same key, if there is one
+static int energy_memo_hit(unsigned long long key) {
+  float *state[ENERGY_MEMO_STATE];
+  int n;
+
+  for (int e = 0; e < ENERGY_MEMO_ENTRIES; e++) {
+    ENERGY_MEMO *memo = &energy_memo[e];
+    if (!memo->valid || memo->key != key)
+      continue;
+
+    mir->fHeating_Energy = memo->fHeating_Energy;
+    mir->fCooling_Energy = memo->fCooling_Energy;
+    mir->fNightSetpoint = memo->fNightSetpoint;
+    mir->fCfm = memo->fCfm;
+    mir->Htg_Sizing[POST_RETROFIT] = memo->Htg_Sizing;
+    for (int zMonth = 0; zMonth < MONTHS; zMonth++) {
+      if (memo->iHighLoadMonths[0] & (1 << zMonth))
+        set_high_load(HEATING, zMonth);
+      if (memo->iHighLoadMonths[1] & (1 << zMonth))
+        set_high_load(COOLING, zMonth);
+    }
+    n = energy_memo_state(state);
+    for (int i = 0; i < n; i++)
+      *state[i] = memo->state[i];
+
+    // the month seasons a computed call would have copied from the base case
+    for (int zMonth = 0; zMonth < 12; zMonth++)
+      iMonthSeason[zMonth] = (mir->iSeason[zMonth] == HEATING) ? HEATING : COOLING;
+
+    energy_memo_hits++;
+    return TRUE;
+  }
+  energy_memo_misses++;
+  return FALSE;
+}
+
+static void energy_memo_store(unsigned long long key) {
+  ENERGY_MEMO *memo = &energy_memo[energy_memo_next];
+  float *state[ENERGY_MEMO_STATE];
+  int n = energy_memo_state(state);
+
+  energy_memo_next = (energy_memo_next + 1) % ENERGY_MEMO_ENTRIES;
+
+  memo->key = key;
+  memo->fHeating_Energy = mir->fHeating_Energy;
+  memo->fCooling_Energy = mir->fCooling_Energy;
+  memo->fNightSetpoint = mir->fNightSetpoint;
+  memo->fCfm = mir->fCfm;
+  memo->Htg_Sizing = mir->Htg_Sizing[POST_RETROFIT];
+  memo->iHighLoadMonths[0] = iHighLoadMonths[0];
+  memo->iHighLoadMonths[1] = iHighLoadMonths[1];
+  for (int i = 0; i < n; i++)
+    memo->state[i] = *state[i];
+  memo->valid = TRUE;
+}
+
+/***************************************************************************
+** Function Name: energy_memo_report
+**
+**  DESCRIPTION: Debug output of the mhea_energy_use() memo hits and misses
+**               since the last BASE_CASE call
+**************************************************************************/
+void energy_memo_report(void) {
+  if (cmds.debug_level & D_MHEA_ENERGY_MEMO)
+    fprintf(stderr, "\n\nEnergy use memo: %d hits, %d misses of %d calls", energy_memo_hits, energy_memo_misses,
+            mor->energy_calc_counter);
+}
@@ -10,5 +10,6 @@
 
 void get_base_load(void);
 void mhea_energy_use(void);
+void energy_memo_report(void);
 
 #endif
@@ -34,6 +34,7 @@ typedef struct {
 
   char sName[MEASURENAME_LEN + 1];      // retrofit measure name
   char sComponents[STRING_LEN];         // list of component codes effected
+  COMPONENT_SET component_set;          // interned codes of the same components
   
   int measure_id;        // the fixed measure index number from measure_active_flags
   int audit_section_id;  // what section of the audit is this related to #164
@@ -139,6 +140,7 @@ typedef struct {
     char sFileName[M_FILENAME_LEN];   // global string for file names
     char sMsg[300];                   // global messages for output
     char sComponents[STRING_LEN];     // global for passing component strings
+    COMPONENT_SET component_set;      // interned codes matching sComponents
 
     int AutoOverwrite;       /* See setup screen */
     int flgChangeToData ; /* back in the runing MJF 5/97  */
@@ -205,6 +207,15 @@ typedef struct {
     float fDensBellyLFGInsul; // Density of retrofitted loose FG insulation in belly
     float fDensBellyCelInsul;  // Density of retrofitted cellulose insulation in belly
 
+    // set by the belly measures in the first pass, reused in the cumulative pass
+    float fCelDensExistCntr;      // Density of existing insulation in belly center, cellulose measure
+    float fCelDensExistWing;      // Density of existing insulation in wings, cellulose measure
+    float fCelDensExistAFlr;      // Density of existing insulation in addition floor, cellulose measure
+    float fLFGDensExistCntr;      // Density of existing insulation in belly center, loose FG measure
+    float fLFGDensExistWing;      // Density of existing insulation in wings, loose FG measure
+    float fLFGCompExistLooseIns;  // Compressed depth of existing loose insulation, loose FG measure
+    float fLFGDensExistAFlr;      // Density of existing insulation in addition floor, loose FG measure
+
     float fAFloorInsDepth; // Existing insulation depth in addition floor
     float fARoofInsDepth;  // Existing insulation depth in addition roof
     float fAWallInsDepth;  // Existing insulation depth in addition walls
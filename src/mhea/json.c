@@ -14,11 +14,11 @@
 #include "wa_engine.h"
 
 /// Reads the fuel escalation rates from the sys/fuel_escalation JSON files.  Read the fuel escalation data from
-/// the external file given the 'rer' (referenced escalation rate) information in the passed MDI structure.  It
-/// uses the year and region to form a filename following a naming convention, then cJSON to read that escalation
-/// factor information into the MDI 'fer' structure for later use in the engine.
+/// the external file given the 'rer' (referenced escalation rate) information.  It uses the year and region
+/// (looked up from the state, or the weather state if neither is given) to form a filename following a naming
+/// convention, then cJSON to read that escalation factor information into 'fer' for later use in the engine.
 
-static void get_referenced_escalation_rates(MDI *top, cJSON *jschema) {
+static void get_referenced_escalation_rates(RER *rer, const char *weather_state, FER *fer, int *num_fer, cJSON *jschema) {
   cJSON *jleaf = NULL;
   cJSON *jleaf2 = NULL;
   cJSON *jbranch = NULL;
@@ -31,32 +31,32 @@ static void get_referenced_escalation_rates(MDI *top, cJSON *jschema) {
   char *region_states[REGIONS];
   char match_state[10]; // space for vertical bars
 
-  // look up the region from the top->rer.state if not given the region directly, MJF 1/2019
+  // look up the region from the rer->state if not given the region directly, MJF 1/2019
 
-  if (top->rer.region == 0) {
-    if (top->rer.state[0] == '\0' && top->wth.state[0] != '\0')
-      STRCPY(top->rer.state, top->wth.state);
+  if (rer->region == 0) {
+    if (rer->state[0] == '\0' && weather_state[0] != '\0')
+      STRCPY(rer->state, weather_state);
     region_states[0] = "|CT|MN|MA|NH|NJ|NY|PA|RI|VT|";
     region_states[1] = "|IL|IN|IA|KS|MI|MN|MO|NE|ND|OH|SD|WI|";
     region_states[2] = "|AL|AR|DE|DC|FL|GA|KY|LA|MD|MS|NC|OK|SC|TN|TX|VA|WV|";
     region_states[3] = "|AK|AZ|CA|CO|HI|ID|MT|NV|NM|OR|UT|WA|WY|";
     region_states[4] = "|US|USA|ANY|";
     STRCPY(match_state, "|");
-    STRCAT(match_state, top->rer.state);
+    STRCAT(match_state, rer->state);
     STRCAT(match_state, "|");
-    if (top->rer.region == 0 && top->rer.state[0] != '\0') {
+    if (rer->region == 0 && rer->state[0] != '\0') {
       for (int i = 0; i < REGIONS; i++) {
         if (strstr(region_states[i], strupr(match_state))) {
-          top->rer.region = i + 1;
+          rer->region = i + 1;
           break;
         }
       }
     }
   }
-  ASSERT(top->rer.region,
-         sprintf(msg, "No fuel cost escalation rates for state: %s region: %d", top->rer.state, top->rer.region));
+  ASSERT(rer->region,
+         sprintf(msg, "No fuel cost escalation rates for state: %s region: %d", rer->state, rer->region));
 
-  sprintf(filepath, ESCALATION_DIR "%4d_%02d.json", top->rer.year, top->rer.region);
+  sprintf(filepath, ESCALATION_DIR "%4d_%02d.json", rer->year, rer->region);
   if (cmds.debug_level & D_NORMAL)
     fprintf(stderr, "\nReading referenced fuel cost escalation rates from file: %s", filepath);
 
@@ -68,14 +68,14 @@ static void get_referenced_escalation_rates(MDI *top, cJSON *jschema) {
   cJSON_ArrayForEach(jbranch, jtree) {
     if (strcmp(strlwr(jbranch->string), section_name) != 0)
       continue; // allow other non 'bld' elements like comments etc
-    JI_ARR_BEG(fuel_escalation_rates, top->num_fer);
+    JI_ARR_BEG(fuel_escalation_rates, *num_fer);
       ENU_ASSIGN(fer, &fuel_id, fuel_type_id);
-      STR_ASSIGN(fer, top->fer[fuel_id - 1].fuelname, fuel_name);
+      STR_ASSIGN(fer, fer[fuel_id - 1].fuelname, fuel_name);
       char *field_name = "rate";
       if (strcmp(strlwr(jleaf->string), field_name) == 0) {
         int year = 0;
         cJSON_ArrayForEach(jleaf2, jleaf) {
-          top->fer[fuel_id - 1].rates[year] = (float)jleaf2->valuedouble;
+          fer[fuel_id - 1].rates[year] = (float)jleaf2->valuedouble;
           year++;
         }
         continue; // because we found the rate section
@@ -96,6 +96,48 @@ static void get_referenced_escalation_rates(MDI *top, cJSON *jschema) {
   return;
 }
 
+/// Completes each economic scenario from the audit: fuel prices it does not give and all heat contents are the
+/// audit's, as are the escalation rates unless it references a year of its own (the region or state defaulting to
+/// the audit's), and the discount rate unless it gives one.  What a scenario gives is told by the keys present in
+/// its JSON, so an explicit 0 (a free fuel, no discounting) is kept rather than taken for the audit's value.
+
+static void resolve_economic_scenarios(MDI *top, cJSON *jtree, cJSON *jschema) {
+  cJSON *jscenarios = cJSON_GetObjectItem(jtree, "economic_scenarios");
+
+  for (int i = 0; i < top->num_scn; i++) {
+    M_SCN *scn = &top->scn[i];
+    cJSON *jscn = cJSON_GetArrayItem(jscenarios, i);
+    FCS prices = scn->fcs;
+
+    if (scn->name[0] == '\0')
+      sprintf(scn->name, "Scenario %d", i + 1);
+
+    scn->fcs = top->fcs;
+    if (cJSON_GetObjectItem(jscn, "natural_gas")) scn->fcs.natural_gas = prices.natural_gas;
+    if (cJSON_GetObjectItem(jscn, "oil"))         scn->fcs.oil         = prices.oil;
+    if (cJSON_GetObjectItem(jscn, "electric"))    scn->fcs.electric    = prices.electric;
+    if (cJSON_GetObjectItem(jscn, "propane"))     scn->fcs.propane     = prices.propane;
+    if (cJSON_GetObjectItem(jscn, "wood"))        scn->fcs.wood        = prices.wood;
+    if (cJSON_GetObjectItem(jscn, "coal"))        scn->fcs.coal        = prices.coal;
+    if (cJSON_GetObjectItem(jscn, "kerosene"))    scn->fcs.kerosene    = prices.kerosene;
+    if (cJSON_GetObjectItem(jscn, "other"))       scn->fcs.other       = prices.other;
+
+    if (scn->rer.year) {
+      int num_fer = 0;
+      if (scn->rer.region == 0 && scn->rer.state[0] == '\0') {
+        scn->rer.region = top->rer.region;
+        STRCPY(scn->rer.state, top->rer.state);
+      }
+      get_referenced_escalation_rates(&scn->rer, top->wth.state, scn->fer, &num_fer, jschema);
+    } else {
+      memcpy(scn->fer, top->fer, sizeof(scn->fer));
+    }
+
+    if (!cJSON_GetObjectItem(jscn, "real_discount_rate"))
+      scn->real_discount_rate = top->key.real_discount_rate;
+  }
+}
+
 /// Reads MDI JSON input and assigns to the MDI struct. Assigns the JSON data to our MDI struct doing data checks
 /// as well, both range and repeat (number of record) MIN and MAX checks.
 /// Some notes on this implementation:
@@ -566,6 +608,23 @@ void mhea_json_read(MDI *top, cJSON *jtree, cJSON *jschema) {
       J_INT_ASSIGN(fuel_escalation_rates_by_reference, rer, region);
     J_SEC_END()
 
+    JI_ARR_BEG(economic_scenarios, top->num_scn);
+      ASSERT(i < MHEA_MAX_SCENARIOS, sprintf(msg, "No more than %d economic scenarios", MHEA_MAX_SCENARIOS));
+      JI_STR_ASSIGN(economic_scenarios, scn, name);
+      FLT_ASSIGN(economic_scenarios, &top->scn[i].fcs.natural_gas, natural_gas);
+      FLT_ASSIGN(economic_scenarios, &top->scn[i].fcs.oil, oil);
+      FLT_ASSIGN(economic_scenarios, &top->scn[i].fcs.electric, electric);
+      FLT_ASSIGN(economic_scenarios, &top->scn[i].fcs.propane, propane);
+      FLT_ASSIGN(economic_scenarios, &top->scn[i].fcs.wood, wood);
+      FLT_ASSIGN(economic_scenarios, &top->scn[i].fcs.coal, coal);
+      FLT_ASSIGN(economic_scenarios, &top->scn[i].fcs.kerosene, kerosene);
+      FLT_ASSIGN(economic_scenarios, &top->scn[i].fcs.other, other);
+      INT_ASSIGN(economic_scenarios, &top->scn[i].rer.year, escalation_year);
+      STR_ASSIGN(economic_scenarios, top->scn[i].rer.state, escalation_state);
+      INT_ASSIGN(economic_scenarios, &top->scn[i].rer.region, escalation_region);
+      JI_FLT_ASSIGN(economic_scenarios, scn, real_discount_rate);
+    JI_ARR_END();
+
     {
     int id = 0;
     JI_ARR_BEG(measure_active_flags, top->num_cms); 
@@ -682,12 +741,16 @@ void mhea_json_read(MDI *top, cJSON *jtree, cJSON *jschema) {
     ASSERT(top->wth.state[0] || top->rer.region || top->rer.state[0],
            sprintf(msg, "You must enter either the region or state for the referenced fuel cost escalation rates"));
     ASSERT(top->rer.year, sprintf(msg, "You must enter the year for the referenced fuel cost escalation rates"));
-    get_referenced_escalation_rates(top, jschema);
+    get_referenced_escalation_rates(&top->rer, top->wth.state, top->fer, &top->num_fer, jschema);
   }
 
+  resolve_economic_scenarios(top, jtree, jschema);
+
   // All sematic data validation above and beyond the ajv-cli structural checks presumed passed by the time we get here
 
+  phase_begin(PP_VALIDATION);
   mdi_check(top);
+  phase_end(PP_VALIDATION);
 
   // clean up
   if (jleaf)
@@ -1230,6 +1293,28 @@ void mhea_json_echo_write(MDI *top) {
     }
   }
 
+  if (top->num_scn) {
+    cJSON_AddItemToObject(jroot,   "economic_scenarios",        jarray = cJSON_CreateArray());
+    for (i = 0; i < top->num_scn; i++) {
+      cJSON_AddItemToArray(jarray, jitem = cJSON_CreateObject());
+      cJSON_AddStringToObject(jitem, "name",                    top->scn[i].name);
+      WA_AddNumToObjectNoZero(jitem, "natural_gas",             WA_DBL_FMT(top->scn[i].fcs.natural_gas, 4));
+      WA_AddNumToObjectNoZero(jitem, "oil",                     WA_DBL_FMT(top->scn[i].fcs.oil, 4));
+      WA_AddNumToObjectNoZero(jitem, "electric",                WA_DBL_FMT(top->scn[i].fcs.electric, 4));
+      WA_AddNumToObjectNoZero(jitem, "propane",                 WA_DBL_FMT(top->scn[i].fcs.propane, 4));
+      WA_AddNumToObjectNoZero(jitem, "wood",                    WA_DBL_FMT(top->scn[i].fcs.wood, 4));
+      WA_AddNumToObjectNoZero(jitem, "coal",                    WA_DBL_FMT(top->scn[i].fcs.coal, 4));
+      WA_AddNumToObjectNoZero(jitem, "kerosene",                WA_DBL_FMT(top->scn[i].fcs.kerosene, 4));
+      WA_AddNumToObjectNoZero(jitem, "other",                   WA_DBL_FMT(top->scn[i].fcs.other, 4));
+      if (top->scn[i].rer.year) {
+        cJSON_AddNumberToObject(jitem, "escalation_year",       top->scn[i].rer.year);
+        if (strlen(top->scn[i].rer.state)) {cJSON_AddStringToObject(jitem, "escalation_state", top->scn[i].rer.state);  }
+        if (top->scn[i].rer.region)        {cJSON_AddNumberToObject(jitem, "escalation_region", top->scn[i].rer.region); }
+      }
+      cJSON_AddNumberToObject(jitem, "real_discount_rate",      WA_DBL_FMT(top->scn[i].real_discount_rate, 2));
+    }
+  }
+
   cJSON_AddItemToObject(jroot,   "measure_active_flags",     jarray = cJSON_CreateArray());
   for (i = 0; i < MHEA_MAX_CMS; i++) {
     if (strlen(top->cms[i].measure_name)) {
@@ -1356,6 +1441,26 @@ void mhea_json_echo_write(MDI *top) {
 // Writes the JSON representation of the typedef struct MOR to the output_file_path.  The
 // calling function needs to open the file handle and this function will close it
 void mhea_json_result_write(MDI *top, MOR *res) {
+  cJSON *jroot = mhea_json_result(top, res);
+
+  add_performance_json(jroot); // -P, last so it times building the rest
+
+  char *output = NULL;
+  if (cmds.format_json_output) {
+    output = cJSON_Print(jroot); // allocates the formatted JSON output string and returns it
+  } else {
+    output = cJSON_PrintUnformatted(jroot); // allocates the un-formatted JSON output string and returns it
+  }
+
+  write_results_to_file(output);
+
+  if (output) free(output);             // done with monster output string
+  if (jroot) cJSON_Delete(jroot);       // pretty sure this cleans up the sub cJSON objects
+
+}
+
+// The JSON tree of the typedef struct MOR results, the calling function must cleanup the tree
+cJSON *mhea_json_result(MDI *top, MOR *res) {
   cJSON *jroot = NULL; // the JSON tree echo of our NEAT_RESULTS structure
   //cJSON *jdata = NULL;
   cJSON *jarray = NULL;
@@ -1633,19 +1738,94 @@ void mhea_json_result_write(MDI *top, MOR *res) {
     cJSON_AddStringToObject(jitem, "fuel_cost_units",       res->used_fuel[i].fuel_cost_units);
     cJSON_AddNumberToObject(jitem, "fuel_cost_per_mmbtu",    WA_DBL_FMT(res->used_fuel[i].fuel_cost_per_mmbtu, 4));
   }
-  
-  //clang-format on
 
-  char *output = NULL;
-  if (cmds.format_json_output) {
-    output = cJSON_Print(jroot); // allocates the formatted JSON output string and returns it
-  } else {
-    output = cJSON_PrintUnformatted(jroot); // allocates the un-formatted JSON output string and returns it
+  if (res->budget.optimized) {
+    cJSON *jbudget;
+    cJSON_AddItemToObject(jroot, "budget_package", jbudget = cJSON_CreateObject());
+    cJSON_AddNumberToObject(jbudget, "budget",      WA_DBL_FMT(res->budget.budget, 2));
+    cJSON_AddBoolToObject(jbudget,   "complete",    res->budget.complete);
+    cJSON_AddNumberToObject(jbudget, "estimate",    WA_DBL_FMT(res->budget.estimate, 2));
+    cJSON_AddNumberToObject(jbudget, "cost",        WA_DBL_FMT(res->budget.cost, 2));
+    cJSON_AddNumberToObject(jbudget, "savings",     WA_DBL_FMT(res->budget.savings, 2));
+    cJSON_AddNumberToObject(jbudget, "sir",         WA_DBL_FMT(res->budget.sir, 3));
+    cJSON_AddNumberToObject(jbudget, "num_measure", res->budget.num_measure);
+    cJSON_AddItemToObject(jbudget, "measures", jarray = cJSON_CreateArray());
+    for (i = 0; i < res->budget.num_measure; i++) {
+      cJSON_AddItemToArray(jarray, jitem = cJSON_CreateObject());
+      cJSON_AddNumberToObject(jitem, "index",       res->budget.measure[i].index);
+      cJSON_AddNumberToObject(jitem, "group",       res->budget.measure[i].group);
+      cJSON_AddStringToObject(jitem, "measure",     res->budget.measure[i].measure);
+      cJSON_AddStringToObject(jitem, "components",  res->budget.measure[i].components);
+      cJSON_AddNumberToObject(jitem, "savings",     WA_DBL_FMT(res->budget.measure[i].savings, 2));
+      cJSON_AddNumberToObject(jitem, "cost",        WA_DBL_FMT(res->budget.measure[i].cost, 2));
+      cJSON_AddNumberToObject(jitem, "sir",         WA_DBL_FMT(res->budget.measure[i].sir, 3));
+      cJSON_AddNumberToObject(jitem, "ccost",       WA_DBL_FMT(res->budget.measure[i].ccost, 2));
+      cJSON_AddNumberToObject(jitem, "csir",        WA_DBL_FMT(res->budget.measure[i].csir, 3));
+    }
   }
 
-  write_results_to_file(output);
+  if (res->frontier.traced) {
+    cJSON *jfrontier, *jpoint, *jindex;
+    cJSON_AddItemToObject(jroot, "package_frontier", jfrontier = cJSON_CreateObject());
+    cJSON_AddBoolToObject(jfrontier,   "complete",    res->frontier.complete);
+    cJSON_AddNumberToObject(jfrontier, "num_package", res->frontier.num_point);
+    cJSON_AddItemToObject(jfrontier, "measures", jarray = cJSON_CreateArray());
+    for (i = 0; i < res->frontier.num_measure; i++) {
+      cJSON_AddItemToArray(jarray, jitem = cJSON_CreateObject());
+      cJSON_AddNumberToObject(jitem, "index",       res->frontier.measure[i].index);
+      cJSON_AddNumberToObject(jitem, "measure_id",  res->frontier.measure[i].measure_id);
+      cJSON_AddStringToObject(jitem, "measure",     res->frontier.measure[i].measure);
+      cJSON_AddStringToObject(jitem, "components",  res->frontier.measure[i].components);
+      cJSON_AddNumberToObject(jitem, "cost",        WA_DBL_FMT(res->frontier.measure[i].cost, 2));
+      cJSON_AddNumberToObject(jitem, "sir",         WA_DBL_FMT(res->frontier.measure[i].sir, 3));
+    }
+    cJSON_AddItemToObject(jfrontier, "packages", jarray = cJSON_CreateArray());
+    for (i = 0; i < res->frontier.num_point; i++) {
+      MHEA_FRONTIER_POINT *point = &res->frontier.point[i];
+      cJSON_AddItemToArray(jarray, jpoint = cJSON_CreateObject());
+      cJSON_AddNumberToObject(jpoint, "cost",        WA_DBL_FMT(point->cost, 2));
+      cJSON_AddNumberToObject(jpoint, "savings",     WA_DBL_FMT(point->savings, 2));
+      cJSON_AddNumberToObject(jpoint, "sir",         WA_DBL_FMT(point->sir, 3));
+      cJSON_AddNumberToObject(jpoint, "estimate",    WA_DBL_FMT(point->estimate, 2));
+      cJSON_AddBoolToObject(jpoint,   "sir_ranked",  point->sir_ranked);
+      cJSON_AddItemToObject(jpoint, "measures", jindex = cJSON_CreateArray());
+      for (int j = 0; j < point->num_measure; j++)
+        cJSON_AddItemToArray(jindex, cJSON_CreateNumber(point->measure[j]));
+    }
+  }
 
-  if (output) free(output);             // done with monster output string
-  if (jroot) cJSON_Delete(jroot);       // pretty sure this cleans up the sub cJSON objects
+  if (res->num_scenario) {
+    cJSON *jscenarios, *jscenario;
+    cJSON_AddItemToObject(jroot, "economic_scenarios", jscenarios = cJSON_CreateArray());
+    for (i = 0; i < res->num_scenario; i++) {
+      MHEA_SCENARIO *scenario = &res->scenario[i];
+      cJSON_AddItemToArray(jscenarios, jscenario = cJSON_CreateObject());
+      cJSON_AddStringToObject(jscenario, "name",               scenario->name);
+      cJSON_AddNumberToObject(jscenario, "real_discount_rate", WA_DBL_FMT(scenario->real_discount_rate, 2));
+      cJSON_AddNumberToObject(jscenario, "cost",               WA_DBL_FMT(scenario->cost, 2));
+      cJSON_AddNumberToObject(jscenario, "savings",            WA_DBL_FMT(scenario->savings, 2));
+      cJSON_AddNumberToObject(jscenario, "sir",                WA_DBL_FMT(scenario->sir, 3));
+      cJSON_AddNumberToObject(jscenario, "num_package",        scenario->num_package);
+      cJSON_AddItemToObject(jscenario, "measures", jarray = cJSON_CreateArray());
+      for (int j = 0; j < scenario->num_measure; j++) {
+        MHEA_SCENARIO_MEASURE *m = &scenario->measure[j];
+        cJSON_AddItemToArray(jarray, jitem = cJSON_CreateObject());
+        cJSON_AddNumberToObject(jitem, "rank",        m->rank);
+        cJSON_AddNumberToObject(jitem, "measure_id",  m->measure_id);
+        cJSON_AddStringToObject(jitem, "measure",     m->measure);
+        cJSON_AddStringToObject(jitem, "components",  m->components);
+        cJSON_AddNumberToObject(jitem, "sir",         WA_DBL_FMT(m->sir, 3));
+        cJSON_AddNumberToObject(jitem, "package",     m->package);
+        cJSON_AddNumberToObject(jitem, "cost",        WA_DBL_FMT(m->cost, 2));
+        if (m->package) {
+          cJSON_AddNumberToObject(jitem, "savings",   WA_DBL_FMT(m->savings, 2));
+          cJSON_AddNumberToObject(jitem, "csir",      WA_DBL_FMT(m->csir, 3));
+        }
+      }
+    }
+  }
+
+  //clang-format on
 
+  return jroot;
 }
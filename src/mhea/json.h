@@ -11,5 +11,6 @@
 void mhea_json_read(MDI *, cJSON *jtree, cJSON *jschema);
 void mhea_json_echo_write(MDI *);
 void mhea_json_result_write(MDI *, MOR *);
+cJSON *mhea_json_result(MDI *, MOR *);
 
 #endif /* _JSON_M_H */
@@ -21,6 +21,7 @@
 /*************************************************************************/
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <math.h>
 
@@ -33,19 +34,235 @@ static void save_energy_results();
 static void no_heating_or_cooling_savings();
 static void additional_cost(float cost);
 static void append_component_code_to_current_results(char *code);
+static void window_leakage_savings(int ndx, float *leak_coef, float new_leak_coef);
 
+// The retrofit passes save and restore the dwelling around every measure.
+// The saved copies come from a pool of MDI buffers that are allocated the
+// first time they are needed and kept for the life of the engine, so a save
+// or restore is a single memcpy into memory that is already mapped rather
+// than a free and a fresh calloc.
+
+#define MDI_POOL_SIZE 8 // released buffers kept for reuse, enough for the deepest nesting of saved copies
+
+static MDI *mdi_pool[MDI_POOL_SIZE];
+static int mdi_pool_count;
+
+// Copy src into *dest, taking a buffer from the pool when *dest has none yet
 void copy_mdi(MDI **dest, MDI *src) {
-  // int retval;
 
   ASSERT(src, sprintf(msg, "No MDI to copy"));
 
-  if (*dest)
-    free(*dest); // free up any existing data in dest
+  if (*dest == NULL) {
+    if (mdi_pool_count > 0)
+      *dest = mdi_pool[--mdi_pool_count];
+    else {
+      ASSERT((*dest = (MDI *)malloc(sizeof(MDI))), sprintf(msg, "Out of memory in copy_mdi"));
+      performance_count(PC_DWELLING_ALLOCATIONS);
+    }
+  }
 
-  ASSERT((*dest = (MDI *)calloc(1, sizeof(MDI))), sprintf(msg, "Out of memory in copy_mdi")); // start afresh
+  if (*dest != src)
+    memcpy(*dest, src, sizeof(MDI)); // the whole structure, eg. counts and arrays
+}
 
-  memcpy(*dest, src, sizeof(MDI)); // the basic structure, eg. counts
+// Return a copy made by copy_mdi() to the pool
+void release_mdi(MDI **copy) {
+  if (*copy == NULL)
+    return;
+  if (mdi_pool_count < MDI_POOL_SIZE)
+    mdi_pool[mdi_pool_count++] = *copy;
+  else
+    free(*copy);
+  *copy = NULL;
+}
+
+void free_mdi_pool(void) {
+  while (mdi_pool_count > 0)
+    free(mdi_pool[--mdi_pool_count]);
+}
 
+// The MDI fields in each section.  Everything in the MDI belongs to exactly
+// one section.
+
+typedef struct {
+  int section;
+  size_t offset;
+  size_t size;
+} MDI_FIELD;
+
+#define SECTION_FIELD(section, field) {section, offsetof(MDI, field), sizeof(((MDI *)0)->field)}
+
+static const MDI_FIELD mdi_fields[] = {
+    SECTION_FIELD(MDI_GENERAL, gnl),         SECTION_FIELD(MDI_OTHER, wth),
+    SECTION_FIELD(MDI_WALLS, wal),           SECTION_FIELD(MDI_WALLS, awl),
+    SECTION_FIELD(MDI_WINDOWS, num_win),     SECTION_FIELD(MDI_WINDOWS, win),
+    SECTION_FIELD(MDI_WINDOWS, num_awn),     SECTION_FIELD(MDI_WINDOWS, awn),
+    SECTION_FIELD(MDI_DOORS, num_dor),       SECTION_FIELD(MDI_DOORS, dor),
+    SECTION_FIELD(MDI_DOORS, num_adr),       SECTION_FIELD(MDI_DOORS, adr),
+    SECTION_FIELD(MDI_ROOF, rof),            SECTION_FIELD(MDI_ROOF, arf),
+    SECTION_FIELD(MDI_BELLY, flr),           SECTION_FIELD(MDI_BELLY, afl),
+    SECTION_FIELD(MDI_HVAC, htg),            SECTION_FIELD(MDI_HVAC, ht2),
+    SECTION_FIELD(MDI_HVAC, htr),            SECTION_FIELD(MDI_HVAC, clg),
+    SECTION_FIELD(MDI_HVAC, cl2),            SECTION_FIELD(MDI_HVAC, clr),
+    SECTION_FIELD(MDI_INFILTRATION, inf),    SECTION_FIELD(MDI_DHW, dwh),
+    SECTION_FIELD(MDI_APPLIANCES, ref),      SECTION_FIELD(MDI_LIGHTING, num_ltg),
+    SECTION_FIELD(MDI_LIGHTING, ltg),        SECTION_FIELD(MDI_MEASURES, num_itc),
+    SECTION_FIELD(MDI_MEASURES, itc),        SECTION_FIELD(MDI_OTHER, ubh),
+    SECTION_FIELD(MDI_OTHER, num_urh),       SECTION_FIELD(MDI_OTHER, urh),
+    SECTION_FIELD(MDI_OTHER, ubc),           SECTION_FIELD(MDI_OTHER, num_urc),
+    SECTION_FIELD(MDI_OTHER, urc),           SECTION_FIELD(MDI_OTHER, fcs),
+    SECTION_FIELD(MDI_OTHER, rer),           SECTION_FIELD(MDI_OTHER, num_fer),
+    SECTION_FIELD(MDI_OTHER, fer),           SECTION_FIELD(MDI_OTHER, num_scn),
+    SECTION_FIELD(MDI_OTHER, scn),           SECTION_FIELD(MDI_MEASURES, num_cms),
+    SECTION_FIELD(MDI_MEASURES, cms),        SECTION_FIELD(MDI_MEASURES, num_rmc),
+    SECTION_FIELD(MDI_MEASURES, rmc),        SECTION_FIELD(MDI_KEY, key)};
+
+#define MDI_FIELDS ((int)(sizeof(mdi_fields) / sizeof(mdi_fields[0])))
+
+// The MDI sections each measure function may change.  Measures that write
+// nothing (eg. duct and air sealing) act through the mir alone.  The
+// retrofit passes still restore the whole MDI between measures; the table
+// documents the measures, and debug level D_MEASURE_ACCESS checks it on
+// every call.  What a measure reads is not declared: the energy
+// calculation a measure may call reads the whole dwelling (see the energy
+// memo in energyuse.c).  A measure added to Measure_Function[] must be
+// added here.
+
+static const int Measure_Writes[MHEA_MAX_CMS] = {
+    [M_CMS_REPLACE_HEATING_SYSTEM] = MDI_HVAC | MDI_MEASURES,
+    [M_CMS_SEAL_DUCTS] = 0,
+    [M_CMS_GENERAL_AIR_SEALING] = 0,
+    [M_CMS_WALL_FIBERGLASS_BATT_INSL] = MDI_WALLS,
+    [M_CMS_WALL_FIBERGLASS_BATT_INSL_ADD] = MDI_WALLS,
+    [M_CMS_WALL_CELLULOSE_LOOSE_INSL] = MDI_WALLS,
+    [M_CMS_WALL_CELLULOSE_LOOSE_INSL_ADD] = MDI_WALLS,
+    [M_CMS_WALL_FIBERGLASS_LOOSE_INSL] = MDI_WALLS,
+    [M_CMS_WALL_FIBERGLASS_LOOSE_INSL_ADD] = MDI_WALLS,
+    [M_CMS_BELLY_CELLULOSE_LOOSE_INSL] = MDI_BELLY,
+    [M_CMS_BELLY_CELLULOSE_LOOSE_INSL_ADD] = MDI_BELLY,
+    [M_CMS_BELLY_FIBERGLASS_LOOSE_INSL] = MDI_BELLY,
+    [M_CMS_BELLY_FIBERGLASS_LOOSE_INSL_ADD] = MDI_BELLY,
+    [M_CMS_ROOF_CELLULOSE_LOOSE_INSL] = MDI_ROOF,
+    [M_CMS_ROOF_CELLULOSE_LOOSE_INSL_ADD] = MDI_ROOF,
+    [M_CMS_ROOF_FIBERGLASS_LOOSE_INSL] = MDI_ROOF,
+    [M_CMS_ROOF_FIBERGLASS_LOOSE_INSL_ADD] = MDI_ROOF,
+    [M_CMS_ADD_SKIRTING] = MDI_BELLY,
+    [M_CMS_ADD_SKIRTING_ADD] = MDI_BELLY,
+    [M_CMS_WHITE_ROOF_COATING] = MDI_ROOF,
+    [M_CMS_WHITE_ROOF_COATING_ADD] = MDI_ROOF,
+    [M_CMS_REPLACE_DOORS] = MDI_DOORS,
+    [M_CMS_REPLACE_DOORS_ADD] = MDI_DOORS,
+    [M_CMS_STORM_DOORS] = MDI_DOORS,
+    [M_CMS_STORM_DOORS_ADD] = MDI_DOORS,
+    [M_CMS_REPLACE_WINDOWS] = MDI_WINDOWS,
+    [M_CMS_REPLACE_WINDOWS_ADD] = MDI_WINDOWS,
+    [M_CMS_PLASTIC_STORM_WINDOWS] = MDI_WINDOWS,
+    [M_CMS_PLASTIC_STORM_WINDOWS_ADD] = MDI_WINDOWS,
+    [M_CMS_GLASS_STORM_WINDOWS] = MDI_WINDOWS,
+    [M_CMS_GLASS_STORM_WINDOWS_ADD] = MDI_WINDOWS,
+    [M_CMS_ADD_AWNINGMHEAS] = MDI_WINDOWS,
+    [M_CMS_ADD_AWNINGMHEAS_ADD] = MDI_WINDOWS,
+    [M_CMS_ADD_SHADE_SCREENS] = MDI_WINDOWS,
+    [M_CMS_ADD_SHADE_SCREENS_ADD] = MDI_WINDOWS,
+    [M_CMS_SETBACK_THERMOSTAT] = MDI_KEY,
+    [M_CMS_TUNE_HEATING_SYSTEM] = MDI_HVAC,
+    [M_CMS_EVAPORATIVE_COOLING] = MDI_HVAC,
+    [M_CMS_TUNE_COOLING_SYSTEM] = MDI_HVAC,
+    [M_CMS_REPLACE_DX_COOLING_EQUIP] = MDI_HVAC | MDI_MEASURES,
+    [M_CMS_LIGHTING_RETROFITS] = 0,
+    [M_CMS_REFRIGERATOR_REPLACEMENT] = MDI_APPLIANCES,
+    [M_CMS_WATER_HEATER_TANK_INS] = 0,
+    [M_CMS_WATER_HEATER_PIPE_INS] = 0,
+    [M_CMS_LOW_FLOW_SHOWERHEADS] = 0,
+    [M_CMS_WATER_HEATER_REPLACEMENT] = MDI_KEY,
+    [M_CMS_WINDOW_SEALING] = MDI_WINDOWS,
+    [M_CMS_WINDOW_SEALING_ADD] = MDI_WINDOWS};
+
+int measure_writes(int measure_id) {
+  ASSERT(measure_id >= 0 && measure_id < MHEA_MAX_CMS, sprintf(msg, "Out of range measure: %d", measure_id));
+  return Measure_Writes[measure_id];
+}
+
+// Stop on any change the measure made to the mdi outside the sections it declares
+void check_measure_writes(int measure_id, MDI *before) {
+  int writes = measure_writes(measure_id);
+
+  for (int i = 0; i < MDI_FIELDS; i++) {
+    const MDI_FIELD *field = &mdi_fields[i];
+    ASSERT((field->section & writes) ||
+               memcmp((char *)mdi + field->offset, (char *)before + field->offset, field->size) == 0,
+           sprintf(msg, "Measure %d changed MDI section 0x%04x it does not declare", measure_id, field->section));
+  }
+}
+
+// Measures the measure functions never apply together in the cumulative
+// pass: the first applied keeps the others out (eg. one wall insulation
+// type, or one window measure per window).  Groups marked per_component
+// only exclude each other on the components they share.  Used by the
+// budget package search, which has to know this before calling them.
+// Measure_Blocks[] has the pairs that only exclude each other one way.
+
+typedef struct {
+  int per_component;
+  int measures[5]; // ended by -1
+} MEASURE_EXCLUSION;
+
+static const MEASURE_EXCLUSION Measure_Exclusions[] = {
+    {FALSE, {M_CMS_REPLACE_HEATING_SYSTEM, M_CMS_TUNE_HEATING_SYSTEM, -1}},
+    {FALSE, {M_CMS_EVAPORATIVE_COOLING, M_CMS_TUNE_COOLING_SYSTEM, M_CMS_REPLACE_DX_COOLING_EQUIP, -1}},
+    {FALSE, {M_CMS_WATER_HEATER_REPLACEMENT, M_CMS_WATER_HEATER_TANK_INS, -1}},
+    {FALSE, {M_CMS_WALL_FIBERGLASS_BATT_INSL, M_CMS_WALL_CELLULOSE_LOOSE_INSL, M_CMS_WALL_FIBERGLASS_LOOSE_INSL, -1}},
+    {FALSE, {M_CMS_WALL_FIBERGLASS_BATT_INSL_ADD, M_CMS_WALL_CELLULOSE_LOOSE_INSL_ADD, M_CMS_WALL_FIBERGLASS_LOOSE_INSL_ADD, -1}},
+    {FALSE, {M_CMS_BELLY_CELLULOSE_LOOSE_INSL, M_CMS_BELLY_FIBERGLASS_LOOSE_INSL, -1}},
+    {FALSE, {M_CMS_BELLY_CELLULOSE_LOOSE_INSL_ADD, M_CMS_BELLY_FIBERGLASS_LOOSE_INSL_ADD, -1}},
+    {FALSE, {M_CMS_ROOF_CELLULOSE_LOOSE_INSL, M_CMS_ROOF_FIBERGLASS_LOOSE_INSL, -1}},
+    {FALSE, {M_CMS_ROOF_CELLULOSE_LOOSE_INSL_ADD, M_CMS_ROOF_FIBERGLASS_LOOSE_INSL_ADD, -1}},
+    {TRUE, {M_CMS_REPLACE_WINDOWS, M_CMS_PLASTIC_STORM_WINDOWS, M_CMS_GLASS_STORM_WINDOWS, M_CMS_WINDOW_SEALING, -1}},
+    {TRUE, {M_CMS_REPLACE_WINDOWS_ADD, M_CMS_PLASTIC_STORM_WINDOWS_ADD, M_CMS_GLASS_STORM_WINDOWS_ADD, M_CMS_WINDOW_SEALING_ADD, -1}},
+    {TRUE, {M_CMS_ADD_AWNINGMHEAS, M_CMS_ADD_SHADE_SCREENS, -1}},
+    {TRUE, {M_CMS_ADD_AWNINGMHEAS_ADD, M_CMS_ADD_SHADE_SCREENS_ADD, -1}}};
+
+#define MEASURE_EXCLUSIONS ((int)(sizeof(Measure_Exclusions) / sizeof(Measure_Exclusions[0])))
+
+// Measures that keep another out only when applied before it: skirting is
+// not added under a belly already insulated (retro_skirt(), retro_skirt_add()),
+// but belly insulation goes in whether or not skirting was added.
+
+typedef struct {
+  int first;
+  int later;
+} MEASURE_BLOCK;
+
+static const MEASURE_BLOCK Measure_Blocks[] = {
+    {M_CMS_BELLY_CELLULOSE_LOOSE_INSL, M_CMS_ADD_SKIRTING},
+    {M_CMS_BELLY_FIBERGLASS_LOOSE_INSL, M_CMS_ADD_SKIRTING},
+    {M_CMS_BELLY_CELLULOSE_LOOSE_INSL_ADD, M_CMS_ADD_SKIRTING_ADD},
+    {M_CMS_BELLY_FIBERGLASS_LOOSE_INSL_ADD, M_CMS_ADD_SKIRTING_ADD}};
+
+#define MEASURE_BLOCKS ((int)(sizeof(Measure_Blocks) / sizeof(Measure_Blocks[0])))
+
+static int in_exclusion(const MEASURE_EXCLUSION *ex, int measure_id) {
+  for (int k = 0; ex->measures[k] >= 0; k++)
+    if (ex->measures[k] == measure_id)
+      return TRUE;
+  return FALSE;
+}
+
+// returns true if the measure result later can not be applied once the
+// measure result first, ahead of it in the cumulative pass, has been
+int mhea_measure_keeps_out(BCR_RES *first, BCR_RES *later) {
+  if (first->measure_id == later->measure_id)
+    return FALSE; // the same measure on other components
+  for (int i = 0; i < MEASURE_EXCLUSIONS; i++) {
+    const MEASURE_EXCLUSION *ex = &Measure_Exclusions[i];
+    if (in_exclusion(ex, first->measure_id) && in_exclusion(ex, later->measure_id))
+      return !ex->per_component || components_in_common(&first->component_set, &later->component_set);
+  }
+  for (int i = 0; i < MEASURE_BLOCKS; i++) {
+    if (Measure_Blocks[i].first == first->measure_id && Measure_Blocks[i].later == later->measure_id)
+      return TRUE;
+  }
+  return FALSE;
 }
 
 // Special note on retrofit functions.  They should all have the
@@ -263,8 +480,6 @@ void retro_seal_ducts(void) {
 /*************************************************************************/
 void retro_air_seal(void) {
   
-  static int added_message = FALSE;
-
   int ndx =  M_CMS_GENERAL_AIR_SEALING;
   int iMat = M_MAT_GENERAL_AIR_SEALING;
 
@@ -297,14 +512,14 @@ void retro_air_seal(void) {
     mir->Results[mir->Rndx].audit_section_id = M_DUCTS_AND_INFILTRATION;
     mir->Results[mir->Rndx].material_id = iMat;
 
-    if (mir->infiltration_treatment == INF_FULL_MEASURE && mir->flgWhichPass == CUMULATIVE && added_message == FALSE) {
+    if (mir->infiltration_treatment == INF_FULL_MEASURE && mir->flgWhichPass == CUMULATIVE && !(mor->once_message & MSG_ONCE_INFILTRATION_REDUCTION)) {
       add_mhea_message("MHEA assumes that infiltration reduction will be performed in parallel to measures "
                        "selected by the audit and according to guidelines chosen by the auditor.  MHEA can "
                        "evaluate the cost-effectiveness of infiltration reduction efforts, but it will not direct the work.");
       add_mhea_message("The audit strongly suggests, but does not necessarily require, the use of existing "
                        "infiltration reduction procedures using a blower-door. The blower-door establishes if "
                        "infiltration reduction is necessary, then helps locate leaks and monitor progress in their elimination.");
-      added_message = TRUE;
+      mor->once_message |= MSG_ONCE_INFILTRATION_REDUCTION;
     }
 
     mir->Rndx++;
@@ -793,7 +1008,6 @@ void retro_insulate_belly_cellulose(void) {
   float fAdjWingDepth = mir->fWngAirSpace; // Total depth of added insulation
   // accounting for compression of existing insulation
   float fAdjCntrDepth = mir->fBellyAirSpace;
-  static float fDensExistWing, fDensExistCntr;
 
   mir->flgRetrofits[ndx] = FALSE;
 
@@ -811,14 +1025,14 @@ void retro_insulate_belly_cellulose(void) {
 
   if (mir->flgWhichPass == FIRST_PASS) {
     if (mdi->flr.belly_mineral_insl > mdi->flr.belly_loose_insl)
-      fDensExistCntr = mir->fDensExistBatInsul;
+      mir->fCelDensExistCntr = mir->fDensExistBatInsul;
     else
-      fDensExistCntr = DENSITY_EXIST_FG_INSUL;
+      mir->fCelDensExistCntr = DENSITY_EXIST_FG_INSUL;
 
     if (mdi->flr.wing_mineral_insl > mdi->flr.wing_loose_insl)
-      fDensExistWing = mir->fDensExistBatInsul;
+      mir->fCelDensExistWing = mir->fDensExistBatInsul;
     else
-      fDensExistWing = DENSITY_EXIST_FG_INSUL;
+      mir->fCelDensExistWing = DENSITY_EXIST_FG_INSUL;
   }
 
   /* There is no reason to apply more than 8 inches of blown */
@@ -828,16 +1042,16 @@ void retro_insulate_belly_cellulose(void) {
   if (mir->fBellyAirSpace > 8.0) {
     mir->fBellyAirSpace = 8.0;
     mir->flgLimitBellyInsul = TRUE;
-  } else if (densitycntr > fDensExistCntr)
-    fAdjCntrDepth = mir->fBellyAirSpace + mir->fBellyInsDepth * (1.0f - fDensExistCntr / densitycntr);
+  } else if (densitycntr > mir->fCelDensExistCntr)
+    fAdjCntrDepth = mir->fBellyAirSpace + mir->fBellyInsDepth * (1.0f - mir->fCelDensExistCntr / densitycntr);
 
   /*********************************************************
   Compute the depth of insulation to be added in the wings
   accounting for compression of the existing insulation.
   *********************************************************/
 
-  if (density > fDensExistWing)
-    fAdjWingDepth = mir->fWngAirSpace + mir->fWingInsDepth * (1.0f - fDensExistWing / density);
+  if (density > mir->fCelDensExistWing)
+    fAdjWingDepth = mir->fWngAirSpace + mir->fWingInsDepth * (1.0f - mir->fCelDensExistWing / density);
 
   /********************
   SLF 7/14/94 - Changed per Beta reviewer comments.
@@ -928,7 +1142,6 @@ void retro_insulate_belly_cellulose_add(void) {
   float bagsize = mdi->key.bag_size_for_loose_cellulose_insulation;
   float quant;
   float fAdjFloorDepth = mdi->afl.avail_insl;
-  static float fDensExist;
 
   mir->flgRetrofits[ndx] = FALSE;
 
@@ -947,9 +1160,9 @@ void retro_insulate_belly_cellulose_add(void) {
 
   if (mir->flgWhichPass == FIRST_PASS) {
     if (mdi->afl.mineral_insl > mdi->afl.loose_insl)
-      fDensExist = mir->fDensExistBatInsul;
+      mir->fCelDensExistAFlr = mir->fDensExistBatInsul;
     else
-      fDensExist = DENSITY_EXIST_FG_INSUL;
+      mir->fCelDensExistAFlr = DENSITY_EXIST_FG_INSUL;
   }
 
   /* There is no reason to apply more than 8 inches of blown */
@@ -958,8 +1171,8 @@ void retro_insulate_belly_cellulose_add(void) {
   if (mdi->afl.avail_insl > 8.0) {
     mdi->afl.avail_insl = fAdjFloorDepth = 8.0;
     mir->flgLimitBellyInsulAdd = TRUE;
-  } else if (density > fDensExist)
-    fAdjFloorDepth = mdi->afl.avail_insl + mir->fAFloorInsDepth * (1.0f - fDensExist / density);
+  } else if (density > mir->fCelDensExistAFlr)
+    fAdjFloorDepth = mdi->afl.avail_insl + mir->fAFloorInsDepth * (1.0f - mir->fCelDensExistAFlr / density);
 
   /********************
   SLF 7/14/94 - Changed per Beta reviewer comments.
@@ -1028,7 +1241,6 @@ void retro_insulate_belly_fiberglass(void) {
   float fAdjWingDepth = mir->fWngAirSpace; // Total depth of added insulation
   // accounting for compression of existing insulation
   float fAdjCntrDepth = mir->fBellyAirSpace;
-  static float fDensExistWing, fDensExistCntr, fCompExistLooseIns;
 
   mir->flgRetrofits[ndx] = FALSE;
 
@@ -1046,16 +1258,16 @@ void retro_insulate_belly_fiberglass(void) {
 
   if (mir->flgWhichPass == FIRST_PASS) {
     if (mdi->flr.belly_mineral_insl > mdi->flr.belly_loose_insl)
-      fDensExistCntr = mir->fDensExistBatInsul;
+      mir->fLFGDensExistCntr = mir->fDensExistBatInsul;
     else
-      fDensExistCntr = DENSITY_EXIST_FG_INSUL;
+      mir->fLFGDensExistCntr = DENSITY_EXIST_FG_INSUL;
 
     if (mdi->flr.wing_mineral_insl > mdi->flr.wing_loose_insl)
-      fDensExistWing = mir->fDensExistBatInsul;
+      mir->fLFGDensExistWing = mir->fDensExistBatInsul;
     else
-      fDensExistWing = DENSITY_EXIST_FG_INSUL;
+      mir->fLFGDensExistWing = DENSITY_EXIST_FG_INSUL;
 
-    fCompExistLooseIns = mdi->flr.belly_loose_insl * fDensExistWing / density;
+    mir->fLFGCompExistLooseIns = mdi->flr.belly_loose_insl * mir->fLFGDensExistWing / density;
   }
 
   /* There is no reason to apply more than 8 inches of blown */
@@ -1065,16 +1277,16 @@ void retro_insulate_belly_fiberglass(void) {
   if (mir->fBellyAirSpace > 8.0) {
     mir->fBellyAirSpace = 8.0;
     mir->flgLimitBellyInsul = TRUE;
-  } else if (densitycntr > fDensExistCntr)
-    fAdjCntrDepth = mir->fBellyAirSpace + mir->fBellyInsDepth * (1.0f - fDensExistCntr / densitycntr);
+  } else if (densitycntr > mir->fLFGDensExistCntr)
+    fAdjCntrDepth = mir->fBellyAirSpace + mir->fBellyInsDepth * (1.0f - mir->fLFGDensExistCntr / densitycntr);
 
   /*********************************************************
   Compute the depth of insulation to be added accounting for
   compression of the existing insulation.
   *********************************************************/
 
-  if (density > fDensExistWing)
-    fAdjWingDepth = mir->fWngAirSpace + mir->fWingInsDepth * (1.0f - fDensExistWing / density);
+  if (density > mir->fLFGDensExistWing)
+    fAdjWingDepth = mir->fWngAirSpace + mir->fWingInsDepth * (1.0f - mir->fLFGDensExistWing / density);
 
   /********************
   SLF 7/14/94 - Changed per Beta reviewer comments.
@@ -1120,7 +1332,7 @@ void retro_insulate_belly_fiberglass(void) {
   mdi->flr.belly_condition = BC_GOOD;
 
   mdi->flr.belly_loose_insl += mir->fBellyAirSpace;
-  mdi->flr.wing_loose_insl = fAdjWingDepth + fCompExistLooseIns;
+  mdi->flr.wing_loose_insl = fAdjWingDepth + mir->fLFGCompExistLooseIns;
   // MBG 7/03
 
   mir->flgRetrofits[ndx] = TRUE;
@@ -1159,7 +1371,6 @@ void retro_insulate_belly_fiberglass_add(void) {
   float bagsize = mdi->key.bag_size_for_loose_fiberglass_insulation;
   float quant;
   float fAdjFloorDepth = mdi->afl.avail_insl;
-  static float fDensExist;
 
   mir->flgRetrofits[ndx] = FALSE;
 
@@ -1178,9 +1389,9 @@ void retro_insulate_belly_fiberglass_add(void) {
 
   if (mir->flgWhichPass == FIRST_PASS) {
     if (mdi->afl.mineral_insl > mdi->afl.loose_insl)
-      fDensExist = mir->fDensExistBatInsul;
+      mir->fLFGDensExistAFlr = mir->fDensExistBatInsul;
     else
-      fDensExist = DENSITY_EXIST_FG_INSUL;
+      mir->fLFGDensExistAFlr = DENSITY_EXIST_FG_INSUL;
   }
 
   /* There is no reason to apply more than 8 inches of blown */
@@ -1189,8 +1400,8 @@ void retro_insulate_belly_fiberglass_add(void) {
   if (mdi->afl.avail_insl > 8.0) {
     mdi->afl.avail_insl = 8.0;
     mir->flgLimitBellyInsulAdd = TRUE;
-  } else if (density > fDensExist)
-    fAdjFloorDepth = mdi->afl.avail_insl + mir->fAFloorInsDepth * (1.0f - fDensExist / density);
+  } else if (density > mir->fLFGDensExistAFlr)
+    fAdjFloorDepth = mdi->afl.avail_insl + mir->fAFloorInsDepth * (1.0f - mir->fLFGDensExistAFlr / density);
 
   /********************
   SLF 7/14/94 - Changed per Beta reviewer comments.
@@ -1969,7 +2180,7 @@ static void retro_door_each(MDI *original, M_DOR *door, int measure_id, int audi
   //  STRCAT(name, " Requried");
 
   if (mir->flgWhichPass == CUMULATIVE) {
-    if (!comma_delimited_strstr(mir->sComponents, door->code))
+    if (!component_set_contains(&mir->component_set, door->code_id))
       return;
   } 
 
@@ -2056,7 +2267,7 @@ void retro_door(void) {
 
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
   return;
 }
@@ -2090,7 +2301,7 @@ void retro_door_add(void) {
 
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
   return;
 }
@@ -2248,7 +2459,7 @@ void retro_window(void) {
     ****************************************************************************/
 
     for (int i = 0; i < mdi->num_win; i++) {
-      if (!comma_delimited_strstr(mir->sComponents, mdi->win[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->win[i].code_id))
         continue;
       else if (mdi->win[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -2263,24 +2474,7 @@ void retro_window(void) {
           /*************************
           Reset window leakage rating
           *************************/
-          float save_leak_coef = mdi->win[i].leak_coef;
-          mdi->win[i].leak_coef = window_leakage_coef(MEC_REPLACEMENT);
-
-          /***********************************
-          MBG 3/11/04 - Call mhea_energy_use() first with only window
-          leakage changed in order to determine energy savings
-          which should be attributed to this measure instead of
-          general infiltration reduction.
-          ***********************************/
-
-          mir->flgWhichPass = NOT_BASE_CASE;
-          mhea_energy_use();
-          mir->flgWhichPass = CUMULATIVE;
-          // mir->fInfMeasEnrgyHtg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstHtg - mir->fHeating_Energy * mir->fAdj_Htg;
-          // mir->fInfMeasEnrgyClg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstClg - mir->fCooling_Energy * mir->fAdj_Clg;
-          mir->fInfMeasEnrgyHtg[ndx] += mir->fPre_Heating - mir->fHeating_Energy * mir->fAdj_Htg;
-          mir->fInfMeasEnrgyClg[ndx] += mir->fPre_Cooling - mir->fCooling_Energy * mir->fAdj_Clg;
-          mdi->win[i].leak_coef = save_leak_coef;
+          window_leakage_savings(ndx, &mdi->win[i].leak_coef, window_leakage_coef(MEC_REPLACEMENT));
         }
       }
     } // End loop through window descriptions
@@ -2305,7 +2499,7 @@ void retro_window(void) {
       with instance of measure
       **************************/
 
-      if (!comma_delimited_strstr(mir->sComponents, mdi->win[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->win[i].code_id))
         continue;
       if (mdi->win[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -2418,7 +2612,7 @@ void retro_window(void) {
   // GKA/MJF Issue #83
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
 
   return;
@@ -2459,7 +2653,7 @@ void retro_window_add(void) {
     ****************************************************************************/
 
     for (int i = 0; i < mdi->num_awn; i++) {
-      if (!comma_delimited_strstr(mir->sComponents, mdi->awn[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->awn[i].code_id))
         continue;
       else if (mdi->awn[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -2474,24 +2668,7 @@ void retro_window_add(void) {
           /*************************
           Reset window leakage rating
           *************************/
-          float save_leak_coef = mdi->awn[i].leak_coef;
-          mdi->awn[i].leak_coef = window_leakage_coef(MEC_REPLACEMENT);
-
-          /***********************************
-          MBG 3/11/04 - Call mhea_energy_use() first with only window
-          leakage changed in order to determine energy savings
-          which should be attributed to this measure instead of
-          general infiltration reduction.
-          ***********************************/
-
-          mir->flgWhichPass = NOT_BASE_CASE;
-          mhea_energy_use();
-          mir->flgWhichPass = CUMULATIVE;
-          // mir->fInfMeasEnrgyHtg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstHtg - mir->fHeating_Energy * mir->fAdj_Htg;
-          // mir->fInfMeasEnrgyClg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstClg - mir->fCooling_Energy * mir->fAdj_Clg;
-          mir->fInfMeasEnrgyHtg[ndx] += mir->fPre_Heating - mir->fHeating_Energy * mir->fAdj_Htg;
-          mir->fInfMeasEnrgyClg[ndx] += mir->fPre_Cooling - mir->fCooling_Energy * mir->fAdj_Clg;
-          mdi->awn[i].leak_coef = save_leak_coef;
+          window_leakage_savings(ndx, &mdi->awn[i].leak_coef, window_leakage_coef(MEC_REPLACEMENT));
         }
       }
     } // End loop through window descriptions
@@ -2516,7 +2693,7 @@ void retro_window_add(void) {
       with instance of measure
       **************************/
 
-      if (!comma_delimited_strstr(mir->sComponents, mdi->awn[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->awn[i].code_id))
         continue;
       if (mdi->awn[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -2631,7 +2808,7 @@ void retro_window_add(void) {
   // GKA/MJF Issue #83
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
 
   return;
@@ -2678,7 +2855,7 @@ void retro_plastic_storm(void) {
         fprintf(stderr, "i:%d mir->sComponents: %s\n mdi->win[i].code:%s\n mdi->win[i].imeas_applied:%d\n", i, mir->sComponents, mdi->win[i].code, mdi->win[i].imeas_applied);
       }
 
-      if (!comma_delimited_strstr(mir->sComponents, mdi->win[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->win[i].code_id))
         continue;
       else if (mdi->win[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window  MBG 4/07
@@ -2693,24 +2870,7 @@ void retro_plastic_storm(void) {
           /*************************
           Reset window leakiness
           *************************/
-          float save_leak_coef = mdi->win[i].leak_coef;
-          mdi->win[i].leak_coef = (float)((POWC((1 / (POWC(1 / save_leak_coef, 1.25) + 27.77)), 0.8)));
-
-          /***********************************
-          MBG 1/10/05 - Call mhea_energy_use() first with only window
-          leakage changed in order to determine energy savings
-          which should be attributed to this measure instead of
-          general infiltration reduction.
-          ***********************************/
-
-          mir->flgWhichPass = NOT_BASE_CASE;
-          mhea_energy_use();
-          mir->flgWhichPass = CUMULATIVE;
-          // mir->fInfMeasEnrgyHtg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstHtg - mir->fHeating_Energy * mir->fAdj_Htg;
-          // mir->fInfMeasEnrgyClg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstClg - mir->fCooling_Energy * mir->fAdj_Clg;
-          mir->fInfMeasEnrgyHtg[ndx] += mir->fPre_Heating - mir->fHeating_Energy * mir->fAdj_Htg;
-          mir->fInfMeasEnrgyClg[ndx] += mir->fPre_Cooling - mir->fCooling_Energy * mir->fAdj_Clg;
-          mdi->win[i].leak_coef = save_leak_coef;
+          window_leakage_savings(ndx, &mdi->win[i].leak_coef, (float)((POWC((1 / (POWC(1 / mdi->win[i].leak_coef, 1.25) + 27.77)), 0.8))));
         }
       }
     } // End loop through window descriptions
@@ -2735,7 +2895,7 @@ void retro_plastic_storm(void) {
       with instance of measure
       **************************/
 
-      if (!comma_delimited_strstr(mir->sComponents, mdi->win[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->win[i].code_id))
         continue;
       if (mdi->win[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -2853,7 +3013,7 @@ void retro_plastic_storm(void) {
   // GKA/MJF Issue #83
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
 
   return;
@@ -2894,7 +3054,7 @@ void retro_plastic_storm_add(void) {
     ****************************************************************************/
 
     for (int i = 0; i < mdi->num_awn; i++) {
-      if (!comma_delimited_strstr(mir->sComponents, mdi->awn[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->awn[i].code_id))
         continue;
       else if (mdi->awn[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window  MBG 4/07
@@ -2910,24 +3070,7 @@ void retro_plastic_storm_add(void) {
           /*************************
           Reset window leakiness
           *************************/
-          float save_leak_coef = mdi->awn[i].leak_coef;
-          mdi->awn[i].leak_coef = (float)((POWC((1 / (POWC(1 / save_leak_coef, 1.25) + 27.77)), 0.8)));
-
-          /***********************************
-          MBG 1/10/05 - Call mhea_energy_use() first with only window
-          leakage changed in order to determine energy savings
-          which should be attributed to this measure instead of
-          general infiltration reduction.
-          ***********************************/
-
-          mir->flgWhichPass = NOT_BASE_CASE;
-          mhea_energy_use();
-          mir->flgWhichPass = CUMULATIVE;
-          // mir->fInfMeasEnrgyHtg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstHtg - mir->fHeating_Energy * mir->fAdj_Htg;
-          // mir->fInfMeasEnrgyClg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstClg - mir->fCooling_Energy * mir->fAdj_Clg;
-          mir->fInfMeasEnrgyHtg[ndx] += mir->fPre_Heating - mir->fHeating_Energy * mir->fAdj_Htg;
-          mir->fInfMeasEnrgyClg[ndx] += mir->fPre_Cooling - mir->fCooling_Energy * mir->fAdj_Clg;
-          mdi->awn[i].leak_coef = save_leak_coef;
+          window_leakage_savings(ndx, &mdi->awn[i].leak_coef, (float)((POWC((1 / (POWC(1 / mdi->awn[i].leak_coef, 1.25) + 27.77)), 0.8))));
         }
       }
     } // End loop through window descriptions
@@ -2952,7 +3095,7 @@ void retro_plastic_storm_add(void) {
       with instance of measure
       **************************/
 
-      if (!comma_delimited_strstr(mir->sComponents, mdi->awn[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->awn[i].code_id))
         continue;
       if (mdi->awn[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -3071,7 +3214,7 @@ void retro_plastic_storm_add(void) {
   // GKA/MJF Issue #83
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
 
   return;
@@ -3112,7 +3255,7 @@ void retro_glass_storm(void) {
     ****************************************************************************/
 
     for (int i = 0; i < mdi->num_win; i++) {
-      if (!comma_delimited_strstr(mir->sComponents, mdi->win[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->win[i].code_id))
         continue;
       else if (mdi->win[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window  MBG 4/07
@@ -3128,25 +3271,7 @@ void retro_glass_storm(void) {
           /*************************
           Reset window leakiness
           *************************/
-          float save_leak_coef = mdi->win[i].leak_coef;
-          mdi->win[i].leak_coef = window_storm_leak_coef(save_leak_coef);
-
-          /***********************************
-          MBG 1/10/05 - Call mhea_energy_use() first with only window
-          leakage changed in order to determine energy savings
-          which should be attributed to this measure instead of
-          general infiltration reduction.
-          ***********************************/
-
-          mir->flgWhichPass = NOT_BASE_CASE;
-          mhea_energy_use();
-          mir->flgWhichPass = CUMULATIVE;
-
-          // mir->fInfMeasEnrgyHtg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstHtg - mir->fHeating_Energy * mir->fAdj_Htg;
-          // mir->fInfMeasEnrgyClg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstClg - mir->fCooling_Energy * mir->fAdj_Clg;
-          mir->fInfMeasEnrgyHtg[ndx] += mir->fPre_Heating - mir->fHeating_Energy * mir->fAdj_Htg;
-          mir->fInfMeasEnrgyClg[ndx] += mir->fPre_Cooling - mir->fCooling_Energy * mir->fAdj_Clg;
-          mdi->win[i].leak_coef = save_leak_coef;
+          window_leakage_savings(ndx, &mdi->win[i].leak_coef, window_storm_leak_coef(mdi->win[i].leak_coef));
         }
       }
     } // End loop through window descriptions
@@ -3171,7 +3296,7 @@ void retro_glass_storm(void) {
       with instance of measure
       **************************/
 
-      if (!comma_delimited_strstr(mir->sComponents, mdi->win[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->win[i].code_id))
         continue;
       if (mdi->win[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -3289,7 +3414,7 @@ void retro_glass_storm(void) {
   // GKA/MJF Issue #83
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
 
   return;
@@ -3330,7 +3455,7 @@ void retro_glass_storm_add(void) {
     ****************************************************************************/
 
     for (int i = 0; i < mdi->num_awn; i++) {
-      if (!comma_delimited_strstr(mir->sComponents, mdi->awn[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->awn[i].code_id))
         continue;
       else if (mdi->awn[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window  MBG 4/07
@@ -3346,24 +3471,7 @@ void retro_glass_storm_add(void) {
           /*************************
           Reset window leakiness
           *************************/
-          float save_leak_coef = mdi->awn[i].leak_coef;
-          mdi->awn[i].leak_coef = window_storm_leak_coef(save_leak_coef);
-
-          /***********************************
-          MBG 1/10/05 - Call mhea_energy_use() first with only window
-          leakage changed in order to determine energy savings
-          which should be attributed to this measure instead of
-          general infiltration reduction.
-          ***********************************/
-
-          mir->flgWhichPass = NOT_BASE_CASE;
-          mhea_energy_use();
-          mir->flgWhichPass = CUMULATIVE;
-          // mir->fInfMeasEnrgyHtg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstHtg - mir->fHeating_Energy * mir->fAdj_Htg;
-          // mir->fInfMeasEnrgyClg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstClg - mir->fCooling_Energy * mir->fAdj_Clg;
-          mir->fInfMeasEnrgyHtg[ndx] += mir->fPre_Heating - mir->fHeating_Energy * mir->fAdj_Htg;
-          mir->fInfMeasEnrgyClg[ndx] += mir->fPre_Cooling - mir->fCooling_Energy * mir->fAdj_Clg;
-          mdi->awn[i].leak_coef = save_leak_coef;
+          window_leakage_savings(ndx, &mdi->awn[i].leak_coef, window_storm_leak_coef(mdi->awn[i].leak_coef));
         }
       }
     } // End loop through window descriptions
@@ -3388,7 +3496,7 @@ void retro_glass_storm_add(void) {
       with instance of measure
       **************************/
 
-      if (!comma_delimited_strstr(mir->sComponents, mdi->awn[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->awn[i].code_id))
         continue;
       if (mdi->awn[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -3506,7 +3614,7 @@ void retro_glass_storm_add(void) {
   // GKA/MJF Issue #83
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
 
   return;
@@ -3887,7 +3995,6 @@ void retro_smart_thermostat(void) {
 void retro_tune_heating(void) {
   int ndx  = M_CMS_TUNE_HEATING_SYSTEM;
   int iMat = M_MAT_TUNE_HEATING_SYSTEM;
-  static int added_message = FALSE;
 
   mir->flgRetrofits[ndx] = FALSE;
 
@@ -3963,10 +4070,10 @@ void retro_tune_heating(void) {
       deleff += 0.02f * c2;
 
     if (deleff < 0.001f) {
-      if (mdi->htg.tuneup == YES && mir->flgWhichPass == CUMULATIVE && added_message == FALSE) {
+      if (mdi->htg.tuneup == YES && mir->flgWhichPass == CUMULATIVE && !(mor->once_message & MSG_ONCE_TUNEUP_NO_GAIN)) {
         sprintf(mir->sMsg, "Heating Tune Up required but there are no efficiency gains beyond: %f", fEfficiency);
         add_mhea_message(mir->sMsg);
-        added_message = TRUE;
+        mor->once_message |= MSG_ONCE_TUNEUP_NO_GAIN;
       }
       // no change to mdi, but continue
     } else {
@@ -4379,6 +4486,8 @@ void retro_replace_lighting(void) {
     STRCPY(res->sMaterial, r_type);
     }
     STRCPY(res->sComponents, ltg.code);
+    component_set_clear(&res->component_set);
+    component_set_add_code(&res->component_set, ltg.code);
     STRCPY(res->sUnits, "Each Bulb");
 
     res->fEnerPreHtg = mir->fPre_Heating;    // no heating or cooling changes for now
@@ -5325,7 +5434,7 @@ void retro_window_sealing(void) {
     ****************************************************************************/
 
     for (int i = 0; i < mdi->num_win; i++) {
-      if (!comma_delimited_strstr(mir->sComponents, mdi->win[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->win[i].code_id))
         continue;
       else if (mdi->win[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window  MBG 4/07
@@ -5345,24 +5454,7 @@ void retro_window_sealing(void) {
           // mdi->win[i].leak_coef = mdi->win[i].leak_coef - SEALING_FRACTION * (mdi->win[i].leak_coef - SEALED_WINDOW_LEAKAGE_COEF);
           // if (mdi->win[i].leak_coef > fleakcoef)
           //   mdi->win[i].leak_coef = fleakcoef;
-          float save_leak_coef = mdi->win[i].leak_coef;
-          mdi->win[i].leak_coef = window_sealing_leak_coef(save_leak_coef);
-
-          /***********************************
-          MBG 3/11/04 - Call mhea_energy_use() first with only window
-          leakage changed in order to determine energy savings
-          which should be attributed to this measure instead of
-          general infiltration reduction.
-          ***********************************/
-
-          mir->flgWhichPass = NOT_BASE_CASE;
-          mhea_energy_use();
-          mir->flgWhichPass = CUMULATIVE;
-          // mir->fInfMeasEnrgyHtg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstHtg - mir->fHeating_Energy * mir->fAdj_Htg;
-          // mir->fInfMeasEnrgyClg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstClg - mir->fCooling_Energy * mir->fAdj_Clg;
-          mir->fInfMeasEnrgyHtg[ndx] += mir->fPre_Heating - mir->fHeating_Energy * mir->fAdj_Htg;
-          mir->fInfMeasEnrgyClg[ndx] += mir->fPre_Cooling - mir->fCooling_Energy * mir->fAdj_Clg;
-          mdi->win[i].leak_coef = save_leak_coef;
+          window_leakage_savings(ndx, &mdi->win[i].leak_coef, window_sealing_leak_coef(mdi->win[i].leak_coef));
         }
       }
 
@@ -5388,7 +5480,7 @@ void retro_window_sealing(void) {
       with instance of measure
       **************************/
 
-      if (!comma_delimited_strstr(mir->sComponents, mdi->win[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->win[i].code_id))
         continue;
       if (mdi->win[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -5496,7 +5588,7 @@ void retro_window_sealing(void) {
   // GKA/MJF Issue #83
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
 
   return;
@@ -5537,7 +5629,7 @@ void retro_window_sealing_add(void) {
     ****************************************************************************/
 
     for (int i = 0; i < mdi->num_awn; i++) {
-      if (!comma_delimited_strstr(mir->sComponents, mdi->awn[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->awn[i].code_id))
         continue;
       else if (mdi->awn[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window  MBG 4/07
@@ -5556,24 +5648,7 @@ void retro_window_sealing_add(void) {
           // mdi->awn[i].leak_coef = mdi->awn[i].leak_coef - SEALING_FRACTION * (mdi->awn[i].leak_coef - SEALED_WINDOW_LEAKAGE_COEF);
           // if (mdi->awn[i].leak_coef > fleakcoef)
           //   mdi->awn[i].leak_coef = fleakcoef;
-          float save_leak_coef = mdi->awn[i].leak_coef;
-          mdi->awn[i].leak_coef = window_sealing_leak_coef(save_leak_coef);
-
-          /***********************************
-          MBG 3/11/04 - Call mhea_energy_use() first with only window
-          leakage changed in order to determine energy savings
-          which should be attributed to this measure instead of
-          general infiltration reduction.
-          ***********************************/
-
-          mir->flgWhichPass = NOT_BASE_CASE;
-          mhea_energy_use();
-          mir->flgWhichPass = CUMULATIVE;
-          // mir->fInfMeasEnrgyHtg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstHtg - mir->fHeating_Energy * mir->fAdj_Htg;
-          // mir->fInfMeasEnrgyClg[ndx] += mir->Results[mir->Rndx - 1].fEnerPstClg - mir->fCooling_Energy * mir->fAdj_Clg;
-          mir->fInfMeasEnrgyHtg[ndx] += mir->fPre_Heating - mir->fHeating_Energy * mir->fAdj_Htg;
-          mir->fInfMeasEnrgyClg[ndx] += mir->fPre_Cooling - mir->fCooling_Energy * mir->fAdj_Clg;
-          mdi->awn[i].leak_coef = save_leak_coef;
+          window_leakage_savings(ndx, &mdi->awn[i].leak_coef, window_sealing_leak_coef(mdi->awn[i].leak_coef));
         }
       }
     } // End loop through window descriptions
@@ -5598,7 +5673,7 @@ void retro_window_sealing_add(void) {
       with instance of measure
       **************************/
 
-      if (!comma_delimited_strstr(mir->sComponents, mdi->awn[i].code))
+      if (!component_set_contains(&mir->component_set, mdi->awn[i].code_id))
         continue;
       if (mdi->awn[i].imeas_applied != 0)
         continue; // Prevent more than one measure per window MBG 4/07
@@ -5706,7 +5781,7 @@ void retro_window_sealing_add(void) {
   // GKA/MJF Issue #83
   if(mir->flgWhichPass != CUMULATIVE){
     copy_mdi(&mdi, original); // back to original MDI structure
-    free(original);           // free memory allocated in this procedure
+    release_mdi(&original);   // return the copy made in this procedure
   }
 
   return;
@@ -5922,5 +5997,31 @@ static void append_component_code_to_current_results(char *code){
   if (strlen(mir->Results[mir->Rndx].sComponents))
     STRNCAT(mir->Results[mir->Rndx].sComponents, COMMA, 1);
   STRCAT(mir->Results[mir->Rndx].sComponents, code);
+  component_set_add_code(&mir->Results[mir->Rndx].component_set, code);
 }
 
+/***************************************************************************
+** Function Name: window_leakage_savings
+**
+**  DESCRIPTION: Cumulative pass infiltration savings of one window measure.
+**               MBG 3/11/04 - Call mhea_energy_use() with only the window
+**               leakage changed in order to determine energy savings which
+**               should be attributed to this measure instead of general
+**               infiltration reduction.  The savings are taken against the
+**               previous cumulative result (mir->fPre_*), and the leakage
+**               is restored afterwards.  The energy use memo lets the
+**               measure's own evaluation of the same house reuse this call.
+**************************************************************************/
+static void window_leakage_savings(int ndx, float *leak_coef, float new_leak_coef) {
+  float save_leak_coef = *leak_coef;
+
+  *leak_coef = new_leak_coef;
+
+  mir->flgWhichPass = NOT_BASE_CASE;
+  mhea_energy_use();
+  mir->flgWhichPass = CUMULATIVE;
+  mir->fInfMeasEnrgyHtg[ndx] += mir->fPre_Heating - mir->fHeating_Energy * mir->fAdj_Htg;
+  mir->fInfMeasEnrgyClg[ndx] += mir->fPre_Cooling - mir->fCooling_Energy * mir->fAdj_Clg;
+
+  *leak_coef = save_leak_coef;
+}
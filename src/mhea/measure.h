@@ -10,6 +10,32 @@
 #define _MEASURE_H
 
 void copy_mdi(MDI **dest, MDI *src);
+void release_mdi(MDI **copy);
+void free_mdi_pool(void);
+
+// Sections of the MDI, by bit, that a measure may change.  See
+// Measure_Writes[] in measure.c for the declarations of each measure.
+
+enum MDI_SECTION {
+  MDI_GENERAL = 0x0001,      // gnl
+  MDI_WALLS = 0x0002,        // wal, awl
+  MDI_ROOF = 0x0004,         // rof, arf
+  MDI_BELLY = 0x0008,        // flr, afl; floor, belly and skirting
+  MDI_WINDOWS = 0x0010,      // win, awn
+  MDI_DOORS = 0x0020,        // dor, adr
+  MDI_HVAC = 0x0040,         // htg, ht2, htr, clg, cl2, clr
+  MDI_INFILTRATION = 0x0080, // inf
+  MDI_DHW = 0x0100,          // dwh
+  MDI_LIGHTING = 0x0200,     // ltg
+  MDI_APPLIANCES = 0x0400,   // ref
+  MDI_KEY = 0x0800,          // key
+  MDI_MEASURES = 0x1000,     // cms, rmc, itc; measure list, material and itemized costs
+  MDI_OTHER = 0x2000         // wth, utility bills, fuel costs and economic scenarios
+};
+
+int measure_writes(int measure_id);
+void check_measure_writes(int measure_id, MDI *before);
+int mhea_measure_keeps_out(BCR_RES *first, BCR_RES *later);
 
 void retro_replace_heating(void);
 void retro_seal_ducts(void);
@@ -28,17 +28,20 @@
 #include "wa_engine.h"
 
 static void fill_static_global_arrays(void);
+static void intern_component_codes(void);
 static void adjust_r_value_per_inch_for_compression(void);
 static void adjust_free_heat_for_occupancy(void);
 
 /***************************************************************************
- ** Function Name: run_mhea
- **          Date: January 26, 2000
- **     Author(s): Mark Fishbaugher
+ ** Function Name: run_mhea_first_pass
  **
- **  DESCRIPTION:  Heart of the MHEA analysis engine
+ **  DESCRIPTION:  The start of run_mhea(), through the base case and the
+ **                first pass: mir->Results are then each measure evaluated
+ **                on its own, in SIR order.  No results are put in mor.
  **************************************************************************/
-void run_mhea(void) {
+void run_mhea_first_pass(void) {
+
+  phase_begin(PP_TRANSLATION); // the audit into the values the passes work from
 
   fill_static_global_arrays();
 
@@ -48,7 +51,11 @@ void run_mhea(void) {
   ASSERT(mir, sprintf(msg, "You must have MHEA intermediate result structure to run engine"));
   ASSERT(mor, sprintf(msg, "You must have MHEA output result structure to run engine"));
 
+  intern_component_codes();
+
+  phase_begin(PP_WEATHER_LOAD);
   read_weather_file(&mdi->wth);
+  phase_end(PP_WEATHER_LOAD);
 
   initialize_fuel_cost_data(mdi->fcs, mdi->fer, 1.0f + (mdi->key.real_discount_rate / 100.0f));
 
@@ -84,6 +91,8 @@ void run_mhea(void) {
       fprintf(stderr, "%7.1f\n", mir->door_cfm_adjustment * 100.);
     }
   }
+
+  phase_end(PP_TRANSLATION);
   
   mir->flgWhichPass = BASE_CASE;
 
@@ -94,7 +103,9 @@ void run_mhea(void) {
     fprintf(stderr, "\n\nBASE_CASE");
   }
 
+  phase_begin(PP_BASE_CASE);
   mhea_energy_use();    // first call to establish untouched dwelling base case
+  phase_end(PP_BASE_CASE);
 
   if (cmds.debug_level & D_NORMAL) {
     fprintf(stderr, "\n\nAnnual Heating kBtu: %8.1f  Annual Cooling kBtu: %8.1f", mir->fHeating_Energy/1000, mir->fCooling_Energy/1000);
@@ -109,21 +120,46 @@ void run_mhea(void) {
   if (cmds.debug_level & D_NORMAL)
     fprintf(stderr, "\n\nFIRST_PASS");
 
-  first_pass_retrofits();
+  phase_begin(PP_FIRST_PASS);
+  if (!load_cached_first_pass()) { // -q, a dwelling seen before
+    first_pass_retrofits();
+    store_cached_first_pass();
+  }
+  phase_end(PP_FIRST_PASS);
+
+  return;
+}
+
+/***************************************************************************
+ ** Function Name: run_mhea
+ **          Date: January 26, 2000
+ **     Author(s): Mark Fishbaugher
+ **
+ **  DESCRIPTION:  Heart of the MHEA analysis engine
+ **************************************************************************/
+void run_mhea(void) {
+
+  run_mhea_first_pass();
 
   mir->flgWhichPass = CUMULATIVE; /* For Cumulative Pass Retrofit Calculations */
 
   if (cmds.debug_level & D_NORMAL)
     fprintf(stderr, "\n\nCUMULATIVE");
 
+  phase_begin(PP_INTERACTION_PASS);
   cumulative_retrofits();
 
   get_base_load();
+  phase_end(PP_INTERACTION_PASS);
 
+  phase_begin(PP_REPORT);
   mhea_results(FALSE);
+  phase_end(PP_REPORT);
 
   if (mdi->gnl.do_billing_adjust == YES) {      // adjustment run is optional
+    phase_begin(PP_BILLING_ADJUST);
     manage_mhea_billing_adjustments();
+    phase_end(PP_BILLING_ADJUST);
 
     // only proceed with the adjustment runs if we return from the
     // above call with non-unity factors (ie. there is billing data)
@@ -152,8 +188,19 @@ void run_mhea(void) {
       // let's use the un-adjusted heating and cooling figures on our
       // first pass. Shouldn't affect the ordering of measures.
       // Otherwise would need to feed fAdj_* values into routine.
-
-      first_pass_retrofits();
+      // Since the factors are not used, the pass would repeat the
+      // unadjusted one exactly, so its results are reused.  The pass
+      // is repeated when debugging so the diagnostic dumps are complete,
+      // and D_FIRST_PASS_REUSE checks the reuse against the repeat.
+
+      phase_begin(PP_FIRST_PASS);
+      if (cmds.debug_level & D_FIRST_PASS_REUSE)
+        check_first_pass_reuse();
+      else if (cmds.debug_level)
+        first_pass_retrofits();
+      else
+        reuse_first_pass_retrofits();
+      phase_end(PP_FIRST_PASS);
 
       mir->flgWhichPass = CUMULATIVE; /* For Cumulative Pass Retrofit Calculations */
 
@@ -164,7 +211,9 @@ void run_mhea(void) {
       mir->fPre_Heating = mir->fHeating_Energy * mir->fAdj_Htg;
       mir->fPre_Cooling = mir->fCooling_Energy * mir->fAdj_Clg;
 
+      phase_begin(PP_INTERACTION_PASS);
       cumulative_retrofits();
+      phase_end(PP_INTERACTION_PASS);
 
       if (mor->num_measure > 0) // get rid of any unadjusted results
         mor->num_measure = 0;
@@ -173,11 +222,26 @@ void run_mhea(void) {
       /* the unadjusted measure results, MJF 5/06                 */
       memset(mor->measure, 0, MAXECMS * sizeof(MHEA_MEASURE));
 
+      phase_begin(PP_REPORT);
       mhea_results(TRUE);
+      phase_end(PP_REPORT);
 
     }
   } // end 'with billing adjustment' runs
 
+  phase_begin(PP_OPTIMIZE);
+  if (cmds.package_search_seconds > 0.0f)
+    optimize_mhea_package(cmds.package_search_seconds); // most savings within the spending limit
+
+  if (cmds.package_frontier)
+    trace_mhea_frontier(); // packages no other saves more than for the money
+
+  if (mdi->num_scn > 0)
+    evaluate_mhea_scenarios(); // ranking and package at the fuel costs of each scenario
+  phase_end(PP_OPTIMIZE);
+
+  energy_memo_report();
+
   return;
 }
 
@@ -225,6 +289,17 @@ static void adjust_free_heat_for_occupancy(void) {
   }
 }
 
+// Tag each window and door with its interned component code so the cumulative
+// pass can test measure membership against the measure's component set
+static void intern_component_codes(void) {
+  reset_component_codes();
+  for (int i = 0; i < mdi->num_win; i++) mdi->win[i].code_id = component_code_id(mdi->win[i].code);
+  for (int i = 0; i < mdi->num_awn; i++) mdi->awn[i].code_id = component_code_id(mdi->awn[i].code);
+  for (int i = 0; i < mdi->num_dor; i++) mdi->dor[i].code_id = component_code_id(mdi->dor[i].code);
+  for (int i = 0; i < mdi->num_adr; i++) mdi->adr[i].code_id = component_code_id(mdi->adr[i].code);
+  for (int i = 0; i < mdi->num_ltg; i++) component_code_id(mdi->ltg[i].code);
+}
+
 static void fill_static_global_arrays() {
 
   mir->fRinFGCompressed = R_PER_INCH_FG_COMPRESSED;
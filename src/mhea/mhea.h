@@ -10,5 +10,6 @@
 #define _MHEA_H
 
 void run_mhea(void);
+void run_mhea_first_pass(void);
 
 #endif
@@ -0,0 +1,614 @@
+/***************************************************************************
+* MODULE:       optimize.c            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        Budget package for MHEA.  The cumulative pass builds the
+*               package greedily in SIR order.  Here the measures of the
+*               first pass are instead packed like a knapsack: the most
+*               present worth of savings whose cost fits the spending
+*               limit, never with a measure the measure functions would
+*               keep out given one ahead of it (see mhea_measure_keeps_out()).
+*
+*               A branch and bound search over an estimate of the
+*               interacted savings picks the measures, then the
+*               cumulative pass is run on just those to evaluate them
+*               in full.  The estimate combines the fractions of heating
+*               and cooling energy each measure saves on its own as
+*               1 - (1 - f1)(1 - f2)..., sharing the combined savings
+*               out in proportion; baseload savings just add up.  A
+*               measure never adds more than its own savings to a
+*               package, which bounds the search.
+*
+*               The package frontier is every package that no other
+*               saves more for the same or less money.  It is traced
+*               over the same estimate a measure at a time, keeping only
+*               the partial packages no other dominates, then each
+*               package on it is run through the cumulative pass.
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "wa_engine.h"
+
+#define FRONTIER_WORDS ((MAXECMS + 63) / 64)
+#define FRONTIER_MAX_LABELS 4096 // partial packages kept while tracing the frontier
+
+typedef struct {
+  int result;     // index into the first pass mir->Results
+  float cost;     // initial cost ($)
+  float pv_other; // present worth of savings that just add up ($)
+  float pv_htg;   // and of heating savings, shared out as measures combine
+  float pv_clg;   // and of cooling savings
+  float frac_htg; // fraction of the heating energy it saves on its own
+  float frac_clg; // and of the cooling energy
+  float bound;    // most it can add to a package ($)
+} CANDIDATE;
+
+typedef struct { // savings of a package, built up one measure at a time
+  double pv_other;
+  double pv_htg, sum_htg, keep_htg; // keep is the product of (1 - fraction)
+  double pv_clg, sum_clg, keep_clg;
+} PACKAGE_SAVINGS;
+
+typedef struct { // a package of candidates on the way to the frontier
+  unsigned long long chosen[FRONTIER_WORDS];  // bit for each candidate in it
+  unsigned long long blocked[FRONTIER_WORDS]; // and for each one they keep out
+  double cost;                                // of the chosen candidates ($)
+  double value;                               // estimated present worth of savings ($)
+  PACKAGE_SAVINGS pkg;
+} FRONTIER_LABEL;
+
+static struct {
+  CANDIDATE *cand;   // in decreasing bound per dollar
+  int num;
+  char *exclusive;   // num by num, pairs that can not both be chosen
+  int *chosen;       // current branch
+  int num_chosen;
+  int *best;         // best package found
+  int num_best;
+  double best_value;
+  clock_t stop;      // out of time
+  long nodes;
+  int timed_out;
+} search;
+
+static double gather_candidates(int *keep, PACKAGE_SAVINGS *base);
+static int keeps_out(int a, int b);
+static void free_candidates(void);
+static int candidate_ranks_before(const void *a, const void *b);
+static void add_candidate(PACKAGE_SAVINGS *pkg, const CANDIDATE *c);
+static double package_value(const PACKAGE_SAVINGS *pkg);
+static double remaining_bound(int k, double cost_left);
+static void branch(int k, PACKAGE_SAVINGS pkg, double cost_left);
+static int label_ranks_before(const void *a, const void *b);
+static int prune_labels(FRONTIER_LABEL *label, int num, int k, int exact);
+static double frontier_point(MHEA_FRONTIER *frontier, MHEA_FRONTIER_POINT *point);
+static int frontier_measure(MHEA_FRONTIER *frontier, const BCR_RES *res);
+
+/***************************************************************************
+ ** Function Name: optimize_mhea_package
+ **
+ **  DESCRIPTION:  Find the package of most savings within the spending
+ **                limit (key_parameters.spending_limit) and put it in
+ **                mor->budget.  Called after the SIR ordered package is
+ **                complete; mir and mor are left as they were.  Required
+ **                measures are always in the package and itemized costs
+ **                always paid, both out of the limit.  The search stops
+ **                after seconds of processor time with the best package
+ **                found so far.
+ **************************************************************************/
+void optimize_mhea_package(float seconds) {
+  MHEA_BUDGET_PACKAGE budget;
+  MIR *saved_mir;
+  MOR *saved_mor;
+  PACKAGE_SAVINGS base;
+  int keep[MAXECMS];
+  double cost_left;
+
+  ASSERT((saved_mir = (MIR *)malloc(sizeof(MIR))), sprintf(msg, "Out of memory on MIR"));
+  ASSERT((saved_mor = (MOR *)malloc(sizeof(MOR))), sprintf(msg, "Out of memory on MOR"));
+  *saved_mir = *mir;
+  *saved_mor = *mor;
+
+  memset(&budget, 0, sizeof(budget));
+  budget.optimized = TRUE;
+  budget.budget = mdi->key.spending_limit;
+  cost_left = mdi->key.spending_limit;
+
+  for (int i = 0; i < mir->Rndx; i++) // the itemized costs the cumulative pass adds
+    if (mir->Results[i].measure_id == M_CMS_ITEMIZED_COST)
+      cost_left -= mir->Results[i].fInitCost;
+
+  // the candidates, each as the first pass evaluated it on its own
+
+  cost_left -= gather_candidates(keep, &base);
+
+  search.best_value = -1.0;
+  search.stop = clock() + (clock_t)(seconds * CLOCKS_PER_SEC);
+  branch(0, base, cost_left);
+
+  for (int i = 0; i < search.num_best; i++)
+    keep[search.cand[search.best[i]].result] = TRUE;
+
+  budget.complete = !search.timed_out;
+  budget.estimate = (float)search.best_value;
+
+  if (cmds.debug_level & D_NORMAL)
+    fprintf(stderr, "\n\nBUDGET PACKAGE: %d of %d measures, %ld nodes%s", search.num_best, search.num, search.nodes,
+            search.timed_out ? " (out of time)" : "");
+
+  // the full evaluation of the chosen measures
+
+  budget_package_retrofits(keep);
+
+  for (int i = 0; i < mir->Rndx; i++) {
+    BCR_RES *res = &mir->Results[i];
+    MHEA_ECONOMICS *m = &budget.measure[budget.num_measure++];
+
+    m->index = budget.num_measure;
+    m->group = measure_package_group(res->measure_priority);
+    STRCPY(m->measure, res->sName);
+    STRCPY(m->components, res->sComponents);
+    m->savings = res->fCostAnnSavTot;
+    m->cost = res->fInitCost;
+    m->sir = res->fBCR;
+    m->csav = res->fTotAnnualSav;
+    m->ccost = res->fTotInitCost;
+    m->csir = res->fTotSIR;
+
+    budget.cost += res->fInitCost;
+    budget.savings += res->fCostAnnSavTot;
+    budget.sir += res->fCostSavTot; // present worth for now
+  }
+  budget.sir = budget.cost > 0.0f ? budget.sir / budget.cost : 0.0f;
+
+  free_candidates();
+
+  *mir = *saved_mir;
+  *mor = *saved_mor;
+  mor->budget = budget;
+  free(saved_mir);
+  free(saved_mor);
+}
+
+/***************************************************************************
+ ** Function Name: trace_mhea_frontier
+ **
+ **  DESCRIPTION:  Find the packages of the cost versus savings frontier
+ **                and put them in mor->frontier, cheapest first.  Called
+ **                after the SIR ordered package is complete; mir and mor
+ **                are left as they were.  Required measures are in every
+ **                package, no package has two measures that keep each
+ **                other out, and itemized costs are always paid.
+ **
+ **                The frontier is traced over the estimate: candidates
+ **                are added in turn to each partial package that can take
+ **                them, and a partial package is dropped when another
+ **                costs no more, saves no less and keeps out none of the
+ **                candidates still to come that it can take.  The cheapest
+ **                package on the estimated frontier, then the next, are
+ **                each evaluated with the cumulative pass; as the packages
+ **                grow a measure or two at a time most of its energy use
+ **                calls come from the memo.  Packages the full evaluation
+ **                shows dominated are dropped.  The SIR ordered package is
+ **                one of them unless another dominates it.  An estimated
+ **                frontier of more packages than MHEA_MAX_FRONTIER is
+ **                sampled evenly along it.
+ **************************************************************************/
+void trace_mhea_frontier(void) {
+  MHEA_FRONTIER *frontier;
+  MHEA_FRONTIER_MEASURE *measure;
+  MIR *saved_mir;
+  MOR *saved_mor;
+  PACKAGE_SAVINGS base;
+  FRONTIER_LABEL *label;
+  unsigned long long(*excl)[FRONTIER_WORDS];
+  int required[MAXECMS], keep[MAXECMS], used[MAXECMS + 1];
+  int num_label, num_estimated, num_point, num, num_used = 0;
+  double pv[MHEA_MAX_FRONTIER];
+  double best;
+
+  ASSERT((saved_mir = (MIR *)malloc(sizeof(MIR))), sprintf(msg, "Out of memory on MIR"));
+  ASSERT((saved_mor = (MOR *)malloc(sizeof(MOR))), sprintf(msg, "Out of memory on MOR"));
+  ASSERT((frontier = (MHEA_FRONTIER *)calloc(1, sizeof(MHEA_FRONTIER))), sprintf(msg, "Out of memory on the package frontier"));
+  *saved_mir = *mir;
+  *saved_mor = *mor;
+
+  frontier->traced = TRUE;
+  frontier->complete = TRUE;
+
+  pv[0] = frontier_point(frontier, &frontier->point[0]); // the SIR ordered package, ahead of any the same
+  frontier->point[0].estimate = (float)pv[0];
+  frontier->point[0].sir_ranked = TRUE;
+  num_point = 1;
+
+  gather_candidates(required, &base); // what every package pays for is the same, so not counted
+
+  ASSERT((label = (FRONTIER_LABEL *)calloc(2 * FRONTIER_MAX_LABELS, sizeof(FRONTIER_LABEL))) &&
+             (excl = calloc(search.num + 1, sizeof(*excl))),
+         sprintf(msg, "Out of memory on the package frontier"));
+  for (int a = 0; a < search.num; a++)
+    for (int b = 0; b < search.num; b++)
+      if (search.exclusive[a * search.num + b])
+        excl[a][b / 64] |= 1ULL << (b % 64);
+
+  // the estimated frontier, a candidate at a time
+
+  num_label = 1;
+  label[0].pkg = base;
+  label[0].value = package_value(&base);
+  for (int a = 0; a < search.num; a++) // what a required measure keeps out
+    if (search.exclusive[a * search.num + a])
+      label[0].blocked[a / 64] |= 1ULL << (a % 64);
+
+  for (int k = 0; k < search.num; k++) {
+    int num = num_label;
+
+    for (int l = 0; l < num; l++) {
+      FRONTIER_LABEL *with;
+      if (label[l].blocked[k / 64] & (1ULL << (k % 64)))
+        continue;
+      with = &label[num_label++];
+      *with = label[l];
+      with->chosen[k / 64] |= 1ULL << (k % 64);
+      for (int w = 0; w < FRONTIER_WORDS; w++)
+        with->blocked[w] |= excl[k][w];
+      with->cost += search.cand[k].cost;
+      add_candidate(&with->pkg, &search.cand[k]);
+      with->value = package_value(&with->pkg);
+    }
+
+    num_label = prune_labels(label, num_label, k + 1, TRUE);
+    if (num_label > FRONTIER_MAX_LABELS) { // too many to keep the exclusions apart
+      num_label = prune_labels(label, num_label, k + 1, FALSE);
+      frontier->complete = FALSE;
+    }
+    if (num_label > FRONTIER_MAX_LABELS) { // or at all, keep them evenly by cost
+      for (int l = 0; l < FRONTIER_MAX_LABELS; l++)
+        label[l] = label[(int)((double)l * (num_label - 1) / (FRONTIER_MAX_LABELS - 1) + 0.5)];
+      num_label = FRONTIER_MAX_LABELS;
+    }
+  }
+
+  num_estimated = num_label;
+  if (num_label > MHEA_MAX_FRONTIER - 1) { // leaving room for the SIR ordered package
+    for (int l = 0; l < MHEA_MAX_FRONTIER - 1; l++)
+      label[l] = label[(int)((double)l * (num_label - 1) / (MHEA_MAX_FRONTIER - 2) + 0.5)];
+    num_label = MHEA_MAX_FRONTIER - 1;
+    frontier->complete = FALSE;
+  }
+
+  if (cmds.debug_level & D_NORMAL)
+    fprintf(stderr, "\n\nPACKAGE FRONTIER: %d of %d estimated packages of %d candidates%s", num_label, num_estimated,
+            search.num, frontier->complete ? "" : " (sampled)");
+
+  // the full evaluation of each package, cheapest first
+
+  for (int l = 0; l < num_label; l++) {
+    memcpy(keep, required, sizeof(keep));
+    for (int c = 0; c < search.num; c++)
+      if (label[l].chosen[c / 64] & (1ULL << (c % 64)))
+        keep[search.cand[c].result] = TRUE;
+
+    budget_package_retrofits(keep);
+
+    pv[num_point] = frontier_point(frontier, &frontier->point[num_point]);
+    frontier->point[num_point++].estimate = (float)label[l].value;
+  }
+
+  // the cumulative pass may drop measures, so drop what now is dominated
+
+  for (int p = 1; p < num_point; p++) { // cheapest first, the most savings first on ties
+    MHEA_FRONTIER_POINT point = frontier->point[p];
+    double value = pv[p];
+    int j = p;
+    for (; j > 0 && (frontier->point[j - 1].cost > point.cost ||
+                     (frontier->point[j - 1].cost == point.cost && pv[j - 1] < value));
+         j--) {
+      frontier->point[j] = frontier->point[j - 1];
+      pv[j] = pv[j - 1];
+    }
+    frontier->point[j] = point;
+    pv[j] = value;
+  }
+  best = -HUGE_VAL;
+  num = num_point;
+  num_point = 0;
+  for (int p = 0; p < num; p++) {
+    if (pv[p] > best + 0.005) {
+      frontier->point[num_point++] = frontier->point[p];
+      best = pv[p];
+    }
+  }
+  frontier->num_point = num_point;
+
+  // only the measures of the packages kept, in first appearance order
+
+  ASSERT((measure = (MHEA_FRONTIER_MEASURE *)malloc(MAXECMS * sizeof(MHEA_FRONTIER_MEASURE))),
+         sprintf(msg, "Out of memory on the package frontier"));
+  memcpy(measure, frontier->measure, frontier->num_measure * sizeof(MHEA_FRONTIER_MEASURE));
+  memset(used, 0, sizeof(used));
+  for (int p = 0; p < num_point; p++) {
+    MHEA_FRONTIER_POINT *point = &frontier->point[p];
+    for (int m = 0; m < point->num_measure; m++) {
+      if (used[point->measure[m]] == 0) {
+        used[point->measure[m]] = ++num_used;
+        frontier->measure[num_used - 1] = measure[point->measure[m] - 1];
+        frontier->measure[num_used - 1].index = num_used;
+      }
+      point->measure[m] = (short)used[point->measure[m]];
+    }
+  }
+  frontier->num_measure = num_used;
+
+  free(measure);
+  free(label);
+  free(excl);
+  free_candidates();
+
+  *mir = *saved_mir;
+  *mor = *saved_mor;
+  mor->frontier = *frontier;
+  free(frontier);
+  free(saved_mir);
+  free(saved_mor);
+}
+
+// The first pass measures that can go in a package, each as the first pass
+// evaluated it on its own, into search.cand in decreasing bound per dollar
+// with the pairs that exclude each other.  Sets keep[] (indexed as the first
+// pass mir->Results) for the required measures and base to their savings.
+// Leaves the first pass results in mir and returns the required cost.
+static double gather_candidates(int *keep, PACKAGE_SAVINGS *base) {
+  int forced[MAXECMS];
+  int num_forced = 0;
+  double forced_cost = 0.0;
+
+  memset(base, 0, sizeof(PACKAGE_SAVINGS));
+  base->keep_htg = base->keep_clg = 1.0;
+
+  restore_first_pass_mir();
+
+  memset(&search, 0, sizeof(search));
+  ASSERT((search.cand = (CANDIDATE *)calloc(MAXECMS, sizeof(CANDIDATE))) &&
+             (search.chosen = (int *)calloc(MAXECMS, sizeof(int))) &&
+             (search.best = (int *)calloc(MAXECMS, sizeof(int))),
+         sprintf(msg, "Out of memory on the budget package search"));
+
+  for (int i = 0; i < mir->Rndx; i++) {
+    BCR_RES *res = &mir->Results[i];
+    CANDIDATE c;
+
+    keep[i] = FALSE;
+    if (res->measure_id == M_CMS_ITEMIZED_COST)
+      continue;
+
+    memset(&c, 0, sizeof(c));
+    c.result = i;
+    c.cost = res->fInitCost;
+    c.pv_other = res->fCostSavTot;
+    if (res->fCostAnnSavTot != 0.0f) {
+      float pv_htg = res->fCostSavTot * res->fCostSavHtg / res->fCostAnnSavTot;
+      float pv_clg = res->fCostSavTot * res->fCostSavClg / res->fCostAnnSavTot;
+      if (res->fEnerPreHtg > 0.0f && res->fEnerPstHtg < res->fEnerPreHtg) {
+        c.frac_htg = MIN(1.0f - res->fEnerPstHtg / res->fEnerPreHtg, 0.999f);
+        c.pv_htg = pv_htg;
+        c.pv_other -= pv_htg;
+      }
+      if (res->fEnerPreClg > 0.0f && res->fEnerPstClg < res->fEnerPreClg) {
+        c.frac_clg = MIN(1.0f - res->fEnerPstClg / res->fEnerPreClg, 0.999f);
+        c.pv_clg = pv_clg;
+        c.pv_other -= pv_clg;
+      }
+    }
+    c.bound = MAX(res->fCostSavTot, 0.0f);
+
+    if (res->measure_required) { // always in, out of the limit
+      keep[i] = TRUE;
+      forced[num_forced++] = i;
+      add_candidate(base, &c);
+      forced_cost += c.cost;
+    } else if (res->fBCR * MHEASAVINGSADJ >= mdi->key.minimum_acceptable_sir && c.bound > 0.0f) {
+      search.cand[search.num++] = c; // the cumulative pass would drop anything less
+    }
+  }
+
+  qsort(search.cand, search.num, sizeof(CANDIDATE), candidate_ranks_before);
+
+  ASSERT((search.exclusive = (char *)calloc((size_t)search.num * search.num + 1, 1)),
+         sprintf(msg, "Out of memory on the budget package search"));
+  for (int a = 0; a < search.num; a++) {
+    int ra = search.cand[a].result;
+    for (int b = 0; b < search.num; b++)
+      search.exclusive[a * search.num + b] = (char)keeps_out(ra, search.cand[b].result);
+    for (int f = 0; f < num_forced; f++) // nothing that a required measure keeps out
+      if (keeps_out(ra, forced[f]))
+        search.exclusive[a * search.num + a] = TRUE;
+  }
+
+  return forced_cost;
+}
+
+// The package runs through the cumulative pass in first pass order, so of
+// two first pass results the earlier may keep the later out
+static int keeps_out(int a, int b) {
+  if (a > b)
+    return keeps_out(b, a);
+  return mhea_measure_keeps_out(&mir->Results[a], &mir->Results[b]);
+}
+
+static void free_candidates(void) {
+  free(search.cand);
+  free(search.chosen);
+  free(search.best);
+  free(search.exclusive);
+}
+
+// most savings per dollar first, free measures ahead of all
+static int candidate_ranks_before(const void *a, const void *b) {
+  const CANDIDATE *ca = (const CANDIDATE *)a, *cb = (const CANDIDATE *)b;
+  double ra = ca->cost > 0.0f ? ca->bound / ca->cost : HUGE_VAL;
+  double rb = cb->cost > 0.0f ? cb->bound / cb->cost : HUGE_VAL;
+
+  if (ra != rb)
+    return (ra < rb) ? 1 : -1;
+  return ca->result - cb->result; // first pass order on ties
+}
+
+static void add_candidate(PACKAGE_SAVINGS *pkg, const CANDIDATE *c) {
+  pkg->pv_other += c->pv_other;
+  pkg->pv_htg += c->pv_htg;
+  pkg->sum_htg += c->frac_htg;
+  pkg->keep_htg *= 1.0 - c->frac_htg;
+  pkg->pv_clg += c->pv_clg;
+  pkg->sum_clg += c->frac_clg;
+  pkg->keep_clg *= 1.0 - c->frac_clg;
+}
+
+// estimated present worth of savings of the package
+static double package_value(const PACKAGE_SAVINGS *pkg) {
+  double value = pkg->pv_other;
+
+  if (pkg->sum_htg > 0.0)
+    value += pkg->pv_htg * (1.0 - pkg->keep_htg) / pkg->sum_htg;
+  if (pkg->sum_clg > 0.0)
+    value += pkg->pv_clg * (1.0 - pkg->keep_clg) / pkg->sum_clg;
+  return value;
+}
+
+// Most the candidates from k on could add within cost_left, taking the
+// last one that fits in part
+static double remaining_bound(int k, double cost_left) {
+  double bound = 0.0;
+
+  for (; k < search.num && cost_left > 0.0; k++) {
+    CANDIDATE *c = &search.cand[k];
+    if (c->cost <= cost_left) {
+      bound += c->bound;
+      cost_left -= c->cost;
+    } else {
+      bound += c->bound * cost_left / c->cost;
+      break;
+    }
+  }
+  return bound;
+}
+
+// Decide candidate k and on, the package so far has savings pkg
+static void branch(int k, PACKAGE_SAVINGS pkg, double cost_left) {
+  double value = package_value(&pkg);
+  CANDIDATE *c;
+  int fits;
+
+  if (search.timed_out)
+    return;
+  if ((++search.nodes & 1023) == 0 && clock() > search.stop) {
+    search.timed_out = TRUE;
+    return;
+  }
+
+  if (value > search.best_value) {
+    search.best_value = value;
+    search.num_best = search.num_chosen;
+    memcpy(search.best, search.chosen, search.num_chosen * sizeof(int));
+  }
+  if (k == search.num || value + remaining_bound(k, cost_left) <= search.best_value + 0.005)
+    return;
+
+  c = &search.cand[k];
+  fits = c->cost <= cost_left && !search.exclusive[k * search.num + k];
+  for (int j = 0; fits && j < search.num_chosen; j++)
+    fits = !search.exclusive[k * search.num + search.chosen[j]];
+
+  if (fits) { // with candidate k first, it is the better bet
+    PACKAGE_SAVINGS with = pkg;
+    add_candidate(&with, c);
+    search.chosen[search.num_chosen++] = k;
+    branch(k + 1, with, cost_left - c->cost);
+    search.num_chosen--;
+  }
+  branch(k + 1, pkg, cost_left);
+}
+
+// cheapest first, the most savings first on ties
+static int label_ranks_before(const void *a, const void *b) {
+  const FRONTIER_LABEL *la = (const FRONTIER_LABEL *)a, *lb = (const FRONTIER_LABEL *)b;
+
+  if (la->cost != lb->cost)
+    return (la->cost > lb->cost) ? 1 : -1;
+  if (la->value != lb->value)
+    return (la->value < lb->value) ? 1 : -1;
+  return 0;
+}
+
+// Drop the partial packages another dominates, keeping the rest cheapest
+// first, and return how many are kept.  When exact, a package only
+// dominates if it keeps out none of candidates k on the other can take.
+static int prune_labels(FRONTIER_LABEL *label, int num, int k, int exact) {
+  unsigned long long future[FRONTIER_WORDS];
+  int kept = 0;
+
+  for (int w = 0; w < FRONTIER_WORDS; w++) {
+    int first = k - 64 * w;
+    future[w] = first <= 0 ? ~0ULL : first >= 64 ? 0ULL : ~0ULL << first;
+  }
+
+  qsort(label, num, sizeof(FRONTIER_LABEL), label_ranks_before);
+
+  for (int l = 0; l < num; l++) {
+    int dominated = FALSE;
+
+    for (int j = kept - 1; j >= 0 && !dominated; j--) {
+      if (label[j].value + 0.005 < label[l].value)
+        continue;
+      dominated = TRUE;
+      for (int w = 0; exact && w < FRONTIER_WORDS && dominated; w++)
+        dominated = (label[j].blocked[w] & ~label[l].blocked[w] & future[w]) == 0;
+    }
+    if (!dominated)
+      label[kept++] = label[l];
+  }
+  return kept;
+}
+
+// The package now in mir->Results as a point of the frontier, returning its
+// present worth of savings
+static double frontier_point(MHEA_FRONTIER *frontier, MHEA_FRONTIER_POINT *point) {
+  double pv = 0.0;
+
+  memset(point, 0, sizeof(MHEA_FRONTIER_POINT));
+  for (int i = 0; i < mir->Rndx; i++) {
+    BCR_RES *res = &mir->Results[i];
+    point->measure[point->num_measure++] = (short)frontier_measure(frontier, res);
+    point->cost += res->fInitCost;
+    point->savings += res->fCostAnnSavTot;
+    pv += res->fCostSavTot;
+  }
+  point->sir = point->cost > 0.0f ? (float)(pv / point->cost) : 0.0f;
+  return pv;
+}
+
+// Index, base 1, of the measure in the frontier's measures, added when new
+static int frontier_measure(MHEA_FRONTIER *frontier, const BCR_RES *res) {
+  MHEA_FRONTIER_MEASURE *m;
+
+  for (int i = 0; i < frontier->num_measure; i++) {
+    m = &frontier->measure[i];
+    if (m->measure_id == res->measure_id && m->cost == res->fInitCost && strcmp(m->measure, res->sName) == 0 &&
+        strcmp(m->components, res->sComponents) == 0)
+      return m->index;
+  }
+
+  ASSERT(frontier->num_measure < MAXECMS, sprintf(msg, "Too many measures on the package frontier"));
+  m = &frontier->measure[frontier->num_measure++];
+  m->index = frontier->num_measure;
+  m->measure_id = res->measure_id;
+  STRCPY(m->measure, res->sName);
+  STRCPY(m->components, res->sComponents);
+  m->cost = res->fInitCost;
+  m->sir = res->fBCR;
+  return m->index;
+}
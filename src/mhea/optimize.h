@@ -0,0 +1,15 @@
+/***************************************************************************
+* MODULE:       optimize.h            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        Budget constrained MHEA measure package and the package
+*               frontier
+****************************************************************************/
+#ifndef _OPTIMIZE_H
+#define _OPTIMIZE_H
+
+void optimize_mhea_package(float seconds);
+void trace_mhea_frontier(void);
+
+#endif
@@ -10,6 +10,11 @@
 #ifndef _RESULTM_H
 #define _RESULTM_H
 
+// notices given at most once a run, bits of once_message
+#define MSG_ONCE_INFILTRATION_REDUCTION 1 // infiltration reduction done in parallel
+#define MSG_ONCE_TUNEUP_NO_GAIN 2         // required heating tune up gains nothing
+#define MSG_ONCE_ZERO_INFILTRATION 4      // window and door leakage exceeds the blower door
+
 // the first structure here is a combined measure structure that includes
 // description, energy savings, economic savings, and material info.
 
@@ -124,6 +129,79 @@ typedef struct {
   float post_load;                    // post_retrofit peak load (BTU/hr)
 } MHEA_MANJ;               // manual J output
 
+// The most savings package within the spending limit (see optimize.c), only
+// filled in when asked for on the command line
+
+typedef struct {
+  int optimized;           // a budget package was searched for
+  int complete;            // the search finished inside its time budget
+  float budget;            // the spending limit ($)
+  float estimate;          // estimated present worth of savings of the chosen measures ($)
+  float cost;              // total initial cost of the package after the full evaluation ($)
+  float savings;           // total annual savings ($)
+  float sir;               // present worth of savings over cost
+  int num_measure;         // measures in the package
+  MHEA_ECONOMICS measure[MAXECMS]; // and their economics
+} MHEA_BUDGET_PACKAGE;
+
+// The packages of the cost versus savings frontier (see optimize.c), only
+// filled in when asked for on the command line
+
+typedef struct {
+  int index;            // order of appearance, base 1
+  int measure_id;       // input JSON measure_flag[] array index
+  char measure[MEASURENAME_LEN + 1]; // name of measure
+  char components[STRING_LEN];       // list of component codes effected
+  float cost;           // initial cost
+  float sir;            // savings to investment ratio on its own
+} MHEA_FRONTIER_MEASURE;
+
+typedef struct {
+  float cost;           // total initial cost of the package ($)
+  float savings;        // total annual savings after the full evaluation ($)
+  float sir;            // present worth of savings over cost
+  float estimate;       // estimated present worth of savings ($)
+  int sir_ranked;       // the package of the SIR ordered cumulative pass
+  int num_measure;      // measures in the package
+  short measure[MAXECMS]; // their MHEA_FRONTIER_MEASURE index, in package order
+} MHEA_FRONTIER_POINT;
+
+typedef struct {
+  int traced;           // the frontier was asked for
+  int complete;         // every package on the estimated frontier was evaluated
+  int num_measure;      // measures in any of the packages
+  MHEA_FRONTIER_MEASURE measure[MAXECMS];
+  int num_point;        // packages, cheapest first
+  MHEA_FRONTIER_POINT point[MHEA_MAX_FRONTIER];
+} MHEA_FRONTIER;
+
+// The audit's measures evaluated at the fuel costs of an economic scenario
+// (see scenario.c), only filled in when the audit lists scenarios
+
+typedef struct {
+  int rank;             // place in the scenario's SIR order, base 1, 0 if
+                        // added by the cumulative pass (itemized costs)
+  int measure_id;       // input JSON measure_flag[] array index
+  char measure[MEASURENAME_LEN + 1]; // name of measure
+  char components[STRING_LEN];       // list of component codes effected
+  float sir;            // savings to investment ratio on its own
+  int package;          // place in the package, base 1, 0 if not kept
+  float savings;        // annual $ savings in the package
+  float cost;           // initial cost
+  float csir;           // cummulative sir in the package
+} MHEA_SCENARIO_MEASURE;
+
+typedef struct {
+  char name[MEASURENAME_LEN + 1]; // from the audit's economic_scenarios
+  float real_discount_rate;       // percent
+  float cost;                     // total initial cost of the package ($)
+  float savings;                  // total annual savings ($)
+  float sir;                      // present worth of savings over cost
+  int num_package;                // measures in the package
+  int num_measure;                // measures evaluated, in SIR order
+  MHEA_SCENARIO_MEASURE measure[MAXECMS];
+} MHEA_SCENARIO;
+
 typedef struct {
 
   int energy_calc_counter;  // how many times did the bin method energy calculation/simulation get called
@@ -151,6 +229,7 @@ typedef struct {
 
   int num_message;                        // number of extra message strings
   char message[MAXMESSAGE][MESSAGE_LEN];  // special notices and message strings from the analysis. All static strings so just store pointers
+  int once_message;                       // MSG_ONCE_ bits of the notices already given this run
 
   //int num_message;           // number of extra message strings
   //MHEA_MESSAGES message[30]; // special notices
@@ -185,6 +264,12 @@ typedef struct {
   int num_used_fuel;                  // how many fuel types were used
   USED_FUEL used_fuel[FUEL_TYPES];    // list of used fuel types and pricing used
 
+  MHEA_BUDGET_PACKAGE budget;         // optional package held to the spending limit
+  MHEA_FRONTIER frontier;             // optional cost versus savings frontier
+
+  int num_scenario;                   // economic scenarios evaluated
+  MHEA_SCENARIO scenario[MHEA_MAX_SCENARIOS];
+
 } MOR;    // Mhea Output Results
 
 #endif
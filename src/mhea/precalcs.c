@@ -23,12 +23,6 @@
 
 #include "wa_engine.h"
 
-static float rhum(float drybt, float wetbt, double alt);
-
-// This routine computes the relative humidity given the wet and dry-bulb temperatures.
-
-#define HYWEX(t) (c1 / t + c2 + c3 * t + c4 * t * t + c5 * t * t * t + c6 * log(t))
-
 /***************************************************************************
  ** Function Name: AnalysisInit
  **          Date: December 18, 1998
@@ -133,36 +127,6 @@ void analysis_initialize(void) {
 // all runtime error and completness checks are now done in the
 // database front end that calls this engine, MJF 4/25/02
 
-static float rhum(float drybt, float wetbt, double alt) {
-  double c1 = -1.044039708e4, c2 = -1.12946496e1, c3 = -2.7022355e-2, c4 = 1.289036e-5, c5 = -2.478068e-9, c6 = 6.5459673;
-  double conv = 459.67;
-  double pwsw, pwsd, patm, wsw, wsd, wnum, wden, w, mu, rh;
-
-  drybt += (float)conv;
-  wetbt += (float)conv;
-  ASSERT(wetbt != 0, sprintf(msg, "Assertion Failure"));
-  pwsw = HYWEX((double)wetbt);
-  ASSERT(drybt != 0, sprintf(msg, "Assertion Failure"));
-  pwsd = HYWEX((double)drybt);
-  pwsw = exp(pwsw);
-  pwsd = exp(pwsd);
-  patm = 14.696 * exp(-0.0000368 * alt);
-  ASSERT((patm - pwsw) != 0, sprintf(msg, "Assertion Failure"));
-  ASSERT((patm - pwsd) != 0, sprintf(msg, "Assertion Failure"));
-  wsw = 0.62198 * pwsw / (patm - pwsw);
-  wsd = 0.62198 * pwsd / (patm - pwsd);
-  wnum = (1093. - 0.556 * wetbt) * wsw - 0.24 * (drybt - wetbt);
-  wden = 1093. + 0.444 * drybt - wetbt;
-  ASSERT(wden != 0, sprintf(msg, "Assertion Failure"));
-  w = wnum / wden;
-  ASSERT(wsd != 0, sprintf(msg, "Assertion Failure"));
-  mu = w / wsd;
-  ASSERT(patm != 0, sprintf(msg, "Assertion Failure"));
-  ASSERT((1. - (1. - mu) * pwsd / patm) != 0, sprintf(msg, "Assertion Failure"));
-  rh = mu / (1. - (1. - mu) * pwsd / patm);
-  return ((float)rh);
-}
-
 /***************************************************************************
  ** Function Name: duct_leakage_MHEA
  **          Date: July 27, 2000
@@ -317,16 +281,11 @@ void duct_leakage_MHEA(void) {
 // This routine computes duct distribution efficiencies per ASHRAE 152P given
 // the leakage of the ducts measured from three established techniques.
 
-int duct_efficiency_MHEA(float fElevation, float fW_Dsgn_T, float fS_Dsgn_T, float *Q50, float *effht, float *effcl) {
-
-  float enthalpyMHEA(float dbt, float RH, float tambR, float *wout);
+int duct_efficiency_MHEA(float fW_Dsgn_T, float fS_Dsgn_T, float *Q50, float *effht, float *effcl) {
 
-  int m, nhtm, nclm;
   int iret;
 
-  float arg, asBs, arBr, Qinf15, Qimb15, wout, wdum, win;
-  float tom, tdb_max_cl, tdb_min_ht, rhatmax;
-  float enthalpyMHEA(float dbt, float RH, float tambR, float *w);
+  float arg, asBs, arBr, Qinf15, Qimb15, wout, win;
   int compute_ducts = TRUE;
 
   //   Duct perimeters based on x-sectional area of 0.89 & 1.78 sqft for
@@ -339,7 +298,6 @@ int duct_efficiency_MHEA(float fElevation, float fW_Dsgn_T, float fS_Dsgn_T, flo
       tin_cl,          // Indoor air temperature, cooling
       tdb_ht,          // Outdoor dry bulb temperature, heating
       tdb_cl,          // Outdoor dry bulb temperature, cooling
-      RH,              // Seasonal (summer) relative humidity
                        //    fW_Dsgn_T,         // Winter design temperature
                        //    fS_Dsgn_T,         // Summer design temperature
       tground,         // Ground temperature (year-round)
@@ -511,54 +469,16 @@ int duct_efficiency_MHEA(float fElevation, float fW_Dsgn_T, float fS_Dsgn_T, flo
     //    &tdb_ht, &tdb_cl, &fW_Dsgn_T, &fS_Dsgn_T, &RH, &fAreaHome, &Ecap_ht, &Ecap_cl,
     //    &ductR_S, &Qs_ht, &Qs_cl))==11;) [if used would have squiggly bracket here]
 
-    /*  Find the average heating and cooling outdoor ambient temperatures and RH.
-     *  Cooling is average of monthly temperautures above 65 F, heating those below.
-     *  If no monthly temperatures are above or below 65 to form seasonal average,
-     *  use the maximum or minumum monthly temperatures as the average. */
-
-    tdb_ht = tdb_cl = 0.0f;
-    nhtm = nclm = 0;
-    RH = 0.0f;
-    tdb_min_ht = 100.0f;
-    tdb_max_cl = -100.0f;
-    for (m = 1; m <= MONTHS + 1 - 1; m++) {
-      //tom = mir->ftoa[m]; // changed to global 1/02
-      tom = cwd->avg_temp[m];
-      if (tom < 65.0f) {
-        if (m == DECEMBER || m < APRIL) {
-          tdb_ht += tom;
-          nhtm++;
-        }
-      }
-      if (tom < tdb_min_ht)
-        tdb_min_ht = tom;
-      if (tom > 65.0f) {
-        tdb_cl += tom;
-        RH += rhum(tom, cwd->avg_wet_temp[m], fElevation);
-        nclm++;
-      }
-      if (tom > tdb_max_cl) {
-        tdb_max_cl = tom;
-        rhatmax = rhum(tdb_max_cl, cwd->avg_wet_temp[m], fElevation);
-      }
-    }
+    // Seasonal outdoor temperatures and RH, found once per weather file by duct_psychrometrics()
 
-    if (nhtm > 0)
-      tdb_ht /= (float)nhtm;
-    else
-      tdb_ht = tdb_min_ht;
-    if (nclm > 0) {
-      tdb_cl /= (float)nclm;
-      RH /= (float)nclm;
-    } else {
-      tdb_cl = tdb_max_cl;
-      RH = rhatmax;
-    }
+    tdb_ht = cwd->duct_psy_bins.tdb_ht;
+    tdb_cl = cwd->duct_psy_bins.tdb_cl;
 
     // Derived values
 
     tground = (fW_Dsgn_T + fS_Dsgn_T) / 2.0f;
     Qinf = 8.0f * 0.35f * fAreaHome / 60;     // Based on 0.35 ACH infiltration
+    Qinf15 = (float)(POWC(Qinf, 1.5f));       // both seasons' imbalance flow, Qnet
     if (mdi->htg.duct_location == DL_FLOOR) { // Ducts in uninsulated basement
       tamb_R_ht = tamb_S_ht = (5.0f * tground + 2.0f * tdb_ht + 3.0f * tin_ht) / 10.0f;
       tamb_R_cl = tamb_S_cl = (5.0f * tground + 2.0f * tdb_cl + 3.0f * tin_cl) / 10.0f;
@@ -645,7 +565,6 @@ int duct_efficiency_MHEA(float fElevation, float fW_Dsgn_T, float fS_Dsgn_T, flo
       /***** Compute the imbalance flow, Qnet ******/
 
       Qimb = (float)(fabs((float)(Qs_ht - Qr_ht)));
-      Qinf15 = (float)(POWC(Qinf, 1.5f));
       if (Qimb < 1.0e-3)
         Qnet_ht = (float)(POWC(Qinf15, 0.67f));
       else {
@@ -751,13 +670,14 @@ int duct_efficiency_MHEA(float fElevation, float fW_Dsgn_T, float fS_Dsgn_T, flo
 
         /****** Compute the cooling season return enthalpyMHEA from psychometrics *****/
 
-        hout = enthalpyMHEA(tdb_cl, RH, tdb_cl, &wout);
+        hout = cwd->duct_psy_bins.hout;
+        wout = cwd->duct_psy_bins.w;
         win = 0.004f + 0.4f * wout; // Per e-mail of 5/22/00 from Iain Walker
         hin = 0.240f * tin_cl + win * (1061.0f + 0.444f * tin_cl);
         if (mdi->clg.duct_location == DL_FLOOR || Fout_R == 0.0)
           hamb_R = hin;
         else {
-          hamb_R = enthalpyMHEA(tdb_cl, RH, tamb_R_cl, &wdum);
+          hamb_R = moist_air_enthalpy(tamb_R_cl, wout);
           if (hamb_R < hin)
             hamb_R = (hamb_R + hout) / 2.0f;
         }
@@ -843,24 +763,3 @@ int duct_efficiency_MHEA(float fElevation, float fW_Dsgn_T, float fS_Dsgn_T, flo
 
   return (0);
 }
-
-// Compute the enthalpyMHEA of air in space where return duct runs, given outdoor
-//m dry bulb temperature and relative humidity and approximate temperature of the space.
-
-float enthalpyMHEA(float dbt, float RH, float tambR, float *wout) {
-  double c1 = -1.044039708e4, c2 = -1.12946496e1, c3 = -2.7022355e-2, c4 = 1.289036e-5, c5 = -2.478068e-9, c6 = 6.5459673;
-  double conv = 459.67;
-  float pws, pw, w, patm = 14.696f, h, dbtabs;
-
-  // printf("\n dbt = %5.1f,  RH = %5.2f,  tambR = %5.2f",dbt,RH,tambR);
-
-  dbtabs = dbt + (float)conv;
-  pws = (float)HYWEX((double)dbtabs);
-  pws = (float)exp(pws);
-  pw = RH * pws;
-  w = 0.62198f * pw / (patm - pw);
-  *wout = w;
-  h = 0.240f * tambR + w * (1061.0f + 0.444f * tambR);
-  // printf("\n pws = %8.3f,  h = %8.3f", pws,h);
-  return (h);
-}
@@ -10,6 +10,6 @@
 
 void analysis_initialize(void);
 void duct_leakage_MHEA(void);
-int duct_efficiency_MHEA(float fElevation, float fW_Dsgn_T, float fS_Dsgn_T, float *Q50, float *effht, float *effcl);
+int duct_efficiency_MHEA(float fW_Dsgn_T, float fS_Dsgn_T, float *Q50, float *effht, float *effcl);
 
 #endif  //_M_PRE_CALCS_H
\ No newline at end of file
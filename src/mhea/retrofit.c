@@ -33,13 +33,34 @@ FILE *measure_file;
 // some local functions
 
 static void sort_mhea_package_measures(int sortabs);
+static int mhea_measure_ranks_before(int a, int b, void *context);
+static int mhea_measure_ranks_before_abs(int a, int b, void *context);
+static int mixed_sign_priorities(void);
+static void bubble_sort_mhea_package_measures(int sortabs);
 static void diagnostic_results_header(void);
 static void diagnostic_results_line(int i);
+static void first_pass_report(const char *text);
+static void first_pass_report_bytes(const char *text, size_t len);
+
+// What the first pass leaves behind, kept so that the billing adjustment
+// rerun can reuse the pass instead of repeating it (see reuse_first_pass_retrofits())
+
+static struct {
+  MIR *mir;             // mir as the first pass left it
+  MIR *later;           // scratch copy of mir when the pass is reused
+  int energy_calls;     // mhea_energy_use() calls made by the pass
+  int message;          // first mor->message added by the pass
+  int num_message;      // and how many
+  int once_message;     // mor->once_message bits set by the pass
+  char *report;         // text the pass wrote to the measure report
+  size_t report_len;
+  size_t report_size;
+} first_pass;
 
 /*******************  FUNCTION NAME: SortResults         *****************/
 /**         DATE:  9/21/00                                              **/
 /**           BY:  MJF                                                  **/
-/**  DESCRIPTION:  Simple bubble sort algorithm to order the entries    **/
+/**  DESCRIPTION:  Stable ranking (see stable_rank()) to order entries  **/
 /**                in the mor array.  Note how entries with      **/
 /**                flgRequired Set are sorted to the top also in BCR    **/
 /**                order                                                **/
@@ -48,9 +69,9 @@ static void diagnostic_results_line(int i);
 /**                different order for measure evaluation and reporting **/
 /*************************************************************************/
 static void sort_mhea_package_measures(int sortabs) {
-  int flgSwap = TRUE; // did we swap in the loop
-  BCR_RES temp;    // temp structure for swapping
-  int i;
+  int rank[MAX_RANK_ITEMS];
+  int placed[MAX_RANK_ITEMS];     // entry already moved to its ranked position
+  BCR_RES temp;                   // temp structure for moving entries
 
   if (mir->Rndx < 2) // base zero counter = 1 means [0] is the only measure
     return;
@@ -68,6 +89,73 @@ static void sort_mhea_package_measures(int sortabs) {
     mir->Results[mir->Rndx].measure_priority = MPS_BOTTOM_MARK; 
   mir->Results[mir->Rndx].fBCR = MPS_BOTTOM_MARK;
 
+  // A required and a required-no-SIR measure (say +2 and -2) tie on absolute
+  // priority but never swap, so there is no consistent order for a merge to
+  // follow.  Only that mix still needs the original adjacent swap sort.
+  if (sortabs && mixed_sign_priorities()) {
+    bubble_sort_mhea_package_measures(sortabs);
+    return;
+  }
+
+  for (int i = 0; i <= mir->Rndx; i++)
+    rank[i] = i;
+
+  stable_rank(rank, mir->Rndx + 1, sortabs ? mhea_measure_ranks_before_abs : mhea_measure_ranks_before, NULL);
+
+  // move the entries into rank order following each permutation cycle
+  // so only one spare BCR_RES is ever needed
+
+  memset(placed, 0, (mir->Rndx + 1) * sizeof(int));
+
+  for (int i = 0; i <= mir->Rndx; i++) {
+    if (placed[i] || rank[i] == i)
+      continue;
+    memcpy(&temp, &mir->Results[i], sizeof(BCR_RES));
+    int hole = i;
+    while (rank[hole] != i) {
+      memcpy(&mir->Results[hole], &mir->Results[rank[hole]], sizeof(BCR_RES));
+      placed[hole] = TRUE;
+      hole = rank[hole];
+    }
+    memcpy(&mir->Results[hole], &temp, sizeof(BCR_RES));
+    placed[hole] = TRUE;
+  }
+}
+
+// entry a ranks ahead of entry b on decreasing priority then decreasing BCR
+static int mhea_measure_ranks_before(int a, int b, void *context) {
+  (void)context;
+  if (mir->Results[a].measure_priority != mir->Results[b].measure_priority)
+    return (mir->Results[a].measure_priority > mir->Results[b].measure_priority);
+  return (mir->Results[a].fBCR > mir->Results[b].fBCR);
+}
+
+// same as above but on the absolute value of the priority
+static int mhea_measure_ranks_before_abs(int a, int b, void *context) {
+  (void)context;
+  if (mir->Results[a].measure_priority != mir->Results[b].measure_priority)
+    return (abs(mir->Results[a].measure_priority) > abs(mir->Results[b].measure_priority));
+  return (mir->Results[a].fBCR > mir->Results[b].fBCR);
+}
+
+// true if two entries have priorities of the same absolute value but opposite sign
+static int mixed_sign_priorities(void) {
+  unsigned int positive = 0, negative = 0;
+  for (int i = 0; i < mir->Rndx; i++) {
+    int priority = mir->Results[i].measure_priority;
+    if (priority > 0 && priority < 32)
+      positive |= 1u << priority;
+    else if (priority < 0 && priority > -32)
+      negative |= 1u << -priority;
+  }
+  return ((positive & negative) != 0);
+}
+
+static void bubble_sort_mhea_package_measures(int sortabs) {
+  int flgSwap = TRUE; // did we swap in the loop
+  BCR_RES temp;    // temp structure for swapping
+  int i;
+
   while (flgSwap) // our simple bubble sort
   {
     flgSwap = FALSE;
@@ -352,18 +440,23 @@ void first_pass_retrofits(void) {
   MDI *original = NULL;  // as the name implies -- our untouched MDI struct
                          // NULL value is signal it is an unallocated ptr
   int lastRndx;          // The value of mir->Rndx prior to calling measure, measures POST increment mir->Rndx IF the measure is applied
+  int energy_calls = mor->energy_calc_counter;
+  int messages = mor->num_message;
+  int once_message = mor->once_message;
+
+  first_pass.report_len = 0;
 
   if (strcmp(cmds.mhea_measure_file_path, NO_OUTPUT) != 0) {
     measure_file = fopen(cmds.mhea_measure_file_path, "w");
     ASSERT(measure_file, sprintf(msg, "Failed to open the MHEA measure report file: %s code:%d:%s", cmds.mhea_measure_file_path, errno, strerror(errno)));
 
     if(cmds.regression_test)
-      fprintf(measure_file, "%s\n", "MHEA ");
+      first_pass_report("MHEA \n");
     else
-      fprintf(measure_file, "%s\n", "MHEA " WA_VERSION);
+      first_pass_report("MHEA " WA_VERSION "\n");
 
-    fprintf(measure_file, "\nFirst Pass Retrofits\n");
-    fprintf(measure_file, "    Pre    Post   HtgSvg   SIR  Reqrd  InclC  Component    Measure\n");
+    first_pass_report("\nFirst Pass Retrofits\n");
+    first_pass_report("    Pre    Post   HtgSvg   SIR  Reqrd  InclC  Component    Measure\n");
 
   } else {
     measure_file = NULL;
@@ -410,7 +503,10 @@ void first_pass_retrofits(void) {
       lastRndx = mir->Rndx;
       ASSERT(Measure_Function[iRetroNumber], sprintf(msg, "Must have non null measure function pointer item %d", iRetroNumber));
       (*Measure_Function[iRetroNumber])(); // call our retro function
+      performance_count(PC_MEASURES);
                                            // increments mir->Rndx by one OR MORE if implemented measure
+      if (cmds.debug_level & D_MEASURE_ACCESS)
+        check_measure_writes(iRetroNumber, original);
 
       // note that the following will be skipped if the measure routine
       // computes its own BCR figure (it should also fill in the energy
@@ -457,8 +553,9 @@ void first_pass_retrofits(void) {
 
       if (measure_file) {
         if (mir->flgRetrofits[iRetroNumber]) { // we did this retrofit
+          char line[MEASURENAME_LEN + STRING_LEN + 80];
 
-          fprintf(measure_file, "\n%8.2f%8.2f%7.2f%7.2f%5d %7d  %9.8s   %13s", 
+          sprintf(line, "\n%8.2f%8.2f%7.2f%7.2f%5d %7d  %9.8s   %13s",
             mir->Results[lastRndx].fEnerPreHtg / 1.e6,
             mir->Results[lastRndx].fEnerPstHtg / 1.e6, 
            (mir->Results[lastRndx].fEnerPreHtg - mir->Results[lastRndx].fEnerPstHtg) / 1.e6,
@@ -467,7 +564,7 @@ void first_pass_retrofits(void) {
             mir->Results[lastRndx].measure_priority, 
             mir->Results[lastRndx].sComponents,
             mir->Results[lastRndx].sName);
-
+          first_pass_report(line);
         }
       }
 
@@ -482,11 +579,311 @@ void first_pass_retrofits(void) {
   sort_mhea_package_measures(1);    // only sorts by SIR given the universaly MPS_SIR setting above
 
   copy_mdi(&mdi, original);
-  free(original);
+  release_mdi(&original);
+
+  // keep the state the pass leaves for reuse_first_pass_retrofits()
+
+  if (first_pass.mir == NULL) {
+    ASSERT((first_pass.mir = (MIR *)malloc(sizeof(MIR))), sprintf(msg, "Out of memory"));
+    ASSERT((first_pass.later = (MIR *)malloc(sizeof(MIR))), sprintf(msg, "Out of memory"));
+  }
+  *first_pass.mir = *mir;
+  first_pass.energy_calls = mor->energy_calc_counter - energy_calls;
+  first_pass.message = messages;
+  first_pass.num_message = mor->num_message - messages;
+  first_pass.once_message = mor->once_message & ~once_message;
+
+  return;
+}
+
+/*******************  FUNCTION NAME: reuse_first_pass_retrofits  *********/
+/**  DESCRIPTION:    Stands in for first_pass_retrofits() in the billing **/
+/**                  adjustment rerun.  The first pass starts every     **/
+/**                  measure from the original dwelling and the base    **/
+/**                  case energy use, and never reads the adjustment    **/
+/**                  factors, so repeating it gives the same results,   **/
+/**                  messages and measure report as the unadjusted run. **/
+/**                  The mir values the pass left are restored except   **/
+/**                  for those written after it (by the cumulative pass,**/
+/**                  base load, results and billing code), which keep   **/
+/**                  their current values just as a repeated pass would **/
+/**                  leave them.  A pass that gave a once a run notice  **/
+/**                  is repeated instead, since the repeat would not    **/
+/**                  give it again.  -d D_FIRST_PASS_REUSE checks the   **/
+/**                  reuse against a repeated pass.                     **/
+/*************************************************************************/
+void reuse_first_pass_retrofits(void) {
+  if (first_pass.once_message) {
+    first_pass_retrofits();
+    return;
+  }
+
+  restore_first_pass_mir();
+
+  mor->energy_calc_counter += first_pass.energy_calls;
+
+  for (int i = 0; i < first_pass.num_message; i++)
+    add_mhea_message(mor->message[first_pass.message + i]);
+
+  if (strcmp(cmds.mhea_measure_file_path, NO_OUTPUT) != 0) {
+    measure_file = fopen(cmds.mhea_measure_file_path, "w");
+    ASSERT(measure_file, sprintf(msg, "Failed to open the MHEA measure report file: %s code:%d:%s", cmds.mhea_measure_file_path, errno, strerror(errno)));
+    if (first_pass.report_len)
+      fwrite(first_pass.report, 1, first_pass.report_len, measure_file);
+  } else {
+    measure_file = NULL;
+  }
 
   return;
 }
 
+/*******************  FUNCTION NAME: check_first_pass_reuse  ***********/
+/**  DESCRIPTION:    Stands in for reuse_first_pass_retrofits() under   **/
+/**                  -d D_FIRST_PASS_REUSE.  Repeats the pass and       **/
+/**                  asserts it leaves mir, the energy call count, the  **/
+/**                  messages and the measure report just as the reuse  **/
+/**                  would have.  A mir member written after the pass   **/
+/**                  that restore_first_pass_mir() does not keep shows  **/
+/**                  up as a mismatch at its offset in MIR.             **/
+/*************************************************************************/
+void check_first_pass_reuse(void) {
+  MIR *reused;
+  char *report = NULL;
+  size_t report_len = first_pass.report_len;
+  int energy_calls = first_pass.energy_calls;
+  int message = first_pass.message;
+  int num_message = first_pass.num_message;
+  int reuse = first_pass.once_message == 0;
+  const unsigned char *a, *b;
+  size_t offset;
+
+  ASSERT((reused = (MIR *)malloc(sizeof(MIR))), sprintf(msg, "Out of memory"));
+  if (report_len) {
+    ASSERT((report = (char *)malloc(report_len)), sprintf(msg, "Out of memory"));
+    memcpy(report, first_pass.report, report_len);
+  }
+
+  restore_first_pass_mir();
+  *reused = *mir;
+  *mir = *first_pass.later; // back as the pass will start
+
+  first_pass_retrofits();
+
+  if (reuse) {
+    a = (const unsigned char *)mir;
+    b = (const unsigned char *)reused;
+    for (offset = 0; offset < sizeof(MIR) && a[offset] == b[offset]; offset++)
+      ;
+    ASSERT(offset == sizeof(MIR), sprintf(msg, "The reused first pass differs from a repeated one in mir at byte %zu of %zu", offset, sizeof(MIR)));
+    ASSERT(first_pass.energy_calls == energy_calls, sprintf(msg, "The reused first pass counts %d energy calls, a repeated one %d", energy_calls, first_pass.energy_calls));
+    ASSERT(first_pass.num_message == num_message, sprintf(msg, "The reused first pass gives %d messages, a repeated one %d", num_message, first_pass.num_message));
+    for (int i = 0; i < num_message; i++)
+      ASSERT(strcmp(mor->message[message + i], mor->message[first_pass.message + i]) == 0, sprintf(msg, "The reused first pass message %d differs from a repeated one", i));
+    ASSERT(first_pass.report_len == report_len && (report_len == 0 || memcmp(report, first_pass.report, report_len) == 0), sprintf(msg, "The reused first pass measure report differs from a repeated one"));
+  }
+
+  free(report);
+  free(reused);
+}
+
+// Put mir back as the first pass left it, keeping the values written
+// after the pass (see reuse_first_pass_retrofits()).  mir->Results are then
+// the measures the pass evaluated, each on its own, in SIR order.
+void restore_first_pass_mir(void) {
+  MIR *later = first_pass.later;
+
+  ASSERT(first_pass.mir, sprintf(msg, "The first pass has not been run"));
+
+  *later = *mir;
+  *mir = *first_pass.mir;
+
+  STRCPY(mir->sComponents, later->sComponents);
+  mir->component_set = later->component_set;
+  mir->fAdj_Htg = later->fAdj_Htg;
+  mir->fAdj_Clg = later->fAdj_Clg;
+  mir->fBasecase_Baseload = later->fBasecase_Baseload;
+  mir->fFinal_Heating = later->fFinal_Heating;
+  mir->fFinal_Cooling = later->fFinal_Cooling;
+  mir->fFinal_Baseload = later->fFinal_Baseload;
+  mir->flgPostHighHTGLoad = later->flgPostHighHTGLoad;
+  mir->flgPostHighCLGLoad = later->flgPostHighCLGLoad;
+  memcpy(mir->iPostHighLoadMonths, later->iPostHighLoadMonths, sizeof(mir->iPostHighLoadMonths));
+  mir->flgLimitBellyInsul = later->flgLimitBellyInsul;
+  mir->flgLimitBellyInsulAdd = later->flgLimitBellyInsulAdd;
+}
+
+/*******************  FUNCTION NAME: budget_package_retrofits  **********/
+/**  DESCRIPTION:    Cumulative pass over only the first pass measures   **/
+/**                  with keep[] set (indexed as the first pass         **/
+/**                  mir->Results), to fully evaluate a package picked  **/
+/**                  some other way than in SIR order.  Starts from the **/
+/**                  base case the last cumulative pass started from.   **/
+/**                  Leaves the package in mir->Results; no measure     **/
+/**                  report is written.                                 **/
+/*************************************************************************/
+void budget_package_retrofits(const int *keep) {
+  int num = 0;
+
+  restore_first_pass_mir();
+
+  for (int i = 0; i < mir->Rndx; i++) {
+    if (keep[i])
+      mir->Results[num++] = mir->Results[i];
+  }
+  memset(&mir->Results[num], 0, (MAXECMS - num) * sizeof(BCR_RES));
+  mir->Rndx = num;
+
+  repeat_cumulative_retrofits();
+}
+
+/*******************  FUNCTION NAME: reprice_first_pass_retrofits  ******/
+/**  DESCRIPTION:    The first pass results again, their savings and    **/
+/**                  SIRs recomputed at the fuel costs and escalation   **/
+/**                  rates now initialized and re-sorted, without       **/
+/**                  re-evaluating the energy use of any measure (none  **/
+/**                  depends on the fuel costs).  Itemized costs are    **/
+/**                  only added, and priced, by the cumulative pass.    **/
+/*************************************************************************/
+void reprice_first_pass_retrofits(void) {
+  restore_first_pass_mir();
+
+  for (int i = 0; i < mir->Rndx; i++) {
+    mir->Results[i].fBCR = 0.0f; // Zero out so mhea_measure_sir sees need to recompute BCR
+    mhea_measure_sir(i);
+  }
+
+  sort_mhea_package_measures(1); // by SIR, as the first pass left them
+}
+
+/*******************  FUNCTION NAME: save_first_pass  *******************/
+/**  DESCRIPTION:    Write what the last first pass left behind to fp,  **/
+/**                  for replay_first_pass() to read back in a later    **/
+/**                  run of the same dwelling (see cache.c).  Returns   **/
+/**                  FALSE on a write error.                            **/
+/*************************************************************************/
+int save_first_pass(FILE *fp) {
+  ASSERT(first_pass.mir, sprintf(msg, "The first pass has not been run"));
+
+  return fwrite(first_pass.mir, sizeof(MIR), 1, fp) == 1 &&
+         fwrite(&first_pass.energy_calls, sizeof(int), 1, fp) == 1 &&
+         fwrite(&first_pass.once_message, sizeof(int), 1, fp) == 1 &&
+         fwrite(&first_pass.num_message, sizeof(int), 1, fp) == 1 &&
+         (first_pass.num_message == 0 ||
+          fwrite(mor->message[first_pass.message], MESSAGE_LEN, first_pass.num_message, fp) == (size_t)first_pass.num_message) &&
+         fwrite(&first_pass.report_len, sizeof(size_t), 1, fp) == 1 &&
+         (first_pass.report_len == 0 || fwrite(first_pass.report, 1, first_pass.report_len, fp) == first_pass.report_len);
+}
+
+/*******************  FUNCTION NAME: replay_first_pass  *****************/
+/**  DESCRIPTION:    Stands in for first_pass_retrofits() with a pass   **/
+/**                  written by save_first_pass(): mir is left as the   **/
+/**                  pass left it, its messages and energy use count    **/
+/**                  are added to mor and its text starts the measure   **/
+/**                  report.  With reprice set the fuel costs differ    **/
+/**                  from those the pass was saved with, so the results **/
+/**                  are re-priced and re-sorted as in                  **/
+/**                  reprice_first_pass_retrofits().  Returns FALSE,    **/
+/**                  with nothing changed, if fp does not hold a whole  **/
+/**                  pass.                                              **/
+/*************************************************************************/
+int replay_first_pass(FILE *fp, int reprice) {
+  MIR *saved;
+  int energy_calls, once_message, num_message;
+  char (*message)[MESSAGE_LEN] = NULL;
+  char *report = NULL;
+  size_t report_len = 0;
+  int ok;
+
+  ASSERT((saved = (MIR *)malloc(sizeof(MIR))), sprintf(msg, "Out of memory"));
+
+  ok = fread(saved, sizeof(MIR), 1, fp) == 1 &&
+       fread(&energy_calls, sizeof(int), 1, fp) == 1 &&
+       fread(&once_message, sizeof(int), 1, fp) == 1 &&
+       fread(&num_message, sizeof(int), 1, fp) == 1 &&
+       num_message >= 0 && mor->num_message + num_message <= MAXMESSAGE;
+  if (ok && num_message) {
+    ASSERT((message = malloc(num_message * MESSAGE_LEN)), sprintf(msg, "Out of memory"));
+    ok = fread(message, MESSAGE_LEN, num_message, fp) == (size_t)num_message;
+  }
+  ok = ok && fread(&report_len, sizeof(size_t), 1, fp) == 1 && report_len < ((size_t)1 << 30);
+  if (ok && report_len) {
+    ASSERT((report = (char *)malloc(report_len)), sprintf(msg, "Out of memory"));
+    ok = fread(report, 1, report_len, fp) == report_len;
+  }
+
+  if (ok) {
+    if (first_pass.mir == NULL) {
+      ASSERT((first_pass.mir = (MIR *)malloc(sizeof(MIR))), sprintf(msg, "Out of memory"));
+      ASSERT((first_pass.later = (MIR *)malloc(sizeof(MIR))), sprintf(msg, "Out of memory"));
+    }
+    *first_pass.mir = *mir = *saved;
+
+    mor->energy_calc_counter += energy_calls;
+    mor->once_message |= once_message;
+    first_pass.energy_calls = energy_calls;
+    first_pass.once_message = once_message;
+    first_pass.message = mor->num_message;
+    first_pass.num_message = num_message;
+    for (int i = 0; i < num_message; i++)
+      add_mhea_message(message[i]);
+
+    first_pass.report_len = 0;
+    measure_file = NULL;
+    if (strcmp(cmds.mhea_measure_file_path, NO_OUTPUT) != 0) {
+      measure_file = fopen(cmds.mhea_measure_file_path, "w");
+      ASSERT(measure_file, sprintf(msg, "Failed to open the MHEA measure report file: %s code:%d:%s", cmds.mhea_measure_file_path, errno, strerror(errno)));
+    }
+    if (report_len)
+      first_pass_report_bytes(report, report_len);
+
+    if (reprice) {
+      reprice_first_pass_retrofits();
+      *first_pass.mir = *mir;
+    }
+  }
+
+  free(report);
+  free(message);
+  free(saved);
+  return ok;
+}
+
+/*******************  FUNCTION NAME: repeat_cumulative_retrofits  *******/
+/**  DESCRIPTION:    Cumulative pass over the measures now in           **/
+/**                  mir->Results, starting from the base case the last **/
+/**                  cumulative pass started from.  No measure report   **/
+/**                  is written.                                        **/
+/*************************************************************************/
+void repeat_cumulative_retrofits(void) {
+  mir->flgWhichPass = CUMULATIVE;
+
+  // as in run_mhea(), the billing adjusted pass starts from the adjusted base
+  if (mdi->gnl.do_billing_adjust == YES && (mir->fAdj_Htg != 1.0f || mir->fAdj_Clg != 1.0f)) {
+    mir->fPre_Heating = mir->fHeating_Energy * mir->fAdj_Htg;
+    mir->fPre_Cooling = mir->fCooling_Energy * mir->fAdj_Clg;
+  }
+
+  measure_file = NULL;
+  cumulative_retrofits();
+}
+
+// Write to the measure report, keeping a copy of the first pass text
+static void first_pass_report(const char *text) {
+  first_pass_report_bytes(text, strlen(text));
+}
+
+static void first_pass_report_bytes(const char *text, size_t len) {
+  if (measure_file)
+    fwrite(text, 1, len, measure_file);
+
+  if (first_pass.report_len + len > first_pass.report_size) {
+    first_pass.report_size = 2 * (first_pass.report_len + len);
+    ASSERT((first_pass.report = (char *)realloc(first_pass.report, first_pass.report_size)), sprintf(msg, "Out of memory"));
+  }
+  memcpy(first_pass.report + first_pass.report_len, text, len);
+  first_pass.report_len += len;
+}
+
 /*******************  FUNCTION NAME: cumulative_retrofits  ****************/
 /**         DATE:  1/2/93                                               **/
 /**           BY:    NW, SLF                                            **/
@@ -560,6 +957,7 @@ void cumulative_retrofits(void) {
 
     strcpy(mir->sComponents, res->sComponents);   // put list of measure components in our global 
                                                   // string for possible use by the measure function
+    mir->component_set = res->component_set;
 
     // call our retrofit routine. 
     // all routines including baseload measures are called
@@ -573,6 +971,9 @@ void cumulative_retrofits(void) {
 
     ASSERT(Measure_Function[res->measure_id], sprintf(msg, "Must have non null measure function pointer"));
     (*Measure_Function[res->measure_id])();   // call our retro function, sets mir->Rndx if measure is applied, resets .priority
+    performance_count(PC_MEASURES);
+    if (cmds.debug_level & D_MEASURE_ACCESS)
+      check_measure_writes(res->measure_id, retrofit);
 
     if (mir->Rndx == lastRndx)    // previous call did not increment this
         continue;                 // if the measure is not implemented, just continue outer loop
@@ -846,8 +1247,8 @@ void cumulative_retrofits(void) {
 
   copy_mdi(&mdi, original);       // back to original MDI structure
 
-  free(original);
-  free(retrofit);     // TODO some day echo this as the as-built JSON
+  release_mdi(&original);
+  release_mdi(&retrofit);     // TODO some day echo this as the as-built JSON
   free(LResults);
 
   if (measure_file)
@@ -9,7 +9,15 @@
 #define _RETROFIT_H
 
 void first_pass_retrofits(void);
+void reuse_first_pass_retrofits(void);
+void check_first_pass_reuse(void);
+void restore_first_pass_mir(void);
 void cumulative_retrofits(void);
+void budget_package_retrofits(const int *keep);
+void reprice_first_pass_retrofits(void);
+void repeat_cumulative_retrofits(void);
+int save_first_pass(FILE *fp);
+int replay_first_pass(FILE *fp, int reprice);
 
 void mhea_measure_sir(int index);
 
@@ -0,0 +1,136 @@
+/***************************************************************************
+* MODULE:       scenario.c            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        Economic scenarios for MHEA.  An audit may list other fuel
+*               prices, escalation rates and discount rates to evaluate its
+*               measures with (economic_scenarios in the input).  No
+*               measure's energy use depends on what fuel costs, so the
+*               first pass is not repeated: its results are re-priced and
+*               re-ranked for each scenario (see
+*               reprice_first_pass_retrofits()), and only the cumulative
+*               pass is run again to select and interact the package.
+*               Packages that repeat the audit's own, or each other's,
+*               mostly come from the energy memo.
+*
+*               NEAT has no economic scenarios yet.  Its measure functions
+*               price their savings as they evaluate them (CompFuelCost(),
+*               DCompFuelCost(), pw_fuel_cost()) and leave out whatever
+*               falls below the minimum SIR (eg. lighting and itemized
+*               costs), so which measures exist depends on the prices and
+*               there is no price free pass to re-price.  A NEAT scenario
+*               would rerun the measure evaluation, which is left for its
+*               own change.
+****************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "wa_engine.h"
+
+static void scenario_ranking(MHEA_SCENARIO *scenario);
+static void scenario_package(MHEA_SCENARIO *scenario);
+
+/***************************************************************************
+ ** Function Name: evaluate_mhea_scenarios
+ **
+ **  DESCRIPTION:  Rank the first pass measures and select the package at
+ **                the fuel costs of each of the audit's economic
+ **                scenarios, putting them in mor->scenario[].  Called
+ **                after the audit's own package is complete; mir, mor
+ **                and the fuel costs are left as they were.
+ **************************************************************************/
+void evaluate_mhea_scenarios(void) {
+  MIR *saved_mir;
+  MOR *saved_mor;
+  MHEA_SCENARIO *scenario;
+
+  ASSERT((saved_mir = (MIR *)malloc(sizeof(MIR))), sprintf(msg, "Out of memory on MIR"));
+  ASSERT((saved_mor = (MOR *)malloc(sizeof(MOR))), sprintf(msg, "Out of memory on MOR"));
+  ASSERT((scenario = (MHEA_SCENARIO *)calloc(mdi->num_scn, sizeof(MHEA_SCENARIO))), sprintf(msg, "Out of memory on the economic scenarios"));
+  *saved_mir = *mir;
+  *saved_mor = *mor;
+
+  for (int s = 0; s < mdi->num_scn; s++) {
+    M_SCN *scn = &mdi->scn[s];
+
+    if (cmds.debug_level & D_NORMAL)
+      fprintf(stderr, "\n\nECONOMIC SCENARIO: %s", scn->name);
+
+    STRCPY(scenario[s].name, scn->name);
+    scenario[s].real_discount_rate = scn->real_discount_rate;
+
+    initialize_fuel_cost_data(scn->fcs, scn->fer, 1.0f + (scn->real_discount_rate / 100.0f));
+
+    reprice_first_pass_retrofits();
+    scenario_ranking(&scenario[s]);
+
+    repeat_cumulative_retrofits();
+    scenario_package(&scenario[s]);
+
+    *mir = *saved_mir; // each scenario starts where the audit's own passes left off
+  }
+
+  initialize_fuel_cost_data(mdi->fcs, mdi->fer, 1.0f + (mdi->key.real_discount_rate / 100.0f));
+
+  *mor = *saved_mor;
+  mor->num_scenario = mdi->num_scn;
+  memcpy(mor->scenario, scenario, mdi->num_scn * sizeof(MHEA_SCENARIO));
+
+  free(scenario);
+  free(saved_mir);
+  free(saved_mor);
+}
+
+// Every first pass measure, in the order the scenario's SIRs put them
+static void scenario_ranking(MHEA_SCENARIO *scenario) {
+  for (int i = 0; i < mir->Rndx; i++) {
+    BCR_RES *res = &mir->Results[i];
+    MHEA_SCENARIO_MEASURE *m = &scenario->measure[scenario->num_measure++];
+
+    m->rank = i + 1;
+    m->measure_id = res->measure_id;
+    STRCPY(m->measure, res->sName);
+    STRCPY(m->components, res->sComponents);
+    m->sir = res->fBCR;
+    m->cost = res->fInitCost;
+  }
+}
+
+// Mark the measures the cumulative pass kept, in its order, with their
+// interacted savings.  Itemized costs only the cumulative pass adds go on
+// the end, unranked.
+static void scenario_package(MHEA_SCENARIO *scenario) {
+  float pv = 0.0f;
+
+  for (int i = 0; i < mir->Rndx; i++) {
+    BCR_RES *res = &mir->Results[i];
+    MHEA_SCENARIO_MEASURE *m = NULL;
+
+    for (int j = 0; j < scenario->num_measure && m == NULL; j++) { // the pass re-sorts, so search
+      MHEA_SCENARIO_MEASURE *r = &scenario->measure[j];
+      if (!r->package && r->rank && r->measure_id == res->measure_id && strcmp(r->measure, res->sName) == 0 &&
+          strcmp(r->components, res->sComponents) == 0)
+        m = r;
+    }
+    if (m == NULL) {
+      ASSERT(scenario->num_measure < MAXECMS, sprintf(msg, "Too many measures in economic scenario %s", scenario->name));
+      m = &scenario->measure[scenario->num_measure++];
+      m->measure_id = res->measure_id;
+      STRCPY(m->measure, res->sName);
+      STRCPY(m->components, res->sComponents);
+      m->sir = res->fBCR;
+    }
+
+    m->package = ++scenario->num_package;
+    m->savings = res->fCostAnnSavTot;
+    m->cost = res->fInitCost;
+    m->csir = res->fTotSIR;
+
+    scenario->cost += res->fInitCost;
+    scenario->savings += res->fCostAnnSavTot;
+    pv += res->fCostSavTot;
+  }
+  scenario->sir = scenario->cost > 0.0f ? pv / scenario->cost : 0.0f;
+}
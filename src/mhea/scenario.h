@@ -0,0 +1,13 @@
+/***************************************************************************
+* MODULE:       scenario.h            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        MHEA measures evaluated under other economic scenarios
+****************************************************************************/
+#ifndef _SCENARIO_H
+#define _SCENARIO_H
+
+void evaluate_mhea_scenarios(void);
+
+#endif
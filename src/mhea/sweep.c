@@ -0,0 +1,1174 @@
+/***************************************************************************
+* MODULE:       sweep.c            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        Repeated MHEA runs of one parsed audit.  The audit is parsed
+*               once and kept; each run starts from that copy with fresh
+*               intermediate and result structures, changes what it is
+*               sweeping over and calls run_mhea().  The weather data is
+*               kept while the station stays the same.  Each run is
+*               reduced to one compact result row, or for a Monte Carlo
+*               run folded into percentiles over all the samples.
+*
+*               A what-if session keeps the parsed input resident instead
+*               and runs it again after each JSON Patch edit.
+*
+*               A sensitivity run perturbs one input field at a time and
+*               only goes as far as the first pass, which is all its
+*               results need.  Fields that only set prices re-price the
+*               unperturbed run's first pass instead of running again.
+*
+*               The engine works through the global mdi, mir, mor and cwd
+*               pointers, so the runs are made one after the other.
+****************************************************************************/
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "wa_engine.h"
+
+#define SWEEP_MAX_PARAMETERS 8 // fields varied together in a parametric sweep
+#define SWEEP_MAX_POINTS 10000 // grid points in a parametric sweep
+#define MC_MAX_INPUTS 16         // uncertain fields in a Monte Carlo run
+#define MC_MAX_SAMPLES 100000    // samples in a Monte Carlo run
+#define MC_MAX_PERCENTILES 16    // percentiles reported for each result
+#define SESSION_EDIT_LEN 65536   // longest JSON Patch line in a session
+#define SENS_MAX_FIELDS 4096     // input fields perturbed in a sensitivity run
+
+static MDI *audit = NULL; // the audit as parsed, every run starts from it
+
+typedef struct {
+  const char *path; // JSON pointer to the input field
+  cJSON *values;    // array of the values it takes
+} SWEEP_PARAMETER;
+
+enum MC_DISTRIBUTION { MC_UNIFORM, MC_NORMAL, MC_TRIANGULAR, MC_CHOICE };
+
+typedef struct {
+  const char *path;          // JSON pointer to the input field
+  enum MC_DISTRIBUTION dist; // how its values are drawn
+  double min, max;           // uniform and triangular range, normal limits
+  double mode;               // triangular peak
+  double mean, sd;           // normal
+  cJSON *values;             // choice, drawn with equal weight
+  int integer;               // round the drawn value
+} MC_INPUT;
+
+typedef struct {
+  int measure_id;                    // input measure_flag[] index
+  char measure[MEASURENAME_LEN + 1]; // name of measure
+  char components[STRING_LEN];       // component codes effected
+  int count;                         // samples the measure was evaluated in
+  int last;                          // the last of them
+  float *sir;                        // its SIR in each of them
+  float *savings;                    // and annual $ savings
+} MC_MEASURE;
+
+// Results summarized over the samples, taken from the sweep_row() of each
+static const char *mc_results[] = {"pre_heat", "pre_cool", "pre_base", "post_heat", "post_cool", "post_base", "cost", "savings", "sir"};
+#define MC_RESULTS (int)(sizeof(mc_results) / sizeof(mc_results[0]))
+
+static uint64_t mc_state; // random number generator state, from the seed
+
+// What a perturbed input field can change in a sensitivity run
+enum SENS_DEPENDS {
+  SENS_ALL,   // base case consumption and SIRs, run again
+  SENS_SIR,   // only SIRs, run again
+  SENS_PRICE, // only SIRs, the unperturbed first pass re-priced
+  SENS_NONE   // neither, or not a quantity, not perturbed
+};
+
+// From what the engine reads each field for.  The first entry whose path
+// is a prefix of the field's wins; * stands for any characters within a
+// step of the path.  Fields not listed can change anything.
+static const struct {
+  const char *path;
+  enum SENS_DEPENDS depends;
+} sens_dependency[] = {
+    {"/audit/audit_id", SENS_NONE}, // identifiers
+    {"/audit/audit_number", SENS_NONE},
+    {"/measure_active_flags", SENS_NONE},
+    {"/measure_costs/*/id", SENS_NONE},
+    {"/fuel_escalation_rates/*/fuel_type_id", SENS_NONE},
+    {"/utility_bills_pre_retrofit_heating", SENS_NONE}, // only the billing adjustment, after the first pass
+    {"/utility_bills_pre_retrofit_heating_data", SENS_NONE},
+    {"/utility_bills_pre_retrofit_cooling", SENS_NONE},
+    {"/utility_bills_pre_retrofit_cooling_data", SENS_NONE},
+    {"/itemized_costs", SENS_NONE}, // only the cumulative pass and after
+    {"/key_parameters/minimum_acceptable_sir", SENS_NONE},
+    {"/key_parameters/spending_limit", SENS_NONE},
+    {"/economic_scenarios", SENS_NONE},
+    {"/fuel_costs/*_heat", SENS_SIR}, // heat contents, also in the base load measures
+    {"/fuel_costs", SENS_PRICE},
+    {"/fuel_escalation_rates", SENS_PRICE},
+    {"/fuel_escalation_rates_by_reference", SENS_PRICE},
+    {"/key_parameters/real_discount_rate", SENS_PRICE},
+    {"/measure_costs", SENS_SIR},
+    {"/*/*cost*", SENS_SIR}, // component retrofit costs
+    {"/*/*/*cost*", SENS_SIR},
+};
+
+typedef struct {
+  char path[PATH_LEN];       // JSON pointer to the input field
+  cJSON *item;               // the field in the parsed input
+  double value;              // its input value
+  enum SENS_DEPENDS depends;
+} SENS_FIELD;
+
+typedef struct {
+  int measure_id;                    // input measure_flag[] index
+  char measure[MEASURENAME_LEN + 1]; // name of measure
+  char components[STRING_LEN];       // component codes effected
+} SENS_MEASURE;
+
+typedef struct {    // results of one evaluation
+  double heat;      // base case heating (Btu)
+  double cool;      // base case cooling (Btu)
+  float sir[MAXECMS]; // first pass SIR of each base measure
+  int has[MAXECMS];   // the measure was evaluated
+} SENS_POINT;
+
+static struct {
+  SENS_MEASURE measure[MAXECMS]; // first pass measures of the unperturbed run
+  int num_measure;
+  int runs;     // first passes run
+  int repriced; // first passes re-priced
+} sens;
+
+static float package_sir(void);
+static cJSON *measure_sirs(void);
+static int sweep_parameters(cJSON *jspec, SWEEP_PARAMETER *param);
+static void set_input_value(cJSON *json_input, const char *path, cJSON *value);
+static int mc_inputs(cJSON *jspec, MC_INPUT *input);
+static void mc_draw(cJSON *json_input, MC_INPUT *input);
+static double mc_uniform(void);
+static void mc_add_measures(MC_MEASURE *list, int *num, int sample, int num_sample);
+static cJSON *mc_percentiles(float *values, int n, const double *pct, int num_pct);
+static int compare_float(const void *a, const void *b);
+static void session_write(FILE *out, int edit, cJSON *jresult, const char *error);
+static void sens_collect(cJSON *item, char *path, SENS_FIELD *field, int *num);
+static enum SENS_DEPENDS sens_depends(const char *path);
+static int sens_step_matches(const char *pattern, size_t pattern_len, const char *step, size_t step_len);
+static cJSON *sens_schema_entry(cJSON *json_schema, const char *path);
+static cJSON *sens_schema_ref(cJSON *json_schema, cJSON *node);
+static int sens_schema_integer(cJSON *entry);
+static void sens_evaluate(SENS_FIELD *f, double value, cJSON *json_input, cJSON *json_schema, SENS_POINT *point);
+static void sens_point(SENS_POINT *point);
+static cJSON *sens_normalized(double up, double down, double base, double step);
+
+/***************************************************************************
+ ** Function Name: sweep_begin
+ **
+ **  DESCRIPTION:  Keep the parsed audit in mdi for the runs that follow
+ **************************************************************************/
+void sweep_begin(void) {
+  ASSERT(mdi && mir && mor && cwd, sprintf(msg, "The MHEA structures must be allocated before a sweep"));
+  copy_mdi(&audit, mdi);
+}
+
+// Start the next run from the audit as parsed
+void sweep_restore(void) {
+  ASSERT(audit, sprintf(msg, "sweep_begin() must be called before a sweep run"));
+  copy_mdi(&mdi, audit);
+}
+
+/***************************************************************************
+ ** Function Name: sweep_run
+ **
+ **  DESCRIPTION:  One MHEA run of mdi.  The caller starts mdi from the
+ **                kept audit with sweep_restore(), then makes the changes
+ **                for the run.
+ **************************************************************************/
+void sweep_run(void) {
+  memset(mir, 0, sizeof(MIR));
+  memset(mor, 0, sizeof(MOR));
+
+  run_mhea(); // <<<<<<<======= MHEA engine WORKHORSE
+}
+
+/***************************************************************************
+ ** Function Name: sweep_row
+ **
+ **  DESCRIPTION:  Compact result row for the last run: annual loads,
+ **                the recommended package and its savings to investment
+ **                ratio (billing adjusted when there was an adjustment)
+ **************************************************************************/
+cJSON *sweep_row(void) {
+  cJSON *jrow = cJSON_CreateObject();
+  float cost = 0.0f, savings = 0.0f;
+  char city[sizeof(cwd->city_name)];
+  int n;
+
+  for (int i = 0; i < mor->num_measure; i++) {
+    cost += mor->measure[i].cost;
+    savings += mor->measure[i].savings;
+  }
+  snprintf(city, sizeof(city), "%s", cwd->city_name);
+  n = (int)strlen(city);
+  while (n > 0 && isspace((unsigned char)city[n - 1])) // weather files pad the name
+    city[--n] = '\0';
+
+  // clang-format off
+  cJSON_AddStringToObject(jrow, "weather_file", mdi->wth.file);
+  cJSON_AddStringToObject(jrow, "city",         city);
+  cJSON_AddNumberToObject(jrow, "pre_heat",     WA_DBL_FMT(mor->pre_heat, 1));
+  cJSON_AddNumberToObject(jrow, "pre_cool",     WA_DBL_FMT(mor->pre_cool, 1));
+  cJSON_AddNumberToObject(jrow, "pre_base",     WA_DBL_FMT(mor->pre_base, 1));
+  cJSON_AddNumberToObject(jrow, "post_heat",    WA_DBL_FMT(mor->post_heat, 1));
+  cJSON_AddNumberToObject(jrow, "post_cool",    WA_DBL_FMT(mor->post_cool, 1));
+  cJSON_AddNumberToObject(jrow, "post_base",    WA_DBL_FMT(mor->post_base, 1));
+  cJSON_AddNumberToObject(jrow, "num_measure",  mor->num_measure);
+  cJSON_AddNumberToObject(jrow, "cost",         WA_DBL_FMT(cost, 2));
+  cJSON_AddNumberToObject(jrow, "savings",      WA_DBL_FMT(savings, 2));
+  cJSON_AddNumberToObject(jrow, "sir",          WA_DBL_FMT(package_sir(), 3));
+  // clang-format on
+
+  return jrow;
+}
+
+// The package SIR is the cost weighted SIR of its measures, ie. their present
+// value of savings over their total cost.  Billing adjusted when adjusted.
+static float package_sir(void) {
+  MHEA_ECONOMICS *list = mor->num_asir > 0 ? mor->asir : mor->sir;
+  int num = mor->num_asir > 0 ? mor->num_asir : mor->num_sir;
+  float pv = 0.0f, cost = 0.0f;
+
+  for (int i = 0; i < num; i++) {
+    pv += list[i].sir * list[i].cost;
+    cost += list[i].cost;
+  }
+  return cost > 0.0f ? pv / cost : 0.0f;
+}
+
+// SIR of every measure evaluated in the last run, recommended or not
+static cJSON *measure_sirs(void) {
+  cJSON *jarray = cJSON_CreateArray();
+
+  for (int i = 0; i < mor->num_measure; i++) {
+    cJSON *jitem = cJSON_CreateObject();
+    cJSON_AddNumberToObject(jitem, "measure_id", mor->measure[i].measure_id);
+    cJSON_AddStringToObject(jitem, "measure",    mor->measure[i].measure);
+    cJSON_AddStringToObject(jitem, "components", mor->measure[i].components);
+    cJSON_AddNumberToObject(jitem, "sir",        WA_DBL_FMT(mor->measure[i].sir, 3));
+    cJSON_AddItemToArray(jarray, jitem);
+  }
+  return jarray;
+}
+
+void sweep_end(void) {
+  if (audit)
+    copy_mdi(&mdi, audit); // leave mdi as parsed
+  release_mdi(&audit);
+}
+
+// Write a sweep's results, under the given name, as the JSON results
+static void sweep_write(const char *name, cJSON *jresults) {
+  cJSON *jroot = cJSON_CreateObject();
+  char *output;
+
+  if (strlen(cmds.run_identifier)) cJSON_AddStringToObject(jroot, "run_identifier", cmds.run_identifier);
+  cJSON_AddNumberToObject(jroot, "audit_id", mdi->gnl.audit_id);
+  cJSON_AddItemToObject(jroot, name, jresults);
+
+  if (cmds.format_json_output)
+    output = cJSON_Print(jroot);
+  else
+    output = cJSON_PrintUnformatted(jroot);
+
+  write_results_to_file(output);
+
+  if (output) free(output);
+  cJSON_Delete(jroot);
+}
+
+/***************************************************************************
+ ** Function Name: run_mhea_weather_sweep
+ **
+ **  DESCRIPTION:  Run the audit in mdi once for each weather station
+ **                listed in station_list_path, one weather file name
+ **                (eg. ABILENTX.WX) per line.  Blank lines and lines
+ **                starting with # are skipped.  Writes one row per
+ **                station, in list order, as the JSON results.  Only the
+ **                weather changes; fuel prices stay those of the audit.
+ **                A station whose weather file would stop the run gets
+ **                a row with its weather_file and error instead.
+ **************************************************************************/
+void run_mhea_weather_sweep(const char *station_list_path) {
+  FILE *list;
+  char line[PATH_LEN];
+  cJSON *jrows = cJSON_CreateArray();
+
+  list = fopen(station_list_path, "r");
+  ASSERT(list, sprintf(msg, "Failed to open the weather station list: %s code:%d:%s", station_list_path, errno, strerror(errno)));
+
+  sweep_begin();
+
+  while (fgets(line, sizeof(line), list)) {
+    char *station = line;
+    const char *error;
+    int n;
+
+    while (isspace((unsigned char)*station))
+      station++;
+    n = (int)strlen(station);
+    while (n > 0 && isspace((unsigned char)station[n - 1]))
+      station[--n] = '\0';
+    if (n == 0 || station[0] == '#')
+      continue;
+
+    if ((error = check_weather_file(station)) != NULL) { // the run would stop the sweep
+      cJSON *jrow = cJSON_CreateObject();
+      cJSON_AddStringToObject(jrow, "weather_file", station);
+      cJSON_AddStringToObject(jrow, "error", error);
+      cJSON_AddItemToArray(jrows, jrow);
+      continue;
+    }
+
+    sweep_restore();
+    STRCPY(mdi->wth.file, station);
+
+    if (cmds.debug_level & D_NORMAL)
+      fprintf(stderr, "\n\nWEATHER SWEEP: %s", station);
+
+    sweep_run();
+    cJSON_AddItemToArray(jrows, sweep_row());
+  }
+  fclose(list);
+
+  sweep_end();
+
+  sweep_write("weather_sweep", jrows);
+}
+
+/***************************************************************************
+ ** Function Name: run_mhea_parametric_sweep
+ **
+ **  DESCRIPTION:  Run the audit in json_input at every point of a grid of
+ **                input field values.  The spec file holds
+ **
+ **                  {"parameters": [
+ **                    {"path": "/walls/batt_insl", "values": [0, 1, 2]},
+ **                    {"path": "/audit/leakiness", "from": 1, "to": 3, "step": 1}]}
+ **
+ **                where each path is a JSON pointer into the audit input.
+ **                The grid is every combination of the values, the first
+ **                parameter varying slowest.  The input and schema are
+ **                parsed once; each point patches the parsed input, reads
+ **                it into mdi and runs the engine.  Writes one row per
+ **                point with its values, the sweep_row() results and the
+ **                SIR of every measure evaluated.
+ **************************************************************************/
+void run_mhea_parametric_sweep(const char *spec_path, cJSON *json_input, cJSON *json_schema) {
+  cJSON *jspec = parse_json_file(spec_path);
+  cJSON *jrows = cJSON_CreateArray();
+  SWEEP_PARAMETER param[SWEEP_MAX_PARAMETERS];
+  int at[SWEEP_MAX_PARAMETERS] = {0}; // index into each parameter's values for the current point
+  int num_param, num_point = 1;
+
+  num_param = sweep_parameters(jspec, param);
+  for (int p = 0; p < num_param; p++) {
+    num_point *= cJSON_GetArraySize(param[p].values);
+    ASSERT(num_point <= SWEEP_MAX_POINTS, sprintf(msg, "Parametric sweep has more than %d points", SWEEP_MAX_POINTS));
+  }
+
+  for (int point = 0; point < num_point; point++) {
+    cJSON *jrow, *jpoint = cJSON_CreateObject();
+
+    for (int p = 0; p < num_param; p++) {
+      cJSON *value = cJSON_GetArrayItem(param[p].values, at[p]);
+      set_input_value(json_input, param[p].path, value);
+      cJSON_AddItemToObject(jpoint, param[p].path, cJSON_Duplicate(value, TRUE));
+    }
+
+    if (cmds.debug_level & D_NORMAL)
+      fprintf(stderr, "\n\nPARAMETRIC SWEEP: point %d of %d", point + 1, num_point);
+
+    memset(mdi, 0, sizeof(MDI));
+    mhea_json_read(mdi, json_input, json_schema);
+    sweep_run();
+
+    jrow = sweep_row();
+    cJSON_AddItemToObject(jrow, "point", jpoint);
+    cJSON_AddItemToObject(jrow, "measure_sir", measure_sirs());
+    cJSON_AddItemToArray(jrows, jrow);
+
+    for (int p = num_param - 1; p >= 0; p--) { // next point, the last parameter varying fastest
+      if (++at[p] < cJSON_GetArraySize(param[p].values))
+        break;
+      at[p] = 0;
+    }
+  }
+
+  sweep_write("parametric_sweep", jrows);
+  cJSON_Delete(jspec);
+}
+
+// Fill param from the spec's parameter list, a range becomes a values array
+// kept in the spec tree.  Returns the number of parameters.
+static int sweep_parameters(cJSON *jspec, SWEEP_PARAMETER *param) {
+  cJSON *jlist = cJSON_GetObjectItem(jspec, "parameters");
+  cJSON *jparam;
+  int num = 0;
+
+  ASSERT(cJSON_IsArray(jlist) && cJSON_GetArraySize(jlist) > 0, sprintf(msg, "Parametric sweep needs a parameters array"));
+  ASSERT(cJSON_GetArraySize(jlist) <= SWEEP_MAX_PARAMETERS, sprintf(msg, "Parametric sweep has more than %d parameters", SWEEP_MAX_PARAMETERS));
+
+  cJSON_ArrayForEach(jparam, jlist) {
+    cJSON *jpath = cJSON_GetObjectItem(jparam, "path");
+    cJSON *jvalues = cJSON_GetObjectItem(jparam, "values");
+
+    ASSERT(cJSON_IsString(jpath), sprintf(msg, "Parametric sweep parameter %d needs a path", num + 1));
+    if (jvalues == NULL) {
+      cJSON *jfrom = cJSON_GetObjectItem(jparam, "from");
+      cJSON *jto = cJSON_GetObjectItem(jparam, "to");
+      cJSON *jstep = cJSON_GetObjectItem(jparam, "step");
+      int steps;
+
+      ASSERT(cJSON_IsNumber(jfrom) && cJSON_IsNumber(jto) && cJSON_IsNumber(jstep) && jstep->valuedouble > 0.0 &&
+                 jto->valuedouble >= jfrom->valuedouble,
+             sprintf(msg, "Parametric sweep %s needs values or a from, to and positive step", jpath->valuestring));
+      steps = (int)((jto->valuedouble - jfrom->valuedouble) / jstep->valuedouble + 1.0e-6);
+      ASSERT(steps < SWEEP_MAX_POINTS, sprintf(msg, "Parametric sweep %s has too many steps", jpath->valuestring));
+
+      cJSON_AddItemToObject(jparam, "values", jvalues = cJSON_CreateArray());
+      for (int i = 0; i <= steps; i++)
+        cJSON_AddItemToArray(jvalues, cJSON_CreateNumber(jfrom->valuedouble + i * jstep->valuedouble));
+    }
+    ASSERT(cJSON_IsArray(jvalues) && cJSON_GetArraySize(jvalues) > 0,
+           sprintf(msg, "Parametric sweep %s needs at least one value", jpath->valuestring));
+
+    param[num].path = jpath->valuestring;
+    param[num].values = jvalues;
+    num++;
+  }
+  return num;
+}
+
+// Set the input field at path to a copy of value
+static void set_input_value(cJSON *json_input, const char *path, cJSON *value) {
+  cJSON *item = json_pointer_item(json_input, path);
+
+  ASSERT(item && item != json_input, sprintf(msg, "No audit input field at %s", path));
+  json_set_item_value(item, value);
+}
+
+/***************************************************************************
+ ** Function Name: run_mhea_monte_carlo
+ **
+ **  DESCRIPTION:  Monte Carlo run of the audit in json_input over
+ **                uncertain input fields.  The spec file holds
+ **
+ **                  {"seed": 1, "samples": 1000, "percentiles": [5, 50, 95],
+ **                   "inputs": [
+ **                    {"path": "/audit/leakiness", "distribution": "uniform",
+ **                     "min": 1, "max": 3, "integer": true},
+ **                    {"path": "/heating_primary/efficiency_percent",
+ **                     "distribution": "normal", "mean": 75, "sd": 5, "min": 50, "max": 95},
+ **                    {"path": "/fuel_costs/electric", "distribution": "triangular",
+ **                     "min": 0.10, "mode": 0.13, "max": 0.18},
+ **                    {"path": "/key_parameters/real_discount_rate",
+ **                     "distribution": "choice", "values": [1, 3, 5]}]}
+ **
+ **                Each sample draws every input, patches the parsed input,
+ **                reads it into mdi and runs the engine.  The same seed
+ **                draws the same samples.  Only the percentiles are
+ **                written: of the package results and of the SIR and
+ **                savings of each measure over the samples it was
+ **                evaluated in, with the share of samples that was.
+ **************************************************************************/
+void run_mhea_monte_carlo(const char *spec_path, cJSON *json_input, cJSON *json_schema) {
+  static const double default_pct[] = {5, 25, 50, 75, 95};
+  cJSON *jspec = parse_json_file(spec_path);
+  cJSON *jsamples = cJSON_GetObjectItem(jspec, "samples");
+  cJSON *jseed = cJSON_GetObjectItem(jspec, "seed");
+  cJSON *jpct = cJSON_GetObjectItem(jspec, "percentiles");
+  cJSON *jresult = cJSON_CreateObject();
+  cJSON *jmeasures = cJSON_CreateArray();
+  MC_INPUT input[MC_MAX_INPUTS];
+  MC_MEASURE *measure;
+  float *result[MC_RESULTS];
+  double pct[MC_MAX_PERCENTILES];
+  int num_input, num_sample, num_pct = 0, num_measure = 0;
+
+  ASSERT(cJSON_IsNumber(jsamples) && jsamples->valueint > 0 && jsamples->valueint <= MC_MAX_SAMPLES,
+         sprintf(msg, "Monte Carlo needs a number of samples from 1 to %d", MC_MAX_SAMPLES));
+  num_sample = jsamples->valueint;
+  mc_state = cJSON_IsNumber(jseed) ? (uint64_t)jseed->valuedouble : 0;
+
+  if (jpct) {
+    cJSON *jp;
+    ASSERT(cJSON_IsArray(jpct) && cJSON_GetArraySize(jpct) > 0 && cJSON_GetArraySize(jpct) <= MC_MAX_PERCENTILES,
+           sprintf(msg, "Monte Carlo percentiles must be an array of 1 to %d numbers", MC_MAX_PERCENTILES));
+    cJSON_ArrayForEach(jp, jpct) {
+      ASSERT(cJSON_IsNumber(jp) && jp->valuedouble >= 0.0 && jp->valuedouble <= 100.0,
+             sprintf(msg, "Monte Carlo percentiles must be from 0 to 100"));
+      pct[num_pct++] = jp->valuedouble;
+    }
+  } else {
+    for (; num_pct < (int)(sizeof(default_pct) / sizeof(default_pct[0])); num_pct++)
+      pct[num_pct] = default_pct[num_pct];
+  }
+
+  num_input = mc_inputs(jspec, input);
+
+  for (int r = 0; r < MC_RESULTS; r++)
+    ASSERT((result[r] = (float *)malloc(num_sample * sizeof(float))), sprintf(msg, "Out of memory on Monte Carlo results"));
+  ASSERT((measure = (MC_MEASURE *)calloc(MAXECMS, sizeof(MC_MEASURE))), sprintf(msg, "Out of memory on Monte Carlo measures"));
+
+  for (int sample = 0; sample < num_sample; sample++) {
+    cJSON *jrow;
+
+    for (int i = 0; i < num_input; i++)
+      mc_draw(json_input, &input[i]);
+
+    if (cmds.debug_level & D_NORMAL)
+      fprintf(stderr, "\n\nMONTE CARLO: sample %d of %d", sample + 1, num_sample);
+
+    memset(mdi, 0, sizeof(MDI));
+    mhea_json_read(mdi, json_input, json_schema);
+    sweep_run();
+
+    jrow = sweep_row();
+    for (int r = 0; r < MC_RESULTS; r++)
+      result[r][sample] = (float)cJSON_GetObjectItem(jrow, mc_results[r])->valuedouble;
+    cJSON_Delete(jrow);
+
+    mc_add_measures(measure, &num_measure, sample, num_sample);
+  }
+
+  cJSON_AddNumberToObject(jresult, "seed", cJSON_IsNumber(jseed) ? jseed->valuedouble : 0);
+  cJSON_AddNumberToObject(jresult, "samples", num_sample);
+  cJSON_AddItemToObject(jresult, "percentiles", cJSON_CreateDoubleArray(pct, num_pct));
+  for (int r = 0; r < MC_RESULTS; r++) {
+    cJSON_AddItemToObject(jresult, mc_results[r], mc_percentiles(result[r], num_sample, pct, num_pct));
+    free(result[r]);
+  }
+
+  for (int m = 0; m < num_measure; m++) {
+    cJSON *jitem = cJSON_CreateObject();
+    cJSON_AddNumberToObject(jitem, "measure_id", measure[m].measure_id);
+    cJSON_AddStringToObject(jitem, "measure",    measure[m].measure);
+    cJSON_AddStringToObject(jitem, "components", measure[m].components);
+    cJSON_AddNumberToObject(jitem, "share",      WA_DBL_FMT((float)measure[m].count / num_sample, 4));
+    cJSON_AddItemToObject(jitem, "sir",     mc_percentiles(measure[m].sir, measure[m].count, pct, num_pct));
+    cJSON_AddItemToObject(jitem, "savings", mc_percentiles(measure[m].savings, measure[m].count, pct, num_pct));
+    cJSON_AddItemToArray(jmeasures, jitem);
+    free(measure[m].sir);
+    free(measure[m].savings);
+  }
+  free(measure);
+  cJSON_AddItemToObject(jresult, "measures", jmeasures);
+
+  sweep_write("monte_carlo", jresult);
+  cJSON_Delete(jspec);
+}
+
+// Fill input from the spec's inputs list.  Returns the number of inputs.
+static int mc_inputs(cJSON *jspec, MC_INPUT *input) {
+  static const char *names[] = {"uniform", "normal", "triangular", "choice"};
+  cJSON *jlist = cJSON_GetObjectItem(jspec, "inputs");
+  cJSON *jin;
+  int num = 0;
+
+  ASSERT(cJSON_IsArray(jlist) && cJSON_GetArraySize(jlist) > 0, sprintf(msg, "Monte Carlo needs an inputs array"));
+  ASSERT(cJSON_GetArraySize(jlist) <= MC_MAX_INPUTS, sprintf(msg, "Monte Carlo has more than %d inputs", MC_MAX_INPUTS));
+
+  cJSON_ArrayForEach(jin, jlist) {
+    MC_INPUT *in = &input[num];
+    cJSON *jpath = cJSON_GetObjectItem(jin, "path");
+    cJSON *jdist = cJSON_GetObjectItem(jin, "distribution");
+    cJSON *jitem;
+    int d;
+
+    ASSERT(cJSON_IsString(jpath), sprintf(msg, "Monte Carlo input %d needs a path", num + 1));
+    ASSERT(cJSON_IsString(jdist), sprintf(msg, "Monte Carlo %s needs a distribution", jpath->valuestring));
+    for (d = 0; d < (int)(sizeof(names) / sizeof(names[0])); d++)
+      if (strcmp(jdist->valuestring, names[d]) == 0)
+        break;
+    ASSERT(d < (int)(sizeof(names) / sizeof(names[0])),
+           sprintf(msg, "Monte Carlo %s has an unknown distribution: %s", jpath->valuestring, jdist->valuestring));
+
+    memset(in, 0, sizeof(MC_INPUT));
+    in->path = jpath->valuestring;
+    in->dist = (enum MC_DISTRIBUTION)d;
+    in->min = -HUGE_VAL;
+    in->max = HUGE_VAL;
+    if ((jitem = cJSON_GetObjectItem(jin, "min")) && cJSON_IsNumber(jitem)) in->min = jitem->valuedouble;
+    if ((jitem = cJSON_GetObjectItem(jin, "max")) && cJSON_IsNumber(jitem)) in->max = jitem->valuedouble;
+    if ((jitem = cJSON_GetObjectItem(jin, "mode")) && cJSON_IsNumber(jitem)) in->mode = jitem->valuedouble;
+    if ((jitem = cJSON_GetObjectItem(jin, "mean")) && cJSON_IsNumber(jitem)) in->mean = jitem->valuedouble;
+    if ((jitem = cJSON_GetObjectItem(jin, "sd")) && cJSON_IsNumber(jitem)) in->sd = jitem->valuedouble;
+    in->integer = cJSON_IsTrue(cJSON_GetObjectItem(jin, "integer"));
+    in->values = cJSON_GetObjectItem(jin, "values");
+
+    switch (in->dist) {
+    case MC_UNIFORM:
+      ASSERT(isfinite(in->min) && isfinite(in->max) && in->max >= in->min,
+             sprintf(msg, "Monte Carlo %s needs a min and max", in->path));
+      break;
+    case MC_NORMAL:
+      ASSERT(cJSON_IsNumber(cJSON_GetObjectItem(jin, "mean")) && in->sd >= 0.0 && in->max >= in->min,
+             sprintf(msg, "Monte Carlo %s needs a mean and an sd", in->path));
+      break;
+    case MC_TRIANGULAR:
+      ASSERT(isfinite(in->min) && isfinite(in->max) && in->min <= in->mode && in->mode <= in->max && in->max > in->min,
+             sprintf(msg, "Monte Carlo %s needs min <= mode <= max", in->path));
+      break;
+    case MC_CHOICE:
+      ASSERT(cJSON_IsArray(in->values) && cJSON_GetArraySize(in->values) > 0,
+             sprintf(msg, "Monte Carlo %s needs at least one value", in->path));
+      break;
+    }
+    num++;
+  }
+  return num;
+}
+
+// Draw the next value of input and set it in the audit input
+static void mc_draw(cJSON *json_input, MC_INPUT *input) {
+  cJSON *jvalue;
+  double u = mc_uniform(), x = 0.0;
+
+  switch (input->dist) {
+  case MC_UNIFORM:
+    x = input->min + u * (input->max - input->min);
+    break;
+  case MC_NORMAL: { // Box-Muller, limited to min..max
+    double u1 = 1.0 - u; // (0,1]
+    x = input->mean + input->sd * sqrt(-2.0 * log(u1)) * cos(2.0 * PI * mc_uniform());
+    x = MIN(MAX(x, input->min), input->max);
+    break;
+  }
+  case MC_TRIANGULAR: { // inverse of the distribution function
+    double range = input->max - input->min;
+    if (u < (input->mode - input->min) / range)
+      x = input->min + sqrt(u * range * (input->mode - input->min));
+    else
+      x = input->max - sqrt((1.0 - u) * range * (input->max - input->mode));
+    break;
+  }
+  case MC_CHOICE:
+    set_input_value(json_input, input->path, cJSON_GetArrayItem(input->values, (int)(u * cJSON_GetArraySize(input->values))));
+    return;
+  }
+
+  if (input->integer)
+    x = floor(x + 0.5);
+  jvalue = cJSON_CreateNumber(x);
+  set_input_value(json_input, input->path, jvalue);
+  cJSON_Delete(jvalue);
+}
+
+// Uniform random number in [0,1), splitmix64 so a seed draws the same
+// numbers on every platform
+static double mc_uniform(void) {
+  uint64_t z = (mc_state += 0x9E3779B97F4A7C15ULL);
+
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  z ^= z >> 31;
+  return (double)(z >> 11) * (1.0 / 9007199254740992.0); // 53 bits
+}
+
+// Add the SIR and savings of every measure of the last run to list, a
+// measure is the same one when its measure_id, name and components are
+static void mc_add_measures(MC_MEASURE *list, int *num, int sample, int num_sample) {
+  for (int i = 0; i < mor->num_measure; i++) {
+    MHEA_MEASURE *pm = &mor->measure[i];
+    int m;
+
+    for (m = 0; m < *num; m++)
+      if (list[m].measure_id == pm->measure_id && strcmp(list[m].measure, pm->measure) == 0 &&
+          strcmp(list[m].components, pm->components) == 0)
+        break;
+    if (m == *num) {
+      ASSERT(*num < MAXECMS, sprintf(msg, "Monte Carlo found more than %d measures", MAXECMS));
+      list[m].measure_id = pm->measure_id;
+      STRCPY(list[m].measure, pm->measure);
+      STRCPY(list[m].components, pm->components);
+      ASSERT((list[m].sir = (float *)malloc(num_sample * sizeof(float))) &&
+                 (list[m].savings = (float *)malloc(num_sample * sizeof(float))),
+             sprintf(msg, "Out of memory on Monte Carlo measures"));
+      (*num)++;
+    }
+    else if (list[m].last == sample) // listed twice in one run, keep the first
+      continue;
+    list[m].last = sample;
+    list[m].sir[list[m].count] = pm->sir;
+    list[m].savings[list[m].count] = pm->savings;
+    list[m].count++;
+  }
+}
+
+static int compare_float(const void *a, const void *b) {
+  float x = *(const float *)a, y = *(const float *)b;
+  return (x > y) - (x < y);
+}
+
+// The pct percentiles of the n values, interpolated between the sorted
+// values.  Sorts values.
+static cJSON *mc_percentiles(float *values, int n, const double *pct, int num_pct) {
+  cJSON *jarray = cJSON_CreateArray();
+
+  qsort(values, n, sizeof(float), compare_float);
+  for (int p = 0; p < num_pct && n > 0; p++) {
+    double at = pct[p] / 100.0 * (n - 1);
+    int i = (int)at;
+    double v = (i + 1 < n) ? values[i] + (at - i) * (values[i + 1] - values[i]) : values[n - 1];
+    cJSON_AddItemToArray(jarray, cJSON_CreateNumber(WA_DBL_FMT(v, 3)));
+  }
+  return jarray;
+}
+
+/***************************************************************************
+ ** Function Name: run_mhea_session
+ **
+ **  DESCRIPTION:  What-if session on the audit in json_input.  Each line of
+ **                edits_path ("-" for standard input) is a JSON Patch
+ **                (RFC 6902), eg.
+ **
+ **                  [{"op": "replace", "path": "/windows/0/glazing", "value": "D"}]
+ **
+ **                Blank lines and lines starting with # are skipped.  The
+ **                parsed input and schema stay resident; each edit patches
+ **                the input, reads it into mdi and runs the engine again,
+ **                the weather data kept while the station stays the same.
+ **                An edit that does not apply, or leaves an audit the
+ **                input schema does not allow, is reported and leaves the
+ **                audit as it was.  Writes one line per run, the full
+ **                results of the audit as loaded first (edit 0), flushed
+ **                so a client on a pipe sees each as soon as it is done.
+ **************************************************************************/
+void run_mhea_session(const char *edits_path, cJSON *json_input, cJSON *json_schema) {
+  FILE *edits, *out;
+  char *line;
+  int edit = 0;
+
+  if (strcmp(edits_path, "-") == 0) {
+    ASSERT(strcmp(cmds.input_file_path, STD_INPUT) != 0, sprintf(msg, "Session edits and audit input can not both come from standard input"));
+    edits = stdin;
+  } else {
+    edits = fopen(edits_path, "r");
+    ASSERT(edits, sprintf(msg, "Failed to open the session edits: %s code:%d:%s", edits_path, errno, strerror(errno)));
+  }
+  if (strcmp(cmds.output_file_path, STD_OUTPUT) == 0) {
+    out = stdout;
+  } else {
+    out = fopen(cmds.output_file_path, "wb");
+    ASSERT(out, sprintf(msg, "Failed to open the json results output file: %s code:%d:%s", cmds.output_file_path, errno, strerror(errno)));
+  }
+  ASSERT((line = (char *)malloc(SESSION_EDIT_LEN)), sprintf(msg, "Out of memory on the session edit line"));
+
+  sweep_run(); // the audit as loaded
+  session_write(out, edit, mhea_json_result(mdi, mor), NULL);
+
+  while (fgets(line, SESSION_EDIT_LEN, edits)) {
+    char *text = line;
+    cJSON *jpatch, *jpatched;
+    const char *error;
+    clock_t start = clock();
+
+    while (isspace((unsigned char)*text))
+      text++;
+    if (*text == '\0' || *text == '#')
+      continue;
+    edit++;
+    ASSERT(strchr(text, '\n') || feof(edits), sprintf(msg, "Session edit %d is longer than %d characters", edit, SESSION_EDIT_LEN - 1));
+
+    if ((jpatch = cJSON_Parse(text)) == NULL) {
+      session_write(out, edit, NULL, "Edit is not JSON");
+      continue;
+    }
+    jpatched = cJSON_Duplicate(json_input, TRUE); // so a failed edit leaves the audit as it was
+    error = json_patch_apply(jpatched, jpatch);
+    cJSON_Delete(jpatch);
+    if (error == NULL)
+      error = json_schema_check(jpatched, json_schema); // before the engine can ASSERT on it
+    if (error) {
+      cJSON_Delete(jpatched);
+      session_write(out, edit, NULL, error);
+      continue;
+    }
+    json_set_item_value(json_input, jpatched);
+    cJSON_Delete(jpatched);
+
+    memset(mdi, 0, sizeof(MDI));
+    mhea_json_read(mdi, json_input, json_schema);
+    sweep_run();
+    session_write(out, edit, mhea_json_result(mdi, mor), NULL);
+
+    if (cmds.debug_level & D_NORMAL)
+      fprintf(stderr, "\n\nSESSION: edit %d in %.1f ms", edit, 1000.0 * (clock() - start) / CLOCKS_PER_SEC);
+  }
+
+  free(line);
+  if (edits != stdin)
+    fclose(edits);
+  if (out != stdout)
+    fclose(out);
+}
+
+// Write one session line, the results of an edit or why it was not applied
+static void session_write(FILE *out, int edit, cJSON *jresult, const char *error) {
+  cJSON *jroot = cJSON_CreateObject();
+  char *output;
+
+  cJSON_AddNumberToObject(jroot, "edit", edit);
+  if (error)
+    cJSON_AddStringToObject(jroot, "error", error);
+  else
+    cJSON_AddItemToObject(jroot, "results", jresult);
+
+  output = cJSON_PrintUnformatted(jroot); // one line per edit whatever the format setting
+  fprintf(out, "%s\n", output);
+  fflush(out);
+
+  free(output);
+  cJSON_Delete(jroot);
+}
+
+/***************************************************************************
+ ** Function Name: run_mhea_sensitivity
+ **
+ **  DESCRIPTION:  One at a time sensitivity of the audit in json_input.
+ **                The spec file holds
+ **
+ **                  {"step": 0.01, "central": false,
+ **                   "fields": ["/audit", "/windows/0/width"]}
+ **
+ **                where each field is a JSON pointer into the audit input,
+ **                every number under it perturbed in turn (the whole input
+ **                when there is no fields list).  A field moves by step of
+ **                its value, by whole units when the input schema makes
+ **                it an integer, up only or up and down (central).
+ **                Fields whose value is zero, codes (an enum in the input schema) and those the
+ **                sens_dependency[] table shows can change no result are
+ **                not perturbed.  Writes the results of the unperturbed
+ **                run and, for each field, the normalized sensitivity
+ **                (dY/Y)/(dX/X) of the base case heating and cooling and
+ **                of the first pass SIR of each measure: null where Y is
+ **                zero or the measure was not evaluated.
+ **************************************************************************/
+void run_mhea_sensitivity(const char *spec_path, cJSON *json_input, cJSON *json_schema) {
+  cJSON *jspec = parse_json_file(spec_path);
+  cJSON *jstep = cJSON_GetObjectItem(jspec, "step");
+  cJSON *jfields = cJSON_GetObjectItem(jspec, "fields");
+  cJSON *jresult = cJSON_CreateObject();
+  cJSON *jbase, *jlist, **jrow;
+  SENS_FIELD *field;
+  SENS_POINT *base, *up, *down;
+  double step = cJSON_IsNumber(jstep) ? jstep->valuedouble : 0.01;
+  int central = cJSON_IsTrue(cJSON_GetObjectItem(jspec, "central"));
+  char path[PATH_LEN];
+  int num_field = 0;
+
+  ASSERT(step > 0.0 && step < 1.0, sprintf(msg, "Sensitivity step must be more than 0 and less than 1"));
+  ASSERT((field = (SENS_FIELD *)calloc(SENS_MAX_FIELDS, sizeof(SENS_FIELD))) &&
+             (jrow = (cJSON **)calloc(SENS_MAX_FIELDS, sizeof(cJSON *))) &&
+             (base = (SENS_POINT *)calloc(3, sizeof(SENS_POINT))),
+         sprintf(msg, "Out of memory on the sensitivity fields"));
+  up = base + 1;
+  down = base + 2;
+
+  if (jfields) {
+    cJSON *jfield;
+    ASSERT(cJSON_IsArray(jfields), sprintf(msg, "Sensitivity fields must be an array of JSON pointers"));
+    cJSON_ArrayForEach(jfield, jfields) {
+      cJSON *item;
+      ASSERT(cJSON_IsString(jfield) && (item = json_pointer_item(json_input, jfield->valuestring)),
+             sprintf(msg, "No audit input field at %s", cJSON_IsString(jfield) ? jfield->valuestring : "(not a string)"));
+      STRCPY(path, jfield->valuestring);
+      sens_collect(item, path, field, &num_field);
+    }
+  } else {
+    path[0] = '\0';
+    sens_collect(json_input, path, field, &num_field);
+  }
+
+  // the unperturbed run, its measures are the ones reported
+
+  memset(&sens, 0, sizeof(sens));
+  memset(mdi, 0, sizeof(MDI));
+  mhea_json_read(mdi, json_input, json_schema);
+  memset(mir, 0, sizeof(MIR));
+  memset(mor, 0, sizeof(MOR));
+  run_mhea_first_pass();
+  sens.runs++;
+
+  for (int i = 0; i < mir->Rndx; i++) {
+    BCR_RES *res = &mir->Results[i];
+    sens.measure[i].measure_id = res->measure_id;
+    STRCPY(sens.measure[i].measure, res->sName);
+    STRCPY(sens.measure[i].components, res->sComponents);
+  }
+  sens.num_measure = mir->Rndx;
+  sens_point(base);
+
+  jbase = cJSON_CreateObject();
+  cJSON_AddNumberToObject(jbase, "pre_heat", WA_DBL_FMT(base->heat / 1e6, 1));
+  cJSON_AddNumberToObject(jbase, "pre_cool", WA_DBL_FMT(base->cool / 1e6 * KWH_PER_MMBTU, 1));
+  cJSON_AddItemToObject(jbase, "measures", jlist = cJSON_CreateArray());
+  for (int m = 0; m < sens.num_measure; m++) {
+    cJSON *jitem = cJSON_CreateObject();
+    cJSON_AddNumberToObject(jitem, "measure_id", sens.measure[m].measure_id);
+    cJSON_AddStringToObject(jitem, "measure",    sens.measure[m].measure);
+    cJSON_AddStringToObject(jitem, "components", sens.measure[m].components);
+    cJSON_AddNumberToObject(jitem, "sir",        WA_DBL_FMT(base->sir[m], 3));
+    cJSON_AddItemToArray(jlist, jitem);
+  }
+
+  // price fields first, while the first pass is still the unperturbed one
+
+  for (int pass = 0; pass < 2; pass++) {
+    for (int f = 0; f < num_field; f++) {
+      SENS_FIELD *fld = &field[f];
+      cJSON *entry;
+      double dx, x_up, x_down, taken;
+
+      if ((fld->depends == SENS_PRICE) != (pass == 0))
+        continue;
+
+      jrow[f] = cJSON_CreateObject();
+      cJSON_AddStringToObject(jrow[f], "path", fld->path);
+      cJSON_AddNumberToObject(jrow[f], "value", fld->value);
+
+      entry = sens_schema_entry(json_schema, fld->path);
+      if (fld->depends == SENS_NONE) {
+        cJSON_AddStringToObject(jrow[f], "skipped", "no effect");
+        continue;
+      } else if (cJSON_GetObjectItem(entry, "enum")) {
+        cJSON_AddStringToObject(jrow[f], "skipped", "code");
+        continue;
+      } else if (fld->value == 0.0) {
+        cJSON_AddStringToObject(jrow[f], "skipped", "zero");
+        continue;
+      }
+
+      if (cmds.debug_level & D_NORMAL)
+        fprintf(stderr, "\n\nSENSITIVITY: field %d of %d %s", f + 1, num_field, fld->path);
+
+      dx = fabs(fld->value) * step;
+      if (sens_schema_integer(entry)) // read as an integer
+        dx = MAX(1.0, floor(dx + 0.5));
+      x_up = fld->value + dx;
+      x_down = central ? fld->value - dx : fld->value;
+
+      sens_evaluate(fld, x_up, json_input, json_schema, up);
+      if (central)
+        sens_evaluate(fld, x_down, json_input, json_schema, down);
+      else
+        *down = *base;
+
+      taken = (x_up - x_down) / fld->value; // relative step as taken
+      cJSON_AddNumberToObject(jrow[f], "step", WA_DBL_FMT(taken, 4));
+      if (fld->depends == SENS_ALL) {
+        cJSON_AddItemToObject(jrow[f], "pre_heat", sens_normalized(up->heat, down->heat, base->heat, taken));
+        cJSON_AddItemToObject(jrow[f], "pre_cool", sens_normalized(up->cool, down->cool, base->cool, taken));
+      } else { // the base case does not depend on the field
+        cJSON_AddNumberToObject(jrow[f], "pre_heat", 0);
+        cJSON_AddNumberToObject(jrow[f], "pre_cool", 0);
+      }
+      cJSON_AddItemToObject(jrow[f], "sir", jlist = cJSON_CreateArray());
+      for (int m = 0; m < sens.num_measure; m++) {
+        if (up->has[m] && down->has[m])
+          cJSON_AddItemToArray(jlist, sens_normalized(up->sir[m], down->sir[m], base->sir[m], taken));
+        else
+          cJSON_AddItemToArray(jlist, cJSON_CreateNull());
+      }
+    }
+  }
+
+  memset(mdi, 0, sizeof(MDI)); // leave mdi as parsed
+  mhea_json_read(mdi, json_input, json_schema);
+
+  cJSON_AddNumberToObject(jresult, "step", step);
+  cJSON_AddBoolToObject(jresult, "central", central);
+  cJSON_AddNumberToObject(jresult, "runs", sens.runs);
+  cJSON_AddNumberToObject(jresult, "repriced", sens.repriced);
+  cJSON_AddItemToObject(jresult, "base", jbase);
+  cJSON_AddItemToObject(jresult, "fields", jlist = cJSON_CreateArray());
+  for (int f = 0; f < num_field; f++)
+    cJSON_AddItemToArray(jlist, jrow[f]);
+
+  free(field);
+  free(jrow);
+  free(base);
+
+  sweep_write("sensitivity", jresult);
+  cJSON_Delete(jspec);
+}
+
+// Add every number at or under item to field, path being its JSON pointer
+static void sens_collect(cJSON *item, char *path, SENS_FIELD *field, int *num) {
+  size_t len = strlen(path);
+  cJSON *child;
+  int index = 0;
+
+  if (cJSON_IsNumber(item)) {
+    ASSERT(*num < SENS_MAX_FIELDS, sprintf(msg, "Sensitivity has more than %d fields", SENS_MAX_FIELDS));
+    STRCPY(field[*num].path, path);
+    field[*num].item = item;
+    field[*num].value = item->valuedouble;
+    field[*num].depends = sens_depends(path);
+    (*num)++;
+    return;
+  }
+
+  cJSON_ArrayForEach(child, item) {
+    if (cJSON_IsArray(item))
+      snprintf(path + len, PATH_LEN - len, "/%d", index++);
+    else
+      snprintf(path + len, PATH_LEN - len, "/%s", child->string);
+    sens_collect(child, path, field, num);
+  }
+  path[len] = '\0';
+}
+
+// What the field at path can change, from sens_dependency[]
+static enum SENS_DEPENDS sens_depends(const char *path) {
+  for (size_t d = 0; d < sizeof(sens_dependency) / sizeof(sens_dependency[0]); d++) {
+    const char *pattern = sens_dependency[d].path, *p = path;
+    int matches = TRUE;
+
+    while (matches && *pattern == '/') { // step by step
+      size_t pattern_len = strcspn(pattern + 1, "/");
+      size_t step_len = strcspn(p + 1, "/");
+
+      matches = *p == '/' && sens_step_matches(pattern + 1, pattern_len, p + 1, step_len);
+      pattern += pattern_len + 1;
+      p += step_len + 1;
+    }
+    if (matches)
+      return sens_dependency[d].depends;
+  }
+  return SENS_ALL;
+}
+
+// A step of a field's path against one of a pattern, * leading and
+// trailing the pattern standing for any characters
+static int sens_step_matches(const char *pattern, size_t pattern_len, const char *step, size_t step_len) {
+  int any_before = pattern_len > 0 && pattern[0] == '*';
+  int any_after = pattern_len > 1 && pattern[pattern_len - 1] == '*';
+  size_t len;
+
+  if (any_before) {
+    pattern++;
+    pattern_len--;
+  }
+  len = pattern_len - any_after;
+
+  if (len > step_len)
+    return FALSE;
+  if (any_before && any_after) {
+    for (size_t i = 0; i + len <= step_len; i++)
+      if (strncmp(step + i, pattern, len) == 0)
+        return TRUE;
+    return FALSE;
+  } else if (any_before) {
+    return strncmp(step + step_len - len, pattern, len) == 0;
+  } else if (any_after) {
+    return strncmp(step, pattern, len) == 0;
+  }
+  return len == step_len && strncmp(step, pattern, len) == 0;
+}
+
+// The input schema entry of the field at path, NULL if it has none
+static cJSON *sens_schema_entry(cJSON *json_schema, const char *path) {
+  cJSON *node = json_schema;
+  char step[PATH_LEN];
+
+  while (node && *path == '/') {
+    size_t len = strcspn(path + 1, "/");
+    cJSON *properties;
+
+    snprintf(step, sizeof(step), "%.*s", (int)len, path + 1);
+    path += len + 1;
+
+    node = sens_schema_ref(json_schema, node);
+    properties = cJSON_GetObjectItem(node, "properties");
+    if (cJSON_GetObjectItem(properties, step))
+      node = cJSON_GetObjectItem(properties, step);
+    else
+      node = cJSON_GetObjectItem(node, "items"); // an array element
+  }
+  return sens_schema_ref(json_schema, node);
+}
+
+// Follow a schema entry's local $ref to the definition it stands for
+static cJSON *sens_schema_ref(cJSON *json_schema, cJSON *node) {
+  cJSON *ref;
+
+  for (int i = 0; i < 8 && node && cJSON_IsString(ref = cJSON_GetObjectItem(node, "$ref")) && ref->valuestring[0] == '#'; i++)
+    node = json_pointer_item(json_schema, ref->valuestring + 1);
+  return node;
+}
+
+// The schema entry makes the field an integer
+static int sens_schema_integer(cJSON *entry) {
+  cJSON *jtype = cJSON_GetObjectItem(entry, "type");
+  cJSON *jitem;
+
+  if (cJSON_IsString(jtype))
+    return strcmp(jtype->valuestring, "integer") == 0;
+  cJSON_ArrayForEach(jitem, jtype) {
+    if (cJSON_IsString(jitem) && strcmp(jitem->valuestring, "integer") == 0)
+      return TRUE;
+  }
+  return FALSE;
+}
+
+// The audit with field f set to value, as far as the first pass
+static void sens_evaluate(SENS_FIELD *f, double value, cJSON *json_input, cJSON *json_schema, SENS_POINT *point) {
+  cJSON_SetNumberValue(f->item, value);
+  memset(mdi, 0, sizeof(MDI));
+  mhea_json_read(mdi, json_input, json_schema);
+  cJSON_SetNumberValue(f->item, f->value);
+
+  if (f->depends == SENS_PRICE) { // none of the measures' energy use depends on it
+    initialize_fuel_cost_data(mdi->fcs, mdi->fer, 1.0f + (mdi->key.real_discount_rate / 100.0f));
+    reprice_first_pass_retrofits();
+    sens.repriced++;
+  } else {
+    memset(mir, 0, sizeof(MIR));
+    memset(mor, 0, sizeof(MOR));
+    run_mhea_first_pass();
+    sens.runs++;
+  }
+  sens_point(point);
+}
+
+// Results of the first pass in mir, matched to the unperturbed measures
+static void sens_point(SENS_POINT *point) {
+  char used[MAXECMS] = {0};
+
+  point->heat = mir->fBasecase_Heating;
+  point->cool = mir->fBasecase_Cooling;
+
+  for (int m = 0; m < sens.num_measure; m++) {
+    SENS_MEASURE *measure = &sens.measure[m];
+
+    point->has[m] = FALSE;
+    for (int i = 0; i < mir->Rndx && !point->has[m]; i++) { // the pass sorts by SIR, so search
+      BCR_RES *res = &mir->Results[i];
+      if (!used[i] && res->measure_id == measure->measure_id && strcmp(res->sName, measure->measure) == 0 &&
+          strcmp(res->sComponents, measure->components) == 0) {
+        used[i] = TRUE;
+        point->has[m] = TRUE;
+        point->sir[m] = res->fBCR;
+      }
+    }
+  }
+}
+
+// (dY/Y)/(dX/X) from Y up and down and the relative step dX/X, null for Y zero
+static cJSON *sens_normalized(double up, double down, double base, double step) {
+  if (base == 0.0)
+    return cJSON_CreateNull();
+  return cJSON_CreateNumber(WA_DBL_FMT((up - down) / base / step, 4));
+}
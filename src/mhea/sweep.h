@@ -0,0 +1,23 @@
+/***************************************************************************
+* MODULE:       sweep.h            CREATED:      10/19/2026
+*
+* AUTHOR:       ORNL Weatherization Assistant
+*
+* MDESC:        Repeated MHEA runs of one parsed audit
+****************************************************************************/
+#ifndef _SWEEP_H
+#define _SWEEP_H
+
+void sweep_begin(void);
+void sweep_restore(void);
+void sweep_run(void);
+cJSON *sweep_row(void);
+void sweep_end(void);
+
+void run_mhea_weather_sweep(const char *station_list_path);
+void run_mhea_parametric_sweep(const char *spec_path, cJSON *json_input, cJSON *json_schema);
+void run_mhea_monte_carlo(const char *spec_path, cJSON *json_input, cJSON *json_schema);
+void run_mhea_session(const char *edits_path, cJSON *json_input, cJSON *json_schema);
+void run_mhea_sensitivity(const char *spec_path, cJSON *json_input, cJSON *json_schema);
+
+#endif
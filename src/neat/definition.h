@@ -309,7 +309,6 @@
 
 #define NMAT N_MAT_DUCT_SEALING + 1         // maximum number of materials both measure_cost inputs and a few others
 #define NMAT_OTHER MAX_LTG + 10             // extra 'other' materials at the end of the rmc[] array
-#define MAX_INERACTIONS_PER_MEASURE 11      // Max number of interactions for any single measure
 
 #define N_MAX_RMC NMAT + NMAT_OTHER     // how big to dimension array
 
@@ -166,6 +166,7 @@ void first_pass_measures(void) {
     jm = measure_execution_order[je];       // jm is fixed measure number, je is execution order
     //if (nir->implement[jm]) {               // the implement flag is set so evaluate the measure
     if (ndi->cms[jm].active) {               // the implement flag is set so evaluate the measure
+      performance_count(PC_MEASURES);
       switch (jm) {
 
       //  Thermal Envelope Measures
@@ -3999,6 +4000,8 @@ static void lighting_replacement(void) {
       }
       STRCPY(ndi->rmc[rmc_index].units, "Each");
       STRCPY(nir->ecm[nm].components, ltg.code);
+      component_set_clear(&nir->ecm[nm].component_set);
+      component_set_add_code(&nir->ecm[nm].component_set, ltg.code);
 
       ndi->rmc[rmc_index].quant = ltg.new_lamp_count;
       nir->ecm[nm].cost = cost;
@@ -5360,11 +5363,14 @@ static int heating_repacement_material_high_efficiency(void) {
 }
 
 static void add_component_code(char *code){
+  component_set_add_code(&nir->ecm[nir->nms].component_set, code);
   STRCAT(nir->ecm[nir->nms].components, code);
   STRNCAT(nir->ecm[nir->nms].components, ",", 1);   // must be there for cumulative pass for component code searches, last comma removed later
 }
 
 static void add_component_code_once(char *code){
+  component_set_clear(&nir->ecm[nir->nms].component_set);
+  component_set_add_code(&nir->ecm[nir->nms].component_set, code);
   STRCPY(nir->ecm[nir->nms].components, code);
   STRNCAT(nir->ecm[nir->nms].components, ", ", 1);   // must be there for cumulative pass for component code searches, last comma removed later
 }
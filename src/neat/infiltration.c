@@ -115,10 +115,9 @@ void duct_efficiency_NEAT(float Q50, float supply_pa, float return_pa, float *ef
   // FILE *outputf2;
   // FILE *outputf;
   int return_reg_num;
-  int i, m, nhtm, nclm;
+  int i;
 
-  float arg, asBs, arBr, Qinf15, Qimb15, wout, wdum, win;
-  float tom, tdb_max_cl, tdb_min_ht, rhatmax;
+  float arg, asBs, arBr, Qinf15, Qimb15, wout, win;
 
   int compute_ducts = 1;
 
@@ -126,7 +125,6 @@ void duct_efficiency_NEAT(float Q50, float supply_pa, float return_pa, float *ef
       tin_cl,          // Indoor air temperature, cooling
       tdb_ht,          // Outdoor dry bulb temperature, heating
       tdb_cl,          // Outdoor dry bulb temperature, cooling
-      RH,              // Seasonal (summer) relative humidity
       tground,         // Ground temperature (year-round)
       tsp,             // Supply pleum dry-bulb temperature, cooling
                        //    totarea,             Total living space floor area
@@ -243,6 +241,9 @@ void duct_efficiency_NEAT(float Q50, float supply_pa, float return_pa, float *ef
       compute_ducts = 0;
   }
 
+  Qinf = 8.0f * 0.35f * ndi->gnl.floor_area / 60; // Based on 0.35 ACH infiltration
+  Qinf15 = (float)(POWC(Qinf, 1.5f));             // both seasons' imbalance flow, Qnet
+
   // Avoid unititalized variables in compiler warings for Aout_S intialization if
   // we are not going to compute ducts
   if (compute_ducts != 0) {
@@ -283,53 +284,14 @@ void duct_efficiency_NEAT(float Q50, float supply_pa, float return_pa, float *ef
     //    &tdb_ht, &tdb_cl, &htdestemp, &cldestemp, &RH, &totarea, &Ecap_ht, &Ecap_cl,
     //    &ductR_S, &Qs_ht, &Qs_cl))==11;) [if used would have squiggly bracket here]
 
-    /*  Find the average heating and cooling outdoor ambient temperatures and RH.
-    *  Cooling is average of monthly temperautures above 65 F, heating those below.
-    *  If no monthly temperatures are above or below 65 to form seasonal average,
-    *  use the maximum or minumum monthly temperatures as the average. */
-
-    tdb_ht = tdb_cl = 0.0f;
-    nhtm = nclm = 0;
-    RH = 0.0f;
-    tdb_min_ht = 100.0f;
-    tdb_max_cl = -100.0f;
-    for (m = 1; m <= MONTHS; m++) {
-      tom = cwd->avg_drybulb_temp[m];
-      if (tom < 65.0f) {
-        if (m == DECEMBER || m < APRIL) {
-          tdb_ht += tom;
-          nhtm++;
-        }
-      }
-      if (tom < tdb_min_ht)
-        tdb_min_ht = tom;
-      if (tom > 65.0f) {
-        tdb_cl += tom;
-        RH += relative_humidity(tom, cwd->avg_wetbulb_temp[m], cwd->altitude);
-        nclm++;
-      }
-      if (tom > tdb_max_cl) {
-        tdb_max_cl = tom;
-        rhatmax = relative_humidity(tdb_max_cl, cwd->avg_wetbulb_temp[m], cwd->altitude);
-      }
-    }
+    // Seasonal outdoor temperatures and RH, found once per weather file by duct_psychrometrics()
 
-    if (nhtm > 0)
-      tdb_ht /= (float)nhtm;
-    else
-      tdb_ht = tdb_min_ht;
-    if (nclm > 0) {
-      tdb_cl /= (float)nclm;
-      RH /= (float)nclm;
-    } else {
-      tdb_cl = tdb_max_cl;
-      RH = rhatmax;
-    }
+    tdb_ht = cwd->duct_psy_monthly.tdb_ht;
+    tdb_cl = cwd->duct_psy_monthly.tdb_cl;
 
     // Derived values
 
     tground = (cwd->heating_design_temp + cwd->cooling_design_temp) / 2.0f;
-    Qinf = 8.0f * 0.35f * ndi->gnl.floor_area / 60; // Based on 0.35 ACH infiltration
     if (ndi->htg[PRIMARY].duct_location == SUBSPACE) {    // Ducts in uninsulated basement
       tamb_R_ht = tamb_S_ht = (5.0f * tground + 2.0f * tdb_ht + 3.0f * tin_ht) / 10.0f;
       tamb_R_cl = tamb_S_cl = (5.0f * tground + 2.0f * tdb_cl + 3.0f * tin_cl) / 10.0f;
@@ -413,7 +375,6 @@ void duct_efficiency_NEAT(float Q50, float supply_pa, float return_pa, float *ef
     /***** Compute the imbalance flow, Qnet ******/
 
     Qimb = (float)(fabs((float)(Qs_ht - Qr_ht)));
-    Qinf15 = (float)(POWC(Qinf, 1.5f));
     if (Qimb < 1.0e-3)
       Qnet_ht = (float)(POWC(Qinf15, 0.67f));
     else {
@@ -480,13 +441,14 @@ void duct_efficiency_NEAT(float Q50, float supply_pa, float return_pa, float *ef
 
     /****** Compute the cooling season return enthalpy from psychometrics *****/
 
-    hout = enthalpy(tdb_cl, RH, tdb_cl, &wout);
+    hout = cwd->duct_psy_monthly.hout;
+    wout = cwd->duct_psy_monthly.w;
     win = 0.004f + 0.4f * wout; // Per e-mail of 5/22/00 from Iain Walker
     hin = 0.240f * tin_cl + win * (1061.0f + 0.444f * tin_cl);
     if (ndi->htg[PRIMARY].duct_location == SUBSPACE || Fout_R == 0.0)
       hamb_R = hin;
     else {
-      hamb_R = enthalpy(tdb_cl, RH, tamb_R_cl, &wdum);
+      hamb_R = moist_air_enthalpy(tamb_R_cl, wout);
       if (hamb_R < hin)
         hamb_R = (hamb_R + hout) / 2.0f;
     }
@@ -20,6 +20,7 @@ struct measure {
   enum MEASURE_COMPONENT_GROUP_TYPE comp_group_type;    // component grouping type/category
   int  comp_group_num;                                  // number within that type (based on .measure_number input from user)
   char components[MAX_COMPONENTS_LEN + 1];              // list of component code strings effected by this measure
+  COMPONENT_SET component_set;                          // interned codes of the same components for interaction checks
   
   int dwelling_component_index;             // if measure associated with SINGLE specific dwelling component in audit_section_id, then which index, base 0
   
@@ -103,10 +104,7 @@ typedef struct {
     float save_dor_cfm_tot[MONTHS + 1]; // a copy of door cfm totals by month for comparison
 
     char measure_name[N_CMS_ITEMIZED_COST + MAX_ITC][MEASURENAME_LEN + 1];          // list of measure names
-    enum CONSERVATION_MEASURE_TYPE meas_type[N_CMS_ITEMIZED_COST + MAX_ITC];        // measure type codes, see initialize_neat_measure_exclusion() in neat.c (MJF 4/99 DEBUG - was only dimensioned to MAXMEAS)
-
-    int measure_exclusion[MAXMEAS][MAX_INERACTIONS_PER_MEASURE];                    // list of mutually exclusive measures
-    int measure_exclusion_count[MAXMEAS];                       // how many mutually exclusive measures for each measure
+    enum CONSERVATION_MEASURE_TYPE meas_type[N_CMS_ITEMIZED_COST + MAX_ITC];        // measure type codes, see initialize_neat_measure_types() in run_preparation.c (MJF 4/99 DEBUG - was only dimensioned to MAXMEAS)
 
     int billing_record_count[POST_COOLING + 1];                 // number of billing records in group
     int bill_year[POST_COOLING + 1][MONTHS + 1];                // year of each bill (yyyy)
@@ -622,7 +622,9 @@ void neat_json_read(NDI *top, cJSON *jtree, cJSON *jschema) {
 
   // At this point, we should have all data in NDI and can do sematic biz logic checks
 
+  phase_begin(PP_VALIDATION);
   ndi_check(top);
+  phase_end(PP_VALIDATION);
 
   // clean up
   if (jleaf)
@@ -1514,6 +1516,8 @@ void neat_json_result_write(NDI *top, NOR *res) {
 
   //clang-format on
 
+  add_performance_json(jroot); // -P, last so it times building the rest
+
   char *output = NULL;
   if (cmds.format_json_output) {
     output = cJSON_Print(jroot); // allocates the formatted JSON output string and returns it
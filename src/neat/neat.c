@@ -51,7 +51,9 @@ void run_neat(void) {
   ASSERT(nir, sprintf(msg, "You must have NEAT intermediate result structure to run engine"));
   ASSERT(nor, sprintf(msg, "You must have NEAT output result structure to run engine"));
 
-  initialize_neat_measure_exclusion();
+  phase_begin(PP_TRANSLATION); // the audit into the values the passes work from
+
+  initialize_neat_measure_types();
 
   initialize_billing();
 
@@ -63,7 +65,9 @@ void run_neat(void) {
 
   translate_neat_bil();
 
+  phase_begin(PP_WEATHER_LOAD);
   read_weather_file(&ndi->wth);
+  phase_end(PP_WEATHER_LOAD);
 
   // Apply climate adjustment factor to replacement HP and central AC efficiencies
 
@@ -335,8 +339,14 @@ void run_neat(void) {
     nir->save_dor_cfm_tot[m] = nir->dr_cfm_tot[m];
   }
 
+  phase_end(PP_TRANSLATION);
+
+  phase_begin(PP_SIZING);
   sizing_heating(PRE_RETROFIT);
   sizing_cooling(PRE_RETROFIT);
+  phase_end(PP_SIZING);
+
+  phase_begin(PP_TRANSLATION);
 
   // Assign the primary heating system output capacity IF missing or type is HEAT pump (units of kBtu/hr)
   if (ndi->htg[PRIMARY].output_capacity < .001f || ndi->htg[PRIMARY].system_type == HE_HEAT_PUMP) {
@@ -599,7 +609,11 @@ void run_neat(void) {
     fprintf(stderr, "\nAggregate cooling SEER: %7.3f", ndi->clgs.avg_seer);
   }
 
+  phase_end(PP_TRANSLATION);
+
+  phase_begin(PP_BASE_CASE);
   neat_energy_use("BASE CASE", PRE_RETROFIT);
+  phase_end(PP_BASE_CASE);
 
   if (ndi->htg[PRIMARY].retrofit_option == ES_TUNEUP_PERFORMED_EVAL_REP || ndi->htg[PRIMARY].retrofit_option == ES_STDEFF_REP_REQUIRED ||
       ndi->htg[PRIMARY].retrofit_option == ES_HIEFF_REP_REQUIRED) {
@@ -653,6 +667,7 @@ billing_adjust_loop_back:     //  <<<<<<<<<<<<<<=======================   loop b
 
   // Apply measures individually without interaction
 
+  phase_begin(PP_FIRST_PASS);
   first_pass_measures();     // FIRST PASS measures   <<<<<<<<=============
 
   measure_diag_print_all("Un-interacted values immediately after call to first_pass_measures()", UNSORTED);
@@ -681,6 +696,9 @@ billing_adjust_loop_back:     //  <<<<<<<<<<<<<<=======================   loop b
 
   measure_diag_print_all("Un-interacted values after FIRST pass ranking of measures", SORTED);
 
+  phase_end(PP_FIRST_PASS);
+
+  phase_begin(PP_INTERACTION_PASS);
   cumulative_interactive_effects();   // SECOND PACKAGE CONSTRUCTION PASS through the measures in decreasing SIR order
 
   prevent_sill_insulation_dropout();
@@ -696,10 +714,14 @@ billing_adjust_loop_back:     //  <<<<<<<<<<<<<<=======================   loop b
       *fpntr = '\0';
   }
 
+  phase_end(PP_INTERACTION_PASS);
+
   //  Perform sizing calculations (Manual J) on post-retrofit house 
 
+  phase_begin(PP_SIZING);
   sizing_heating(POST_RETROFIT);
   sizing_cooling(POST_RETROFIT);
+  phase_end(PP_SIZING);
 
   measure_diag_print_all("Measures list BEFORE sorting SECOND pass interacted measures, but after recombining window measures", SORTED);
 
@@ -751,18 +773,22 @@ billing_adjust_loop_back:     //  <<<<<<<<<<<<<<=======================   loop b
                        "infiltration reduction is necessary, then helps locate leaks and monitor progress in their elimination.");
     }
 
+    phase_begin(PP_REPORT);
     report_header(measfile, nir->adjflg);
     neat_results(measfile);
     report_materials(measfile);
     report_energy(measfile);
     report_measure_materials(); // fill in our cost detail materials
+    phase_end(PP_REPORT);
   }
 
   //  Manage billing computations for autoexecute
   //  Notice the branch back for post billing adjustment calculations
 
   if (nir->adjflg == 0) {
+    phase_begin(PP_BILLING_ADJUST);
     manage_neat_billing_adjustments(&nir->adjflg);
+    phase_end(PP_BILLING_ADJUST);
     if (nir->adjflg > 0)
       goto billing_adjust_loop_back;
   }
@@ -785,13 +811,17 @@ billing_adjust_loop_back:     //  <<<<<<<<<<<<<<=======================   loop b
     if (measfile)
       fprintf(measfile, "\n\n\n");
 
+    phase_begin(PP_REPORT);
     report_header(measfile, nir->adjflg);
     neat_results(measfile);
     report_materials(measfile);
     report_energy(measfile);
     report_measure_materials(); // fill in our cost detail materials
+    phase_end(PP_REPORT);
   }
 
+  phase_begin(PP_REPORT);
+
   nor->num_used_fuel = used_fuel_results(nor->used_fuel); // show the details for the fuels used
 
   if (measfile)
@@ -833,6 +863,8 @@ billing_adjust_loop_back:     //  <<<<<<<<<<<<<<=======================   loop b
   if (comparefile)
     fclose(comparefile);
 
+  phase_end(PP_REPORT);
+
   return; // all done, success
 }
 
@@ -907,6 +939,7 @@ static void recombine_window_measures() {
             nir->measure_required[il] = FALSE;
 
             STRCAT(nir->ecm[ecm_index].components, nir->ecm[il].components);
+            component_set_union(&nir->ecm[ecm_index].component_set, &nir->ecm[il].component_set);
 
             //  Add parameter needed for the measures tab of audit
 
@@ -957,6 +990,7 @@ void neat_energy_use(char *run_title, int phase) {
   }
 
   nor->energy_calc_counter++; // gitlab #47
+  performance_count(PC_ENERGY_CALLS);
 
   if (cmds.debug_level & D_NEAT_ENERGY_DETAIL_ALL || (phase == PRE_RETROFIT && (cmds.debug_level & D_NEAT_ENERGY_DETAIL_BASE))) {
     fprintf(stderr, "\n\n------------------START of NEAT_ENERGY_USE:%02d %s -------------------\n", nor->energy_calc_counter, run_title);
@@ -1615,10 +1649,25 @@ void neat_solar_storage(float fTempOutDay, float fSolarGainTotal, float fFreeHea
 /**                by FIRST decreasing measure_priority THEN by         **/
 /*                 decreasing btc (benefit to cost)                     **/
 /*************************************************************************/
+
+struct neat_rank_keys {
+  float *btc;                 // benefit to cost indexed by measure
+  int *measure_index;         // measure at each position on entry
+};
+
+// position a ranks ahead of position b, note nir->measure_priority[] is by position
+static int neat_measure_ranks_before(int a, int b, void *context) {
+  struct neat_rank_keys *keys = (struct neat_rank_keys *)context;
+  if (nir->measure_priority[a] != nir->measure_priority[b])
+    return (nir->measure_priority[a] > nir->measure_priority[b]);
+  return (keys->btc[keys->measure_index[a]] > keys->btc[keys->measure_index[b]]);
+}
+
 static void sort_neat_package_measures(float *l_btc, int l_nmst, int *sorted_measure_index) {
-  int flgSwap = 1;      // did we swap in the loop
-  int kbtctemp, mstemp; // temp values for swapping
-  int i;
+  int rank[MAX_RANK_ITEMS];
+  int measure_index[MAX_RANK_ITEMS];
+  enum MEASURE_PACKAGE_SORT_PRIORITY priority[MAX_RANK_ITEMS];
+  struct neat_rank_keys keys = { l_btc, measure_index };
 
   if (l_nmst < 2) // nothing to do - changed from 2 to 1, 8/09
     return;       // since prevented proper sorting with two measures.
@@ -1632,39 +1681,20 @@ static void sort_neat_package_measures(float *l_btc, int l_nmst, int *sorted_mea
   nir->measure_priority[l_nmst] = MPS_BOTTOM_MARK;
   l_btc[l_nmst] = MPS_BOTTOM_MARK;
 
-  while (flgSwap) // our simple bubble sort
-  {
-    flgSwap = 0;
-    for (i = 0; i < l_nmst; i++) {
-
-      // sorting first on measure_priority field
-
-      if (nir->measure_priority[i + 1] != // secondary sort key involved
-          nir->measure_priority[i]) {
-
-        if (nir->measure_priority[i + 1] > // out of order
-            nir->measure_priority[i]) {
-          kbtctemp = sorted_measure_index[i + 1];
-          sorted_measure_index[i + 1] = sorted_measure_index[i];
-          sorted_measure_index[i] = kbtctemp;
-          mstemp = nir->measure_priority[i + 1];
-          nir->measure_priority[i + 1] = nir->measure_priority[i];
-          nir->measure_priority[i] = mstemp;
-          flgSwap = 1;
-        }
-        continue;
-      }
+  // rank the positions, bottom mark included, then carry the measure
+  // index and its priority along to their new positions
 
-      // default sorting on BCR within each measure_priority group
+  for (int i = 0; i <= l_nmst; i++) {
+    rank[i] = i;
+    measure_index[i] = sorted_measure_index[i];
+    priority[i] = nir->measure_priority[i];
+  }
 
-      if (l_btc[sorted_measure_index[i + 1]] > // default sort key
-          l_btc[sorted_measure_index[i]]) {
-        kbtctemp = sorted_measure_index[i + 1];
-        sorted_measure_index[i + 1] = sorted_measure_index[i];
-        sorted_measure_index[i] = kbtctemp;
-        flgSwap = 1;
-      }
-    }
+  stable_rank(rank, l_nmst + 1, neat_measure_ranks_before, &keys);
+
+  for (int i = 0; i <= l_nmst; i++) {
+    sorted_measure_index[i] = measure_index[rank[i]];
+    nir->measure_priority[i] = priority[rank[i]];
   }
 }
 
@@ -1753,7 +1783,7 @@ static void prevent_sill_insulation_dropout( void){
     if (nir->ecm[i].cms_measure_num == N_CMS_SILLBOX_INSULATION){
       for (int k = 0; k < ic; k++) {
         int l = check[k];
-        if (components_in_common(nir->ecm[l].components, nir->ecm[i].components)) {
+        if (components_in_common(&nir->ecm[l].component_set, &nir->ecm[i].component_set)) {
           if (nir->ecm[i].sir >= ndi->key.minimum_acceptable_sir) {
             nir->measure_priority[i] = MPS_SIR;    // second_pass_measure_interaction(il)
           }
@@ -1792,6 +1822,8 @@ static void cumulative_interactive_effects(void) {
     int il = nir->index_by_sir[jl];                           // get the sir order index
     int cms_measure_num = nir->ecm[il].cms_measure_num;
 
+    performance_count(PC_MEASURES);
+
     ASSERT(nir->ecm[il].index == il, sprintf(msg, "The element %d does not match ecm[].index", il));
 
     switch (nir->meas_type[cms_measure_num]) {
@@ -1986,7 +2018,7 @@ static void cumulative_interactive_effects(void) {
 
         if (!mutually_exclusive_measures(cms_measure_num, nir->ecm[test_ecm_index].cms_measure_num))
           continue;
-        else if (!components_in_common(nir->ecm[test_ecm_index].components, nir->ecm[il].components))
+        else if (!components_in_common(&nir->ecm[test_ecm_index].component_set, &nir->ecm[il].component_set))
           continue;
         else if ((abs(nir->measure_priority[il]) >= abs(nir->measure_priority[test_ecm_index]) && nir->npv[il] > nir->npv[test_ecm_index]) || 
            abs(nir->measure_priority[il]) > MPS_SIR) {
@@ -14,6 +14,7 @@
 
 #include "wa_engine.h"\
 
+static void intern_component_codes(void);
 static void weather_initialize(void);
 static void window_initialize(void);
 static void door_initialize(void);
@@ -60,6 +61,8 @@ void translate_ndi(void) {
 
   ndi->gnl.impute_cooling = NO; // never impute cooling, but retain the code 2/2019 MJF
 
+  intern_component_codes();
+
   duct_leakage_neat();
 
   // Convert itemized cost savings to units of MMBtu
@@ -93,7 +96,7 @@ void translate_ndi(void) {
 }
 
 /***************************************************************************
- ** Function Name: initialize
+ ** Function Name: initialize_neat_measure_types
  **          Date: April 19, 1999
  **     Author(s): Mark Fishbaugher
  **
@@ -101,520 +104,249 @@ void translate_ndi(void) {
  **  our measure desciption and type arrays plus allocate memory from the
  **  heap for our larger global variables.
  **************************************************************************/
-void initialize_neat_measure_exclusion(void) {
+void initialize_neat_measure_types(void) {
   int n;
 
-  // measure inter dependence/exclusion (cant do both to the same dwelling)
+  // measure names and types, the measure inter dependence/exclusion (cant do both
+  // to the same dwelling) is the const measure_exclusion_matrix[] in subs.c
 
   n = N_CMS_ATTIC_INSULATION_R11;
   //STRCPY(nir->measure_name[n], "Attic Insulation R-11");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE; 
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = N_CMS_ATTIC_INSULATION_R19;
-  nir->measure_exclusion[n][2] = N_CMS_ATTIC_INSULATION_R30;
-  nir->measure_exclusion[n][3] = N_CMS_ATTIC_INSULATION_R38;
-  nir->measure_exclusion[n][4] = N_CMS_FILL_CEILING_CAVITY;
-  nir->measure_exclusion[n][5] = N_CMS_ATTIC_INSULATION_R49;
 
   n = N_CMS_ATTIC_INSULATION_R19;
   //STRCPY(nir->measure_name[n], "Attic Insulation R-19");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = n;
-  nir->measure_exclusion[n][2] = N_CMS_ATTIC_INSULATION_R30;
-  nir->measure_exclusion[n][3] = N_CMS_ATTIC_INSULATION_R38;
-  nir->measure_exclusion[n][4] = N_CMS_FILL_CEILING_CAVITY;
-  nir->measure_exclusion[n][5] = N_CMS_ATTIC_INSULATION_R49;
 
   n = N_CMS_ATTIC_INSULATION_R30;
   //STRCPY(nir->measure_name[n], "Attic Insulation R-30");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = N_CMS_ATTIC_INSULATION_R11;
-  nir->measure_exclusion[n][1] = N_CMS_ATTIC_INSULATION_R19;
-  nir->measure_exclusion[n][2] = n;
-  nir->measure_exclusion[n][3] = N_CMS_ATTIC_INSULATION_R38;
-  nir->measure_exclusion[n][4] = N_CMS_FILL_CEILING_CAVITY;
-  nir->measure_exclusion[n][5] = N_CMS_ATTIC_INSULATION_R49;
 
   n = N_CMS_ATTIC_INSULATION_R38;
   //STRCPY(nir->measure_name[n], "Attic Insulation R-38");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = N_CMS_ATTIC_INSULATION_R11;
-  nir->measure_exclusion[n][1] = N_CMS_ATTIC_INSULATION_R19;
-  nir->measure_exclusion[n][2] = N_CMS_ATTIC_INSULATION_R30;
-  nir->measure_exclusion[n][3] = n;
-  nir->measure_exclusion[n][4] = N_CMS_FILL_CEILING_CAVITY;
-  nir->measure_exclusion[n][5] = N_CMS_ATTIC_INSULATION_R49;
 
   n = N_CMS_WALL_INSULATION;
   //STRCPY(nir->measure_name[N_CMS_WALL_INSULATION], "Wall Insulation");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[N_CMS_WALL_INSULATION] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[N_CMS_WALL_INSULATION] = 1;
-  nir->measure_exclusion[N_CMS_WALL_INSULATION][0] = N_CMS_WALL_INSULATION;
 
   n = N_CMS_SILLBOX_INSULATION;
   //STRCPY(nir->measure_name[n], "Sillbox Insulation");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 5;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = N_CMS_FLOOR_INSULATION_R11;
-  nir->measure_exclusion[n][2] = N_CMS_FLOOR_INSULATION_R19;
-  nir->measure_exclusion[n][3] = N_CMS_FLOOR_INSULATION_R30;
-  nir->measure_exclusion[n][4] = N_CMS_FLOOR_INSULATION_R38;
 
   n = N_CMS_FOUNDATION_WALL_INSULATION;
   //STRCPY(nir->measure_name[n], "Foundation Wall Insulation");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 5;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = N_CMS_FLOOR_INSULATION_R11;
-  nir->measure_exclusion[n][2] = N_CMS_FLOOR_INSULATION_R19;
-  nir->measure_exclusion[n][3] = N_CMS_FLOOR_INSULATION_R30;
-  nir->measure_exclusion[n][4] = N_CMS_FLOOR_INSULATION_R38;
 
   n = N_CMS_FLOOR_INSULATION_R11;
   //STRCPY(nir->measure_name[n], "Floor Insulation R-11");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 7;
-  nir->measure_exclusion[n][0] = N_CMS_SILLBOX_INSULATION;
-  nir->measure_exclusion[n][1] = N_CMS_FOUNDATION_WALL_INSULATION;
-  nir->measure_exclusion[n][2] = n;
-  nir->measure_exclusion[n][3] = N_CMS_FLOOR_INSULATION_R19;
-  nir->measure_exclusion[n][4] = N_CMS_FLOOR_INSULATION_R30;
-  nir->measure_exclusion[n][5] = N_CMS_FLOOR_INSULATION_R38;
-  nir->measure_exclusion[n][6] = N_CMS_FILL_FLOOR_CAVITY;
 
   n = N_CMS_FLOOR_INSULATION_R19;
   //STRCPY(nir->measure_name[n], "Floor Insulation R-19");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 7;
-  nir->measure_exclusion[n][0] = N_CMS_SILLBOX_INSULATION;
-  nir->measure_exclusion[n][1] = N_CMS_FOUNDATION_WALL_INSULATION;
-  nir->measure_exclusion[n][2] = N_CMS_FLOOR_INSULATION_R11;
-  nir->measure_exclusion[n][3] = n;
-  nir->measure_exclusion[n][4] = N_CMS_FLOOR_INSULATION_R30;
-  nir->measure_exclusion[n][5] = N_CMS_FLOOR_INSULATION_R38;
-  nir->measure_exclusion[n][6] = N_CMS_FILL_FLOOR_CAVITY;
 
   n = N_CMS_FLOOR_INSULATION_R30;
   //STRCPY(nir->measure_name[n], "Floor Insulation R-30");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 7;
-  nir->measure_exclusion[n][0] = N_CMS_SILLBOX_INSULATION;
-  nir->measure_exclusion[n][1] = N_CMS_FOUNDATION_WALL_INSULATION;
-  nir->measure_exclusion[n][2] = N_CMS_FLOOR_INSULATION_R11;
-  nir->measure_exclusion[n][3] = N_CMS_FLOOR_INSULATION_R19;
-  nir->measure_exclusion[n][4] = n;
-  nir->measure_exclusion[n][5] = N_CMS_FLOOR_INSULATION_R38;
-  nir->measure_exclusion[n][6] = N_CMS_FILL_FLOOR_CAVITY;
 
   n = N_CMS_FLOOR_INSULATION_R38;
   //STRCPY(nir->measure_name[n], "Floor Insulation R-38");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 7;
-  nir->measure_exclusion[n][0] = N_CMS_SILLBOX_INSULATION;
-  nir->measure_exclusion[n][1] = N_CMS_FOUNDATION_WALL_INSULATION;
-  nir->measure_exclusion[n][2] = N_CMS_FLOOR_INSULATION_R11;
-  nir->measure_exclusion[n][3] = N_CMS_FLOOR_INSULATION_R19;
-  nir->measure_exclusion[n][4] = N_CMS_FLOOR_INSULATION_R30;
-  nir->measure_exclusion[n][5] = n;
-  nir->measure_exclusion[n][6] = N_CMS_FILL_FLOOR_CAVITY;
 
   n = N_CMS_STORM_WINDOWS;
   //STRCPY(nir->measure_name[n], "Storm Windows");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_WINDOWS_DOORS;
-  nir->measure_exclusion_count[n] = 8;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = N_CMS_WINDOW_SHADING_AWNING;
-  nir->measure_exclusion[n][2] = N_CMS_SUN_SCREEN_FABRIC;
-  nir->measure_exclusion[n][3] = N_CMS_SUN_SCREEN_LOUVERED;
-  nir->measure_exclusion[n][4] = N_CMS_WINDOW_FILM;
-  nir->measure_exclusion[n][5] = N_CMS_LOW_E_WINDOWS;
-  nir->measure_exclusion[n][6] = N_CMS_WINDOW_SEALING;
-  nir->measure_exclusion[n][7] = N_CMS_WINDOW_REPLACEMENT;
 
   n = N_CMS_KNEEWALL_INSULATION;
   //STRCPY(nir->measure_name[n], "Kneewall Insulation");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_WINDOW_SHADING_AWNING;
   //STRCPY(nir->measure_name[n], "Window Shading");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_COOLING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = N_CMS_STORM_WINDOWS;
-  nir->measure_exclusion[n][1] = n;
-  nir->measure_exclusion[n][2] = N_CMS_SUN_SCREEN_FABRIC;
-  nir->measure_exclusion[n][3] = N_CMS_SUN_SCREEN_LOUVERED;
-  nir->measure_exclusion[n][4] = N_CMS_WINDOW_FILM;
-  nir->measure_exclusion[n][5] = N_CMS_LOW_E_WINDOWS;
 
   n = N_CMS_SUN_SCREEN_FABRIC;
   //STRCPY(nir->measure_name[n], "Sun Screen, Fabric");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_COOLING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = N_CMS_STORM_WINDOWS;
-  nir->measure_exclusion[n][1] = N_CMS_WINDOW_SHADING_AWNING;
-  nir->measure_exclusion[n][2] = n;
-  nir->measure_exclusion[n][3] = N_CMS_SUN_SCREEN_LOUVERED;
-  nir->measure_exclusion[n][4] = N_CMS_WINDOW_FILM;
-  nir->measure_exclusion[n][5] = N_CMS_LOW_E_WINDOWS;
 
   n = N_CMS_SUN_SCREEN_LOUVERED;
   //STRCPY(nir->measure_name[n], "Sun Screen, Louvered");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_COOLING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = N_CMS_STORM_WINDOWS;
-  nir->measure_exclusion[n][1] = N_CMS_WINDOW_SHADING_AWNING;
-  nir->measure_exclusion[n][2] = N_CMS_SUN_SCREEN_FABRIC;
-  nir->measure_exclusion[n][3] = n;
-  nir->measure_exclusion[n][4] = N_CMS_WINDOW_FILM;
-  nir->measure_exclusion[n][5] = N_CMS_LOW_E_WINDOWS;
 
   n = N_CMS_WINDOW_FILM;
   //STRCPY(nir->measure_name[n], "Window Films");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_COOLING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = N_CMS_STORM_WINDOWS;
-  nir->measure_exclusion[n][1] = N_CMS_WINDOW_SHADING_AWNING;
-  nir->measure_exclusion[n][2] = N_CMS_SUN_SCREEN_FABRIC;
-  nir->measure_exclusion[n][3] = N_CMS_SUN_SCREEN_LOUVERED;
-  nir->measure_exclusion[n][4] = n;
-  nir->measure_exclusion[n][5] = N_CMS_LOW_E_WINDOWS;
 
   n = N_CMS_LOW_E_WINDOWS;
   //STRCPY(nir->measure_name[n], "Low-E Windows");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_WINDOWS_DOORS;
-  nir->measure_exclusion_count[n] = 8;
-  nir->measure_exclusion[n][0] = N_CMS_STORM_WINDOWS;
-  nir->measure_exclusion[n][1] = N_CMS_WINDOW_SHADING_AWNING;
-  nir->measure_exclusion[n][2] = N_CMS_SUN_SCREEN_FABRIC;
-  nir->measure_exclusion[n][3] = N_CMS_SUN_SCREEN_LOUVERED;
-  nir->measure_exclusion[n][4] = N_CMS_WINDOW_FILM;
-  nir->measure_exclusion[n][5] = n;
-  nir->measure_exclusion[n][6] = N_CMS_WINDOW_SEALING;
-  nir->measure_exclusion[n][7] = N_CMS_WINDOW_REPLACEMENT;
 
   n = N_CMS_THERMAL_VENT_DAMPER;
   //STRCPY(nir->measure_name[n], "Thermal Vent Damper");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_SYSTEM_UPDATE;
-  nir->measure_exclusion_count[n] = 7;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = N_CMS_ELECTRIC_VENT_DAMPER;
-  nir->measure_exclusion[n][2] = N_CMS_ELECTRIC_VENT_DAMPER_AND_IID;
-  nir->measure_exclusion[n][3] = N_CMS_FLAME_RETENTION_BURNER;
-  nir->measure_exclusion[n][4] = N_CMS_REPLACE_HEATING_SYSTEM;
-  nir->measure_exclusion[n][5] = N_CMS_HIGH_EFFICIENCY_FURNACE;
-  nir->measure_exclusion[n][6] = N_CMS_HIGH_EFFICIENCY_BOILER;
 
   n = N_CMS_ELECTRIC_VENT_DAMPER;
   //STRCPY(nir->measure_name[n], "Electric Vent Damper");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_SYSTEM_UPDATE;
-  nir->measure_exclusion_count[n] = 7;
-  nir->measure_exclusion[n][0] = N_CMS_THERMAL_VENT_DAMPER;
-  nir->measure_exclusion[n][1] = n;
-  nir->measure_exclusion[n][2] = N_CMS_ELECTRIC_VENT_DAMPER_AND_IID;
-  nir->measure_exclusion[n][3] = N_CMS_FLAME_RETENTION_BURNER;
-  nir->measure_exclusion[n][4] = N_CMS_REPLACE_HEATING_SYSTEM;
-  nir->measure_exclusion[n][5] = N_CMS_HIGH_EFFICIENCY_FURNACE;
-  nir->measure_exclusion[n][6] = N_CMS_HIGH_EFFICIENCY_BOILER;
 
   n = N_CMS_IID;
   //STRCPY(nir->measure_name[n], "Intermittent Ignition Device");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_SYSTEM_UPDATE;
-  nir->measure_exclusion_count[n] = 5;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = N_CMS_ELECTRIC_VENT_DAMPER_AND_IID;
-  nir->measure_exclusion[n][2] = N_CMS_REPLACE_HEATING_SYSTEM;
-  nir->measure_exclusion[n][3] = N_CMS_HIGH_EFFICIENCY_FURNACE;
-  nir->measure_exclusion[n][4] = N_CMS_HIGH_EFFICIENCY_BOILER;
 
   n = N_CMS_ELECTRIC_VENT_DAMPER_AND_IID;
   //STRCPY(nir->measure_name[n], "Electric Vent Damper/IID");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_SYSTEM_UPDATE;
-  nir->measure_exclusion_count[n] = 8;
-  nir->measure_exclusion[n][0] = N_CMS_THERMAL_VENT_DAMPER;
-  nir->measure_exclusion[n][1] = N_CMS_ELECTRIC_VENT_DAMPER;
-  nir->measure_exclusion[n][2] = N_CMS_IID;
-  nir->measure_exclusion[n][3] = n;
-  nir->measure_exclusion[n][4] = N_CMS_FLAME_RETENTION_BURNER;
-  nir->measure_exclusion[n][5] = N_CMS_REPLACE_HEATING_SYSTEM;
-  nir->measure_exclusion[n][6] = N_CMS_HIGH_EFFICIENCY_FURNACE;
-  nir->measure_exclusion[n][7] = N_CMS_HIGH_EFFICIENCY_BOILER;
 
   n = N_CMS_FLAME_RETENTION_BURNER;
   //STRCPY(nir->measure_name[n], "Flame Retention Burners");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_SYSTEM_UPDATE;
-  nir->measure_exclusion_count[n] = 7;
-  nir->measure_exclusion[n][0] = N_CMS_THERMAL_VENT_DAMPER;
-  nir->measure_exclusion[n][1] = N_CMS_ELECTRIC_VENT_DAMPER;
-  nir->measure_exclusion[n][2] = N_CMS_ELECTRIC_VENT_DAMPER_AND_IID;
-  nir->measure_exclusion[n][3] = n;
-  nir->measure_exclusion[n][4] = N_CMS_REPLACE_HEATING_SYSTEM;
-  nir->measure_exclusion[n][5] = N_CMS_HIGH_EFFICIENCY_FURNACE;
-  nir->measure_exclusion[n][6] = N_CMS_HIGH_EFFICIENCY_BOILER;
 
   n = N_CMS_FURNACE_TUNE_UP;
   //STRCPY(nir->measure_name[n], "Furnace Tuneup");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_SYSTEM_UPDATE;
-  nir->measure_exclusion_count[n] = 4;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = N_CMS_REPLACE_HEATING_SYSTEM;
-  nir->measure_exclusion[n][2] = N_CMS_HIGH_EFFICIENCY_FURNACE;
-  nir->measure_exclusion[n][3] = N_CMS_HIGH_EFFICIENCY_BOILER;
 
   n = N_CMS_REPLACE_HEATING_SYSTEM;
   //STRCPY(nir->measure_name[n], "Replace Heating System");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_SYSTEM_REPLACE;
-  nir->measure_exclusion_count[n] = 9;
-  nir->measure_exclusion[n][0] = N_CMS_THERMAL_VENT_DAMPER;
-  nir->measure_exclusion[n][1] = N_CMS_ELECTRIC_VENT_DAMPER;
-  nir->measure_exclusion[n][2] = N_CMS_IID;
-  nir->measure_exclusion[n][3] = N_CMS_ELECTRIC_VENT_DAMPER_AND_IID;
-  nir->measure_exclusion[n][4] = N_CMS_FLAME_RETENTION_BURNER;
-  nir->measure_exclusion[n][5] = N_CMS_FURNACE_TUNE_UP;
-  nir->measure_exclusion[n][6] = n;
-  nir->measure_exclusion[n][7] = N_CMS_HIGH_EFFICIENCY_FURNACE;
-  nir->measure_exclusion[n][8] = N_CMS_HIGH_EFFICIENCY_BOILER;
 
   n = N_CMS_HIGH_EFFICIENCY_FURNACE;
   //STRCPY(nir->measure_name[n], "High Efficiency Furnace");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_SYSTEM_REPLACE;
-  nir->measure_exclusion_count[n] = 8;
-  nir->measure_exclusion[n][0] = N_CMS_THERMAL_VENT_DAMPER;
-  nir->measure_exclusion[n][1] = N_CMS_ELECTRIC_VENT_DAMPER;
-  nir->measure_exclusion[n][2] = N_CMS_IID;
-  nir->measure_exclusion[n][3] = N_CMS_ELECTRIC_VENT_DAMPER_AND_IID;
-  nir->measure_exclusion[n][4] = N_CMS_FLAME_RETENTION_BURNER;
-  nir->measure_exclusion[n][5] = N_CMS_FURNACE_TUNE_UP;
-  nir->measure_exclusion[n][6] = N_CMS_REPLACE_HEATING_SYSTEM;
-  nir->measure_exclusion[n][7] = n;
 
   n = N_CMS_SMART_THERMOSTAT;
   //STRCPY(nir->measure_name[n], "Smart Thermostat");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_SMART_THERMOSTAT;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_REPLACE_AC;
   //STRCPY(nir->measure_name[n], "Replace Air Conditioner");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_COOLING_SYSTEM;
-  nir->measure_exclusion_count[n] = 4;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = N_CMS_EVAPORATIVE_COOLER;
-  nir->measure_exclusion[n][2] = N_CMS_INSTALL_OR_REPLACE_HEATPUMP;
-  nir->measure_exclusion[n][3] = N_CMS_TUNE_UP_AC;
 
   n = N_CMS_EVAPORATIVE_COOLER;
   //STRCPY(nir->measure_name[n], "Evaporative Cooler");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_COOLING_SYSTEM;
-  nir->measure_exclusion_count[n] = 4;
-  nir->measure_exclusion[n][0] = N_CMS_REPLACE_AC;
-  nir->measure_exclusion[n][1] = n;
-  nir->measure_exclusion[n][2] = N_CMS_INSTALL_OR_REPLACE_HEATPUMP;
-  nir->measure_exclusion[n][3] = N_CMS_TUNE_UP_AC;
 
   n = N_CMS_INSTALL_OR_REPLACE_HEATPUMP;
   //STRCPY(nir->measure_name[n], "Install/Replace Heatpump");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEAT_PUMP_REPLACE;
-  nir->measure_exclusion_count[n] = 4;
-  nir->measure_exclusion[n][0] = N_CMS_REPLACE_AC;
-  nir->measure_exclusion[n][1] = N_CMS_EVAPORATIVE_COOLER;
-  nir->measure_exclusion[n][2] = n;
-  nir->measure_exclusion[n][3] = N_CMS_TUNE_UP_AC;
 
   n = N_CMS_INFILTRATION_REDUCTION;
   STRCPY(nir->measure_name[n], "Infiltration Reduction");     // not in cms array
   nir->meas_type[n] = CMT_INFILTRATION_REDUCTION;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_DUCT_INSULATION;
   //STRCPY(nir->measure_name[n], "Duct Insulation");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_DUCT;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_FILL_CEILING_CAVITY;
   //STRCPY(nir->measure_name[n], "Fill Ceiling Cavity");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = N_CMS_ATTIC_INSULATION_R11;
-  nir->measure_exclusion[n][1] = N_CMS_ATTIC_INSULATION_R19;
-  nir->measure_exclusion[n][2] = N_CMS_ATTIC_INSULATION_R30;
-  nir->measure_exclusion[n][3] = N_CMS_ATTIC_INSULATION_R38;
-  nir->measure_exclusion[n][4] = n;
-  nir->measure_exclusion[n][5] = N_CMS_ATTIC_INSULATION_R49;
 
   n = N_CMS_LIGHTING_RETROFITS;
   //STRCPY(nir->measure_name[n], "Lighting Retrofits");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_BASELOAD;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_TUNE_UP_AC;
   //STRCPY(nir->measure_name[n], "Air Conditioner Tuneup");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_COOLING_SYSTEM;
-  nir->measure_exclusion_count[n] = 4;
-  nir->measure_exclusion[n][0] = N_CMS_REPLACE_AC;
-  nir->measure_exclusion[n][1] = N_CMS_EVAPORATIVE_COOLER;
-  nir->measure_exclusion[n][2] = N_CMS_INSTALL_OR_REPLACE_HEATPUMP;
-  nir->measure_exclusion[n][3] = n;
 
   n = N_CMS_WINDOW_SEALING;
   //STRCPY(nir->measure_name[n], "Window Sealing");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_WINDOWS_DOORS;
-  nir->measure_exclusion_count[n] = 4;
-  nir->measure_exclusion[n][0] = N_CMS_STORM_WINDOWS;
-  nir->measure_exclusion[n][1] = N_CMS_LOW_E_WINDOWS;
-  nir->measure_exclusion[n][2] = n;
-  nir->measure_exclusion[n][3] = N_CMS_WINDOW_REPLACEMENT;
 
   n = N_CMS_WINDOW_REPLACEMENT;
   //STRCPY(nir->measure_name[n], "Window Replacement");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_WINDOWS_DOORS;
-  nir->measure_exclusion_count[n] = 4;
-  nir->measure_exclusion[n][0] = N_CMS_STORM_WINDOWS;
-  nir->measure_exclusion[n][1] = N_CMS_LOW_E_WINDOWS;
-  nir->measure_exclusion[n][2] = N_CMS_WINDOW_SEALING;
-  nir->measure_exclusion[n][3] = n;
 
   n = N_CMS_WATER_HEATER_TANK_INSULATION;
   //STRCPY(nir->measure_name[n], "Water Heater Tank Insulation");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_WATER_HEATER;
-  nir->measure_exclusion_count[n] = 2;
-  nir->measure_exclusion[n][0] = n;
-  nir->measure_exclusion[n][1] = N_CMS_WATER_HEATER_REPLACEMENT;
 
   n = N_CMS_WATER_HEATER_PIPE_INSULATION;
   //STRCPY(nir->measure_name[n], "Water Heater Pipe Insulation");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_BASELOAD;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_LOW_FLOW_SHOWERHEADS;
   //STRCPY(nir->measure_name[n], "Low Flow Showerheads");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_BASELOAD;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_REFRIGERATOR_REPLACEMENT;
   //STRCPY(nir->measure_name[n], "Refrigerator Replacement");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_BASELOAD;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_DUCT_SEALING;
   STRCPY(nir->measure_name[n], "Seal Ducts");           // not in cms array
   nir->meas_type[n] = CMT_INFILTRATION_REDUCTION;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_WATER_HEATER_REPLACEMENT;
   //STRCPY(nir->measure_name[n], "Water Heater Replacement");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_WATER_HEATER;
-  nir->measure_exclusion_count[n] = 2;
-  nir->measure_exclusion[n][0] = N_CMS_WATER_HEATER_TANK_INSULATION;
-  nir->measure_exclusion[n][1] = n;
 
   n = N_CMS_HIGH_EFFICIENCY_BOILER;
   //STRCPY(nir->measure_name[n], "High Efficiency Boiler");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_SYSTEM_REPLACE;
-  nir->measure_exclusion_count[n] = 8;
-  nir->measure_exclusion[n][0] = N_CMS_THERMAL_VENT_DAMPER;
-  nir->measure_exclusion[n][1] = N_CMS_ELECTRIC_VENT_DAMPER;
-  nir->measure_exclusion[n][2] = N_CMS_IID;
-  nir->measure_exclusion[n][3] = N_CMS_ELECTRIC_VENT_DAMPER_AND_IID;
-  nir->measure_exclusion[n][4] = N_CMS_FLAME_RETENTION_BURNER;
-  nir->measure_exclusion[n][5] = N_CMS_FURNACE_TUNE_UP;
-  nir->measure_exclusion[n][6] = N_CMS_REPLACE_HEATING_SYSTEM;
-  nir->measure_exclusion[n][7] = n;
 
   n = N_CMS_ATTIC_INSULATION_R49;
   //STRCPY(nir->measure_name[n], "Attic Insulation R-49");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 6;
-  nir->measure_exclusion[n][0] = N_CMS_ATTIC_INSULATION_R11;
-  nir->measure_exclusion[n][1] = N_CMS_ATTIC_INSULATION_R19;
-  nir->measure_exclusion[n][2] = N_CMS_ATTIC_INSULATION_R30;
-  nir->measure_exclusion[n][3] = N_CMS_ATTIC_INSULATION_R38;
-  nir->measure_exclusion[n][4] = N_CMS_FILL_CEILING_CAVITY;
-  nir->measure_exclusion[n][5] = n;
 
   n = N_CMS_DOOR_REPLACEMENT;
   //STRCPY(nir->measure_name[n], "Door Replacement");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_WINDOWS_DOORS;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_WHITE_ROOF_COATING;
   //STRCPY(nir->measure_name[n], "White Roof Coating");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_COOLING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 1;
-  nir->measure_exclusion[n][0] = n;
 
   n = N_CMS_FILL_FLOOR_CAVITY;
   //STRCPY(nir->measure_name[n], "Fill Closed Floor Cavity");
   STRCPY(nir->measure_name[n], ndi->cms[n].measure_name);
   nir->meas_type[n] = CMT_HEATING_ENVELOPE;
-  nir->measure_exclusion_count[n] = 7;
-  nir->measure_exclusion[n][0] = N_CMS_SILLBOX_INSULATION;
-  nir->measure_exclusion[n][1] = N_CMS_FOUNDATION_WALL_INSULATION;
-  nir->measure_exclusion[n][2] = N_CMS_FLOOR_INSULATION_R11;
-  nir->measure_exclusion[n][3] = N_CMS_FLOOR_INSULATION_R19;
-  nir->measure_exclusion[n][4] = N_CMS_FLOOR_INSULATION_R30;
-  nir->measure_exclusion[n][5] = N_CMS_FLOOR_INSULATION_R38;
-  nir->measure_exclusion[n][6] = n;
 
   // optionally show our measure interactions
   if (cmds.debug_level & D_MEASURE_EXCLUSION) {
@@ -703,6 +435,21 @@ void neat_preparation(void) {
   return;
 }
 
+// Assign every audit component code its small integer id up front so the
+// measure component sets built in the first pass share one numbering
+static void intern_component_codes(void) {
+  reset_component_codes();
+  for (int nc = 0; nc < ndi->num_wal; nc++) component_code_id(ndi->wal[nc].code);
+  for (int nc = 0; nc < ndi->num_win; nc++) component_code_id(ndi->win[nc].code);
+  for (int nc = 0; nc < ndi->num_dor; nc++) component_code_id(ndi->dor[nc].code);
+  for (int nc = 0; nc < ndi->num_atc; nc++) component_code_id(ndi->atc[nc].code);
+  for (int nc = 0; nc < ndi->num_fat; nc++) component_code_id(ndi->fat[nc].code);
+  for (int nc = 0; nc < ndi->num_fnd; nc++) component_code_id(ndi->fnd[nc].code);
+  for (int nc = 0; nc < ndi->num_htg; nc++) component_code_id(ndi->htg[nc].code);
+  for (int nc = 0; nc < ndi->num_clg; nc++) component_code_id(ndi->clg[nc].code);
+  for (int nc = 0; nc < ndi->num_ltg; nc++) component_code_id(ndi->ltg[nc].code);
+}
+
 static void weather_initialize(void) {
   int ndbt = 0, nrh = 0;
   float dbtmax = 0.0;
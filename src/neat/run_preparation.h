@@ -11,7 +11,7 @@
 void translate_parms(void);
 void translate_ndi(void);
 
-void initialize_neat_measure_exclusion(void);
+void initialize_neat_measure_types(void);
 void initialize_billing(void);
 
 void neat_preparation(void);
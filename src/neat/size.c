@@ -180,6 +180,109 @@ static float flatent_occ;    // Latent loads from occupants
 static float flatent[POST_RETROFIT +1];     // Pre and Post latent load from infiltration
 static float flatent_tot[POST_RETROFIT +1]; // Pre and Post total latent load
 
+// Sizing memo.  The post-retrofit sizing is rerun on every billing adjustment
+// pass with an unchanged house, so each call keys its inputs with hash_bytes()
+// and, when they match the last call for the same case, restores the stored
+// results instead of recomputing.  A post-retrofit call that does recompute
+// reuses the pre-retrofit load of every component the package left unchanged.
+
+typedef struct {
+  unsigned long long key; // hash of the component's inputs
+  float load;             // its load, before scaling by the heating design dT
+} COMPONENT_LOAD;
+
+typedef struct {
+  int valid;
+  unsigned long long key;  // hash of every input to the sizing call
+  float total;             // htmt or clmt
+  float duct;              // htduct
+  float infiltration;      // htminf or clminf
+  float infiltration_ua;   // heating infiltration before scaling by dtd
+  float latent;            // flatent
+  float latent_total;      // flatent_tot
+  COMPONENT_LOAD wal[NEAT_MAX_WAL];
+  COMPONENT_LOAD win[NEAT_MAX_WIN];
+  COMPONENT_LOAD dor[NEAT_MAX_DOR];
+  COMPONENT_LOAD uas[NEAT_MAX_UAS];
+  COMPONENT_LOAD fnd[NEAT_MAX_FND];
+} SIZING_MEMO;
+
+static SIZING_MEMO heating_memo[POST_RETROFIT + 1];
+static SIZING_MEMO cooling_memo[POST_RETROFIT + 1];
+
+// True when the post-retrofit component nc has the same inputs as it had for
+// the pre-retrofit sizing, whose load can then be reused
+#define SAME_AS_PRE_RETROFIT(memo, rt, part, nc)                                                           \
+  ((rt) == POST_RETROFIT && (memo)[PRE_RETROFIT].valid && (memo)[POST_RETROFIT].part[nc].key == (memo)[PRE_RETROFIT].part[nc].key)
+
+#define HASH_VALUE(h, v) hash_bytes((h), &(v), sizeof(v))
+
+// Key each envelope component of the house from seed and return a key that
+// covers all of them.  Cooling seeds with the design dT, which its component
+// loads include, and also depends on the window sun screens.
+static unsigned long long component_keys(SIZING_MEMO *memo, unsigned long long seed, int season) {
+  unsigned long long key = seed;
+  int nc;
+
+  for (nc = 0; nc < ndi->num_wal; nc++) {
+    memo->wal[nc].key = HASH_VALUE(seed, ndi->wal[nc]);
+    key = HASH_VALUE(key, memo->wal[nc].key);
+  }
+  for (nc = 0; nc < ndi->num_win; nc++) {
+    memo->win[nc].key = HASH_VALUE(seed, ndi->win[nc]);
+    if (season == COOLING)
+      memo->win[nc].key = HASH_VALUE(memo->win[nc].key, nir->wn_sunscrn[COOLING][nc]);
+    key = HASH_VALUE(key, memo->win[nc].key);
+  }
+  for (nc = 0; nc < ndi->num_dor; nc++) {
+    memo->dor[nc].key = HASH_VALUE(seed, ndi->dor[nc]);
+    key = HASH_VALUE(key, memo->dor[nc].key);
+  }
+  for (nc = 0; nc < ndi->num_uas; nc++) {
+    memo->uas[nc].key = HASH_VALUE(seed, ndi->uas[nc]);
+    key = HASH_VALUE(key, memo->uas[nc].key);
+  }
+  for (nc = 0; nc < ndi->num_fnd; nc++) {
+    memo->fnd[nc].key = HASH_VALUE(seed, ndi->fnd[nc]);
+    key = HASH_VALUE(key, memo->fnd[nc].key);
+  }
+  key = HASH_VALUE(key, ndi->num_wal);
+  key = HASH_VALUE(key, ndi->num_win);
+  key = HASH_VALUE(key, ndi->num_dor);
+  key = HASH_VALUE(key, ndi->num_uas);
+  key = HASH_VALUE(key, ndi->num_fnd);
+  return key;
+}
+
+// If pre-retrofit leakage was not specified and Manual J gives a lower pre than
+// post infiltration load, set pre = post and re-adjust the pre totals.  Runs on
+// every post-retrofit call, memo hit or not, as the pre values may have been
+// recomputed since.
+
+static void match_pre_heating_infiltration(float post_infiltration_ua) {
+  ASSERT(dtd, sprintf(msg, "Need non zero cfm"));
+  if ((nir->infiltration_treatment == INF_DEFAULT || 
+       nir->infiltration_treatment == INF_INCIDENTAL_COST) && 
+    htminf[PRE_RETROFIT] / dtd < post_infiltration_ua) {
+    nir->htmt[PRE_RETROFIT] -= htminf[PRE_RETROFIT];
+    htminf[PRE_RETROFIT] = post_infiltration_ua * dtd;
+    nir->htmt[PRE_RETROFIT] += htminf[PRE_RETROFIT];
+  }
+}
+
+static void match_pre_cooling_infiltration(void) {
+  if ((nir->infiltration_treatment == INF_DEFAULT || 
+       nir->infiltration_treatment == INF_INCIDENTAL_COST) && 
+       clminf[PRE_RETROFIT] / dtd < clminf[POST_RETROFIT]) {
+    nir->clmt[PRE_RETROFIT] -= clminf[PRE_RETROFIT];
+    clminf[PRE_RETROFIT] = clminf[POST_RETROFIT];
+    nir->clmt[PRE_RETROFIT] += clminf[PRE_RETROFIT];
+    flatent_tot[PRE_RETROFIT] -= flatent[PRE_RETROFIT];
+    flatent[PRE_RETROFIT] = flatent[POST_RETROFIT];
+    flatent_tot[PRE_RETROFIT] += flatent[PRE_RETROFIT];
+  }
+}
+
 void sizing_heating(int rt) {
   float wlr, temp, areaag, areabg, fndu;
   // int fr, gt, dt, dc, nc;
@@ -187,6 +290,8 @@ void sizing_heating(int rt) {
   int nc;
   // char ch;
   float frductlos = 0.0f; // fractional duct loss value, heating
+  SIZING_MEMO *memo = &heating_memo[rt];
+  unsigned long long key;
   // int gtt[] = {0, 1, 1, 2, 0, 4, 3}; // Added 10/11, Version 89
 
   nir->htmt[rt] = 0.0;
@@ -206,139 +311,181 @@ void sizing_heating(int rt) {
   else
     frductlos = 0.15f;
 
+  key = component_keys(memo, HASH_SEED, HEATING);
+  key = HASH_VALUE(key, dtd);
+  key = HASH_VALUE(key, frductlos);
+  key = HASH_VALUE(key, nir->infiltration_treatment);
+  key = HASH_VALUE(key, ndi->gnl.floor_area);
+  key = HASH_VALUE(key, nir->whole_house_cfm[rt][JANUARY]);
+  if (memo->valid && memo->key == key) {
+    nir->htmt[rt] = memo->total;
+    nir->htduct[rt] = memo->duct;
+    htminf[rt] = memo->infiltration;
+    if (rt == POST_RETROFIT)
+      match_pre_heating_infiltration(memo->infiltration_ua);
+    volume = ndi->gnl.floor_area * 8.0f;
+    return;
+  }
+  memo->valid = FALSE;
+
   /*  Note final value of htmt must be multiplied by the design temp. diff., dtd */
   /*  Walls */
   for (nc = 0; nc < ndi->num_wal; nc++) {
-    // #314
-    // if (ndi->wal[nc].exposure == EX_ATTIC) { //  Kneewalls handled by attics
-    //   htmwl[rt][nc] = 0.0f;
-    //   continue;
-    // }
-    wlr = ndi->wal[nc].exist_r;
-    if (ndi->wal[nc].wall_type == LO_BALLOON || ndi->wal[nc].wall_type == LO_PLATFORM ||
-        ndi->wal[nc].wall_type == LO_OTHER) { // frame wall Table 2-12
-      if (wlr <= 2.6)
-        htmwl[rt][nc] = 0.2714f * (float)exp(-0.2789 * (wlr)) * ndi->wal[nc].area;
-      else
-        htmwl[rt][nc] = 0.1505f * (float)exp(-0.04908 * (wlr)) * ndi->wal[nc].area;
-    } else { /* Masonry wall, Table 2-14.  Altered 10/04 */
-      if (ndi->wal[nc].ext_type != EX_BRICK) {
-        htmwl[rt][nc] = 1.0f / (0.994092f * wlr + 1.983091f) * ndi->wal[nc].area;
-      } else {
-        htmwl[rt][nc] = 1.0f / (0.988394f * wlr + 2.553782f) * ndi->wal[nc].area;
+    if (SAME_AS_PRE_RETROFIT(heating_memo, rt, wal, nc)) {
+      htmwl[rt][nc] = heating_memo[PRE_RETROFIT].wal[nc].load;
+    } else {
+      // #314
+      // if (ndi->wal[nc].exposure == EX_ATTIC) { //  Kneewalls handled by attics
+      //   htmwl[rt][nc] = 0.0f;
+      //   continue;
+      // }
+      wlr = ndi->wal[nc].exist_r;
+      if (ndi->wal[nc].wall_type == LO_BALLOON || ndi->wal[nc].wall_type == LO_PLATFORM ||
+          ndi->wal[nc].wall_type == LO_OTHER) { // frame wall Table 2-12
+        if (wlr <= 2.6)
+          htmwl[rt][nc] = 0.2714f * (float)exp(-0.2789 * (wlr)) * ndi->wal[nc].area;
+        else
+          htmwl[rt][nc] = 0.1505f * (float)exp(-0.04908 * (wlr)) * ndi->wal[nc].area;
+      } else { /* Masonry wall, Table 2-14.  Altered 10/04 */
+        if (ndi->wal[nc].ext_type != EX_BRICK) {
+          htmwl[rt][nc] = 1.0f / (0.994092f * wlr + 1.983091f) * ndi->wal[nc].area;
+        } else {
+          htmwl[rt][nc] = 1.0f / (0.988394f * wlr + 2.553782f) * ndi->wal[nc].area;
+        }
       }
     }
+    memo->wal[nc].load = htmwl[rt][nc];
     nir->htmt[rt] += htmwl[rt][nc];
   }
 
   /*  Windows, Tables 2-2, 2-3 and 2-4 */
 
   for (nc = 0; nc < ndi->num_win; nc++) {
-    htmwn[rt][nc] = window_u_value(ndi->win[nc].frame_type, ndi->win[nc].glazing_type, MANUAL_J_HEAT) * ndi->win[nc].area_gross;
+    if (SAME_AS_PRE_RETROFIT(heating_memo, rt, win, nc)) {
+      htmwn[rt][nc] = heating_memo[PRE_RETROFIT].win[nc].load;
+    } else {
+      htmwn[rt][nc] = window_u_value(ndi->win[nc].frame_type, ndi->win[nc].glazing_type, MANUAL_J_HEAT) * ndi->win[nc].area_gross;
+    }
+    memo->win[nc].load = htmwn[rt][nc];
     nir->htmt[rt] += htmwn[rt][nc];
   }
 
   /*  Doors, Tables 2-10 and 2-11 */
 
   for (nc = 0; nc < ndi->num_dor; nc++) {
-    // dt = dr_type[nc] - 1;
-    // dc = dr_cond[nc] - 1;
-    // if (dc > 0)
-    //   dc = 1;       // inadequate storm door or missing
-    // htmdr[rt][nc] = drmju[dc][dt] * dr[nc].area;
-    htmdr[rt][nc] = door_u_value(ndi->dor[nc].door_type, ndi->dor[nc].condition, MANUAL_J_HEAT) * ndi->dor[nc].area;
+    if (SAME_AS_PRE_RETROFIT(heating_memo, rt, dor, nc)) {
+      htmdr[rt][nc] = heating_memo[PRE_RETROFIT].dor[nc].load;
+    } else {
+      // dt = dr_type[nc] - 1;
+      // dc = dr_cond[nc] - 1;
+      // if (dc > 0)
+      //   dc = 1;       // inadequate storm door or missing
+      // htmdr[rt][nc] = drmju[dc][dt] * dr[nc].area;
+      htmdr[rt][nc] = door_u_value(ndi->dor[nc].door_type, ndi->dor[nc].condition, MANUAL_J_HEAT) * ndi->dor[nc].area;
+    }
+    memo->dor[nc].load = htmdr[rt][nc];
     nir->htmt[rt] += htmdr[rt][nc];
   }
 
   /*  Roof/Ceilings */
 
   for (nc = 0; nc < ndi->num_uas; nc++) {
-    temp = ndi->uas[nc].r_value;
-    if (ndi->uas[nc].attic_type != UAS_CATHEDRAL) {
-      if (temp >= 23)
-        temp = 0.996f * temp + 0.555f; /* roof/attic, Tab 2-16 */
-      else {
-        ASSERT((temp + 1.683028), sprintf(msg, "Need non zero r value"));
-        temp = 1.0f / (1.0f / 206.9193f + 1.0f / (temp + 1.683028f));
-      }
+    if (SAME_AS_PRE_RETROFIT(heating_memo, rt, uas, nc)) {
+      htmua[rt][nc] = heating_memo[PRE_RETROFIT].uas[nc].load;
     } else {
-      if (temp >= 15)
-        temp = 0.79365f * temp + 4.62963f; /* cthdrl ceiling, Tab 2-18 */
-      else {
-        ASSERT((temp + 3.266993), sprintf(msg, "Need non zero r value"));
-        temp = 1.0f / (1.0f / 524.068831f + 1.0f / (temp + 2.266993f));
+      temp = ndi->uas[nc].r_value;
+      if (ndi->uas[nc].attic_type != UAS_CATHEDRAL) {
+        if (temp >= 23)
+          temp = 0.996f * temp + 0.555f; /* roof/attic, Tab 2-16 */
+        else {
+          ASSERT((temp + 1.683028), sprintf(msg, "Need non zero r value"));
+          temp = 1.0f / (1.0f / 206.9193f + 1.0f / (temp + 1.683028f));
+        }
+      } else {
+        if (temp >= 15)
+          temp = 0.79365f * temp + 4.62963f; /* cthdrl ceiling, Tab 2-18 */
+        else {
+          ASSERT((temp + 3.266993), sprintf(msg, "Need non zero r value"));
+          temp = 1.0f / (1.0f / 524.068831f + 1.0f / (temp + 2.266993f));
+        }
       }
-    }
 
-    ASSERT(temp, sprintf(msg, "Need non zero r value"));
-    htmua[rt][nc] = 1.0f / temp * ndi->uas[nc].area;
+      ASSERT(temp, sprintf(msg, "Need non zero r value"));
+      htmua[rt][nc] = 1.0f / temp * ndi->uas[nc].area;
+    }
+    memo->uas[nc].load = htmua[rt][nc];
     nir->htmt[rt] += htmua[rt][nc];
   }
 
   /*  Foundations */
 
   for (nc = 0; nc < ndi->num_fnd; nc++) {
-    switch (ndi->fnd[nc].space_type) {
-      case CONDITIONED:
-        wlr = ndi->fnd[nc].wall_ins_r;
-
-        ASSERT(ndi->fnd[nc].wall_height, sprintf(msg, "Need non zero wall height"));
-        areabg = ndi->fnd[nc].wall_area * ndi->fnd[nc].below_grade_wall_height / ndi->fnd[nc].wall_height; // Tab 2-15
-        areaag = ndi->fnd[nc].wall_area - areabg;
-        if (ndi->fnd[nc].below_grade_wall_height > 5.) {  // Wall extends 5 or more feet below grade
-          htmsb[rt][nc] = 1.0f / (1.09f * wlr + 11.45f) * areabg;
-        } else {    // Wall extends <5 feet below grade 
-          htmsb[rt][nc] = 1.0f / (1.12f * wlr + 7.83f) * areabg;
-        }
-        if (wlr <= 5.0) // Above grade portion Tab 2-14
-          htmsb[rt][nc] += (0.00564f * wlr * wlr - 0.1014f * wlr + 0.51f) * areaag;
-        else
-          htmsb[rt][nc] += (0.00054f * wlr * wlr - 0.01979f * wlr + 0.22946f) * areaag;
-        htmsb[rt][nc] += (0.024f * ndi->fnd[nc].area) + ndi->fnd[nc].ua_value_basement_sill;
-        break;
-
-      case NON_CONDITIONED:
-        fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f; // Tab 2-20
-        fndu = 1.0f / fndu;
-        fndu /= 2.0; // Tab 2-19
-        htmsb[rt][nc] = fndu * ndi->fnd[nc].area;
-        break;
-
-      case VENTED_NON_CONTITIONED:
-        fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f; // Tab 2-20
-        fndu = 1.0f / fndu;
-        htmsb[rt][nc] = fndu * ndi->fnd[nc].area;
+    if (SAME_AS_PRE_RETROFIT(heating_memo, rt, fnd, nc)) {
+      htmsb[rt][nc] = heating_memo[PRE_RETROFIT].fnd[nc].load;
+    } else {
+      switch (ndi->fnd[nc].space_type) {
+        case CONDITIONED:
+          wlr = ndi->fnd[nc].wall_ins_r;
+
+          ASSERT(ndi->fnd[nc].wall_height, sprintf(msg, "Need non zero wall height"));
+          areabg = ndi->fnd[nc].wall_area * ndi->fnd[nc].below_grade_wall_height / ndi->fnd[nc].wall_height; // Tab 2-15
+          areaag = ndi->fnd[nc].wall_area - areabg;
+          if (ndi->fnd[nc].below_grade_wall_height > 5.) {  // Wall extends 5 or more feet below grade
+            htmsb[rt][nc] = 1.0f / (1.09f * wlr + 11.45f) * areabg;
+          } else {    // Wall extends <5 feet below grade 
+            htmsb[rt][nc] = 1.0f / (1.12f * wlr + 7.83f) * areabg;
+          }
+          if (wlr <= 5.0) // Above grade portion Tab 2-14
+            htmsb[rt][nc] += (0.00564f * wlr * wlr - 0.1014f * wlr + 0.51f) * areaag;
+          else
+            htmsb[rt][nc] += (0.00054f * wlr * wlr - 0.01979f * wlr + 0.22946f) * areaag;
+          htmsb[rt][nc] += (0.024f * ndi->fnd[nc].area) + ndi->fnd[nc].ua_value_basement_sill;
+          break;
+
+        case NON_CONDITIONED:
+          fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f; // Tab 2-20
+          fndu = 1.0f / fndu;
+          fndu /= 2.0; // Tab 2-19
+          htmsb[rt][nc] = fndu * ndi->fnd[nc].area;
+          break;
+
+        case VENTED_NON_CONTITIONED:
+          fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f; // Tab 2-20
+          fndu = 1.0f / fndu;
+          htmsb[rt][nc] = fndu * ndi->fnd[nc].area;
+          break;
+
+        case UNINTENTIONALLY_CONDITIONED:
+          fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f; // Tab 2-20
+          fndu = 1.0f / fndu;
+          fndu /= 2.0; // Tab 2-19
+          htmsb[rt][nc] = (fndu * ndi->fnd[nc].area) + ndi->fnd[nc].ua_value_basement_sill;
+          break;
+
+        case UNINSULATED_SLAB:
+          htmsb[rt][nc] = 0.810f * ndi->fnd[nc].perim_length; // Tab 2-22
         break;
 
-      case UNINTENTIONALLY_CONDITIONED:
-        fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f; // Tab 2-20
-        fndu = 1.0f / fndu;
-        fndu /= 2.0; // Tab 2-19
-        htmsb[rt][nc] = (fndu * ndi->fnd[nc].area) + ndi->fnd[nc].ua_value_basement_sill;
-        break;
+        case INSULATED_SLAB:
+          htmsb[rt][nc] = 0.410f * ndi->fnd[nc].perim_length; // Tab 2-22
+          break;
 
-      case UNINSULATED_SLAB:
-        htmsb[rt][nc] = 0.810f * ndi->fnd[nc].perim_length; // Tab 2-22
-      break;
+        case EXPOSED_FLOOR_UNCLOSED:
+          fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f; // Tab 2-20
+          fndu = 1.0f / fndu;
+          htmsb[rt][nc] = fndu * ndi->fnd[nc].area;
+          break;
 
-      case INSULATED_SLAB:
-        htmsb[rt][nc] = 0.410f * ndi->fnd[nc].perim_length; // Tab 2-22
-        break;
-
-      case EXPOSED_FLOOR_UNCLOSED:
-        fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f; // Tab 2-20
-        fndu = 1.0f / fndu;
-        htmsb[rt][nc] = fndu * ndi->fnd[nc].area;
-        break;
-
-      case EXPOSED_FLOOR_CLOSED:
-        fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f;    // Tab 2-20
-        fndu += EXTERIOR_FILM_RESISTANCE_R + SHEATHING_R;   // # 232
-        fndu = 1.0f / fndu;
-        htmsb[rt][nc] = fndu * ndi->fnd[nc].area;
-        break;
+        case EXPOSED_FLOOR_CLOSED:
+          fndu = 0.801f * ndi->fnd[nc].flr_ins_r + 4.081f;    // Tab 2-20
+          fndu += EXTERIOR_FILM_RESISTANCE_R + SHEATHING_R;   // # 232
+          fndu = 1.0f / fndu;
+          htmsb[rt][nc] = fndu * ndi->fnd[nc].area;
+          break;
 
+      }
     }
+    memo->fnd[nc].load = htmsb[rt][nc];
     nir->htmt[rt] += htmsb[rt][nc];
   }
 
@@ -346,16 +493,7 @@ void sizing_heating(int rt) {
 
   if (rt == POST_RETROFIT) {
     htminf[rt] = nir->whole_house_cfm[POST_RETROFIT][JANUARY] * 1.1f; /* Use January's cfm for sizing */
-
-    ASSERT(dtd, sprintf(msg, "Need non zero cfm"));
-    if ((nir->infiltration_treatment == INF_DEFAULT || 
-         nir->infiltration_treatment == INF_INCIDENTAL_COST) && 
-      htminf[PRE_RETROFIT] / dtd < htminf[POST_RETROFIT]) {
-      /* Set pre = post value if none specified & manj gives lower for pre.*/
-      nir->htmt[PRE_RETROFIT] -= htminf[PRE_RETROFIT];
-      htminf[PRE_RETROFIT] = htminf[POST_RETROFIT] * dtd;
-      nir->htmt[PRE_RETROFIT] += htminf[PRE_RETROFIT];
-    }
+    match_pre_heating_infiltration(htminf[POST_RETROFIT]);
   }  else { /* Pre-Retrofit */
     if (nir->infiltration_treatment ==  INF_NO_COST_COMPUTE_SAVINGS_ONLY ||
         nir->infiltration_treatment ==  INF_FULL_MEASURE)
@@ -365,6 +503,7 @@ void sizing_heating(int rt) {
   }
   /* Manual J average infiltration rate */
 
+  memo->infiltration_ua = htminf[rt];
   nir->htmt[rt] += htminf[rt];
 
   /* Print results of Manual J computation by component */
@@ -393,6 +532,12 @@ void sizing_heating(int rt) {
   nir->htmt[rt] *= dtd; // UA delta T
   nir->htduct[rt] = frductlos * nir->htmt[rt];
   nir->htmt[rt] += nir->htduct[rt];
+
+  memo->total = nir->htmt[rt];
+  memo->duct = nir->htduct[rt];
+  memo->infiltration = htminf[rt];
+  memo->key = key;
+  memo->valid = TRUE;
   /* fprintf(manjout,"     Inf%10.0f%12.0f\n",volume,htminf[rt]);
    * fprintf(manjout,"\n   Total%22.0f\n",nir->htmt[rt]); */
 
@@ -414,10 +559,8 @@ void sizing_cooling(int rt) {
   float temp, wlr, fndu, areabg, areaag, etd;
   float color = 24.0f; // Dark roof; 16 for light; 20 for average
   float cfmmj, L2;     // Temporary constants for infiltration calculations
-
-  fpeople = 0.0f;
-  fappliances = 0.0f;
-  flatent_occ = 0.0f;
+  SIZING_MEMO *memo = &cooling_memo[rt];
+  unsigned long long key;
 
   dtd = cwd->cooling_design_temp - 78.0f;
   if (dtd < 0.0f)
@@ -430,150 +573,204 @@ void sizing_cooling(int rt) {
       frductlos_cl = 0.1f;
   }
 
-  /*  Walls Table 4 */
+  /* Internals - People and Appliances  */
 
-  for (nc = 0; nc < ndi->num_wal; nc++) {
-    // #314
-    // if (ndi->wal[nc].exposure == EX_ATTIC) { //  Kneewalls handled by attics
-    //   clmwl[rt][nc] = 0.0f;
-    //   continue;
-    // }
+  if (ndi->gnl.avg_no_occupants < 1.5f)
+    fpeople = 552.0f / 2.0f;
+  else if (ndi->gnl.avg_no_occupants < 2.5f)
+    fpeople = 552.0f;
+  else
+    fpeople = 552.0f + 224.0f * (ndi->gnl.avg_no_occupants - 2.0f);
 
-    wlr = ndi->wal[nc].exist_r;
+  fappliances = 1200.0f;
 
-    /* frame wall, Table 4-12,13 */
+  flatent_occ = ndi->gnl.avg_no_occupants * 230.0f;
 
-    if (ndi->wal[nc].wall_type == LO_BALLOON || ndi->wal[nc].wall_type == LO_PLATFORM || ndi->wal[nc].wall_type == LO_OTHER) {
-      etd = dtd + 3.6f;                           // Medium weight house
-      if (ndi->wal[nc].exposure == EX_BUFFERED) { //  Buffered wall
-        etd = dtd - 5.0f;
-        if (etd < 0.0f)
-          etd = 0.0f;
-      }
+  key = component_keys(memo, HASH_VALUE(HASH_SEED, dtd), COOLING);
+  key = HASH_VALUE(key, cwd->cooling_design_temp);
+  key = HASH_VALUE(key, cwd->cooling_design_wetbulb_temp);
+  key = HASH_VALUE(key, nir->infiltration_treatment);
+  key = HASH_VALUE(key, ndi->inf);
+  key = HASH_VALUE(key, ndi->gnl.floor_area);
+  key = HASH_VALUE(key, ndi->gnl.no_cond_stories);
+  key = HASH_VALUE(key, ndi->gnl.avg_no_occupants);
+  if (memo->valid && memo->key == key) {
+    nir->clmt[rt] = memo->total;
+    clminf[rt] = memo->infiltration;
+    flatent[rt] = memo->latent;
+    flatent_tot[rt] = memo->latent_total;
+    if (rt == POST_RETROFIT)
+      match_pre_cooling_infiltration();
+    return;
+  }
+  memo->valid = FALSE;
 
-      if (wlr <= 2.6)
-        clmwl[rt][nc] = etd * 0.2714f * (float)exp(-0.2789 * (wlr)) * ndi->wal[nc].area;
+  /*  Walls Table 4 */
 
-      else
-        clmwl[rt][nc] = etd * 0.1505f * (float)exp(-0.04908 * (wlr)) * ndi->wal[nc].area;
-    }
+  for (nc = 0; nc < ndi->num_wal; nc++) {
+    if (SAME_AS_PRE_RETROFIT(cooling_memo, rt, wal, nc)) {
+      clmwl[rt][nc] = cooling_memo[PRE_RETROFIT].wal[nc].load;
+    } else {
+      // #314
+      // if (ndi->wal[nc].exposure == EX_ATTIC) { //  Kneewalls handled by attics
+      //   clmwl[rt][nc] = 0.0f;
+      //   continue;
+      // }
+
+      wlr = ndi->wal[nc].exist_r;
+
+      /* frame wall, Table 4-12,13 */
+
+      if (ndi->wal[nc].wall_type == LO_BALLOON || ndi->wal[nc].wall_type == LO_PLATFORM || ndi->wal[nc].wall_type == LO_OTHER) {
+        etd = dtd + 3.6f;                           // Medium weight house
+        if (ndi->wal[nc].exposure == EX_BUFFERED) { //  Buffered wall
+          etd = dtd - 5.0f;
+          if (etd < 0.0f)
+            etd = 0.0f;
+        }
 
-    else { /* Masonry wall, Table 4-14 */
+        if (wlr <= 2.6)
+          clmwl[rt][nc] = etd * 0.2714f * (float)exp(-0.2789 * (wlr)) * ndi->wal[nc].area;
 
-      etd = dtd - 3.7f;                           // Medium weight house
-      if (ndi->wal[nc].exposure == EX_BUFFERED) { //  Buffered wall
-        etd = dtd - 11.5f;
-        if (etd < 0.0f)
-          etd = 0.0f;
+        else
+          clmwl[rt][nc] = etd * 0.1505f * (float)exp(-0.04908 * (wlr)) * ndi->wal[nc].area;
       }
 
-      if (ndi->wal[nc].ext_type != EX_BRICK) {
-        clmwl[rt][nc] = etd / (0.994092f * wlr + 1.983091f) * ndi->wal[nc].area;
-      }
+      else { /* Masonry wall, Table 4-14 */
 
-      else { // Brick of Stone faced
-        clmwl[rt][nc] = etd / (0.988394f * wlr + 2.553782f) * ndi->wal[nc].area;
+        etd = dtd - 3.7f;                           // Medium weight house
+        if (ndi->wal[nc].exposure == EX_BUFFERED) { //  Buffered wall
+          etd = dtd - 11.5f;
+          if (etd < 0.0f)
+            etd = 0.0f;
+        }
+
+        if (ndi->wal[nc].ext_type != EX_BRICK) {
+          clmwl[rt][nc] = etd / (0.994092f * wlr + 1.983091f) * ndi->wal[nc].area;
+        }
+
+        else { // Brick of Stone faced
+          clmwl[rt][nc] = etd / (0.988394f * wlr + 2.553782f) * ndi->wal[nc].area;
+        }
       }
     }
-
+    memo->wal[nc].load = clmwl[rt][nc];
     nir->clmt[rt] += clmwl[rt][nc];
   }
 
   /*  Windows, Table 4-3  */
 
   for (nc = 0; nc < ndi->num_win; nc++) {
+    if (SAME_AS_PRE_RETROFIT(cooling_memo, rt, win, nc)) {
+      clmwn[rt][nc] = cooling_memo[PRE_RETROFIT].win[nc].load;
+    } else {
+      wnsd = 1.0f - ndi->win[nc].shade_factor_summer * nir->wn_sunscrn[COOLING][nc];
 
-    wnsd = 1.0f - ndi->win[nc].shade_factor_summer * nir->wn_sunscrn[COOLING][nc];
-
-    clmwn[rt][nc] = (window_u_value(ndi->win[nc].frame_type, ndi->win[nc].glazing_type, MANUAL_J_COOL) * dtd +
-                     solar_gain(SOLAR_DIFFUSE, ndi->win[nc].glazing_type) +
-                     solar_gain(ndi->win[nc].solar_orient, ndi->win[nc].glazing_type) * (1.0f - wnsd)) *
-                    ndi->win[nc].area_gross;
-
+      clmwn[rt][nc] = (window_u_value(ndi->win[nc].frame_type, ndi->win[nc].glazing_type, MANUAL_J_COOL) * dtd +
+                       solar_gain(SOLAR_DIFFUSE, ndi->win[nc].glazing_type) +
+                       solar_gain(ndi->win[nc].solar_orient, ndi->win[nc].glazing_type) * (1.0f - wnsd)) *
+                      ndi->win[nc].area_gross;
+    }
+    memo->win[nc].load = clmwn[rt][nc];
     nir->clmt[rt] += clmwn[rt][nc];
   }
 
   /*  Doors, Items, Tab 4-10 and 4-11  */
 
   for (nc = 0; nc < ndi->num_dor; nc++) {
-    switch (ndi->dor[nc].door_type) {
-    case SINGLE_SLIDING_GLASS:
-      wn_U_value = 0.8f;
-      clmdr[rt][nc] =
-          (wn_U_value * dtd + solar_gain(SOLAR_DIFFUSE, SINGLE) + solar_gain(ndi->dor[nc].solar_orient, SINGLE) * 0.7f) *
-          ndi->dor[nc].area; // Assume 30% shade
-      break;
-    case DOUBLE_SLIDING_GLASS:
-      wn_U_value = 0.4f;
-      clmdr[rt][nc] = (wn_U_value * dtd + solar_gain(SOLAR_DIFFUSE, DOUBLE_GLAZED) +
-                       solar_gain(ndi->dor[nc].solar_orient, DOUBLE_GLAZED) * 0.7f) *
-                      ndi->dor[nc].area; // Assume 30% shade
-      break;
-    default:            // opaque doors
-      etd = dtd + 3.6f; // Medium weight house
-      clmdr[rt][nc] = etd * door_u_value(ndi->dor[nc].door_type, ndi->dor[nc].condition, MANUAL_J_COOL) * ndi->dor[nc].area;
-      break;
+    if (SAME_AS_PRE_RETROFIT(cooling_memo, rt, dor, nc)) {
+      clmdr[rt][nc] = cooling_memo[PRE_RETROFIT].dor[nc].load;
+    } else {
+      switch (ndi->dor[nc].door_type) {
+      case SINGLE_SLIDING_GLASS:
+        wn_U_value = 0.8f;
+        clmdr[rt][nc] =
+            (wn_U_value * dtd + solar_gain(SOLAR_DIFFUSE, SINGLE) + solar_gain(ndi->dor[nc].solar_orient, SINGLE) * 0.7f) *
+            ndi->dor[nc].area; // Assume 30% shade
+        break;
+      case DOUBLE_SLIDING_GLASS:
+        wn_U_value = 0.4f;
+        clmdr[rt][nc] = (wn_U_value * dtd + solar_gain(SOLAR_DIFFUSE, DOUBLE_GLAZED) +
+                         solar_gain(ndi->dor[nc].solar_orient, DOUBLE_GLAZED) * 0.7f) *
+                        ndi->dor[nc].area; // Assume 30% shade
+        break;
+      default:            // opaque doors
+        etd = dtd + 3.6f; // Medium weight house
+        clmdr[rt][nc] = etd * door_u_value(ndi->dor[nc].door_type, ndi->dor[nc].condition, MANUAL_J_COOL) * ndi->dor[nc].area;
+        break;
+      }
     }
+    memo->dor[nc].load = clmdr[rt][nc];
     nir->clmt[rt] += clmdr[rt][nc];
   }
 
   /*  Roofs / Ceilings  */
 
   for (nc = 0; nc < ndi->num_uas; nc++) {
-    etd = dtd + color;
-    temp = ndi->uas[nc].r_value;
-    if (ndi->uas[nc].attic_type != UAS_CATHEDRAL) {
-      if (temp >= 23.0f)
-        temp = 1.0216f * temp - 0.400373f; /* roof/attic, Tab 4-16 */
-      else {
-        ASSERT((temp + 2.312784f), sprintf(msg, "Need non zero r value"));
-        temp = 1.0f / (1.0f / 216.4161f + 1.0f / (temp + 2.312784f));
-      }
-    } else { /* cthdrl ceiling, */
-      if (temp >= 21.0f)
-        temp = 0.79365f * temp + 4.62963f;
-      else {
-        ASSERT((temp + 3.522904f), sprintf(msg, "Need non zero r value"));
-        temp = 1.0f / (1.0f / 318.1424f + 1.0f / (temp + 3.522904f));
+    if (SAME_AS_PRE_RETROFIT(cooling_memo, rt, uas, nc)) {
+      clmua[rt][nc] = cooling_memo[PRE_RETROFIT].uas[nc].load;
+    } else {
+      etd = dtd + color;
+      temp = ndi->uas[nc].r_value;
+      if (ndi->uas[nc].attic_type != UAS_CATHEDRAL) {
+        if (temp >= 23.0f)
+          temp = 1.0216f * temp - 0.400373f; /* roof/attic, Tab 4-16 */
+        else {
+          ASSERT((temp + 2.312784f), sprintf(msg, "Need non zero r value"));
+          temp = 1.0f / (1.0f / 216.4161f + 1.0f / (temp + 2.312784f));
+        }
+      } else { /* cthdrl ceiling, */
+        if (temp >= 21.0f)
+          temp = 0.79365f * temp + 4.62963f;
+        else {
+          ASSERT((temp + 3.522904f), sprintf(msg, "Need non zero r value"));
+          temp = 1.0f / (1.0f / 318.1424f + 1.0f / (temp + 3.522904f));
+        }
       }
-    }
 
-    ASSERT(temp, sprintf(msg, "Need non zero r value"));
-    clmua[rt][nc] = etd / temp * ndi->uas[nc].area;
+      ASSERT(temp, sprintf(msg, "Need non zero r value"));
+      clmua[rt][nc] = etd / temp * ndi->uas[nc].area;
+    }
+    memo->uas[nc].load = clmua[rt][nc];
     nir->clmt[rt] += clmua[rt][nc];
   }
 
  /*  Foundations */
 
   for (nc = 0; nc < ndi->num_fnd; nc++) {
-    switch (ndi->fnd[nc].space_type) {
-      case CONDITIONED:
-        etd = dtd - 3.7f;
-        wlr = ndi->fnd[nc].wall_ins_r;
-
-        ASSERT(ndi->fnd[nc].wall_height, sprintf(msg, "Need non zero foundation wall height"));
-        areabg = ndi->fnd[nc].wall_area * ndi->fnd[nc].below_grade_wall_height / ndi->fnd[nc].wall_height; // Tab 4-14
-        areaag = ndi->fnd[nc].wall_area - areabg;
-        clmsb[rt][nc] = etd * ((1 / (0.994092f * wlr + 1.983091f) * areaag) + ndi->fnd[nc].ua_value_basement_sill);
-        break;
-
-      case NON_CONDITIONED:
-      case UNINTENTIONALLY_CONDITIONED:
-      case UNINSULATED_SLAB:
-      case INSULATED_SLAB:
-        clmsb[rt][nc] = 0.0f;
-        break;
-
-      case VENTED_NON_CONTITIONED:
-      case EXPOSED_FLOOR_UNCLOSED:
-      case EXPOSED_FLOOR_CLOSED:
-        fndu = 0.822736f * ndi->fnd[nc].flr_ins_r + 3.309243f; /* Tab 4-20 */
-        ASSERT(fndu, sprintf(msg, "Need non zero foundation uvalue"));
-        fndu = 1.0f / fndu;
-        etd = dtd - 5.0f;
-        clmsb[rt][nc] = etd * fndu * ndi->fnd[nc].area;
-        break;
+    if (SAME_AS_PRE_RETROFIT(cooling_memo, rt, fnd, nc)) {
+      clmsb[rt][nc] = cooling_memo[PRE_RETROFIT].fnd[nc].load;
+    } else {
+      switch (ndi->fnd[nc].space_type) {
+        case CONDITIONED:
+          etd = dtd - 3.7f;
+          wlr = ndi->fnd[nc].wall_ins_r;
+
+          ASSERT(ndi->fnd[nc].wall_height, sprintf(msg, "Need non zero foundation wall height"));
+          areabg = ndi->fnd[nc].wall_area * ndi->fnd[nc].below_grade_wall_height / ndi->fnd[nc].wall_height; // Tab 4-14
+          areaag = ndi->fnd[nc].wall_area - areabg;
+          clmsb[rt][nc] = etd * ((1 / (0.994092f * wlr + 1.983091f) * areaag) + ndi->fnd[nc].ua_value_basement_sill);
+          break;
+
+        case NON_CONDITIONED:
+        case UNINTENTIONALLY_CONDITIONED:
+        case UNINSULATED_SLAB:
+        case INSULATED_SLAB:
+          clmsb[rt][nc] = 0.0f;
+          break;
+
+        case VENTED_NON_CONTITIONED:
+        case EXPOSED_FLOOR_UNCLOSED:
+        case EXPOSED_FLOOR_CLOSED:
+          fndu = 0.822736f * ndi->fnd[nc].flr_ins_r + 3.309243f; /* Tab 4-20 */
+          ASSERT(fndu, sprintf(msg, "Need non zero foundation uvalue"));
+          fndu = 1.0f / fndu;
+          etd = dtd - 5.0f;
+          clmsb[rt][nc] = etd * fndu * ndi->fnd[nc].area;
+          break;
+      }
     }
+    memo->fnd[nc].load = clmsb[rt][nc];
     nir->clmt[rt] += clmsb[rt][nc];
   }
 
@@ -612,38 +809,22 @@ void sizing_cooling(int rt) {
   if (flatent[rt] < 0.0f)
     flatent[rt] = 0.0f;
 
-  flatent_occ = ndi->gnl.avg_no_occupants * 230.0f;
-
   flatent_tot[rt] = flatent[rt] + flatent_occ;
 
   /* If pre rates are not specified, prevent post inf loads from being greater
    * than pre inf loads, i.e. set pre = post then re-adjust totals  */
 
-  if (rt == POST_RETROFIT) {
-    if ((nir->infiltration_treatment == INF_DEFAULT || 
-         nir->infiltration_treatment == INF_INCIDENTAL_COST) && 
-         clminf[PRE_RETROFIT] / dtd < clminf[POST_RETROFIT]) {
-      nir->clmt[PRE_RETROFIT] -= clminf[PRE_RETROFIT];
-      clminf[PRE_RETROFIT] = clminf[POST_RETROFIT];
-      nir->clmt[PRE_RETROFIT] += clminf[PRE_RETROFIT];
-      flatent_tot[PRE_RETROFIT] -= flatent[PRE_RETROFIT];
-      flatent[PRE_RETROFIT] = flatent[POST_RETROFIT];
-      flatent_tot[PRE_RETROFIT] += flatent[PRE_RETROFIT];
-    }
-  }
-
-  /* Internals - People and Appliances  */
-
-  if (ndi->gnl.avg_no_occupants < 1.5f)
-    fpeople = 552.0f / 2.0f;
-  else if (ndi->gnl.avg_no_occupants < 2.5f)
-    fpeople = 552.0f;
-  else
-    fpeople = 552.0f + 224.0f * (ndi->gnl.avg_no_occupants - 2.0f);
-
-  fappliances = 1200.0f;
+  if (rt == POST_RETROFIT)
+    match_pre_cooling_infiltration();
 
   nir->clmt[rt] += fpeople + fappliances;
+
+  memo->total = nir->clmt[rt];
+  memo->infiltration = clminf[rt];
+  memo->latent = flatent[rt];
+  memo->latent_total = flatent_tot[rt];
+  memo->key = key;
+  memo->valid = TRUE;
 }
 
 /*******************
@@ -861,62 +861,278 @@ float attic_ins_added_rpi(int nc) {
   return ndi->ins_attic[ndi->uas[nc].added_insulation].value; // insulation values are imported by their enumeration indexes
 }
 
+// Measure inter dependence/exclusion matrix (cant do both to the same dwelling).
+// Row i has the bit set for each cms measure that measure i excludes.  Rows are
+// not all symmetric (R-19 attic does not exclude R-11 for instance) so always
+// query with the measure being implemented as the row.
+
+#define EXCLUDES(m) ((MEASURE_MASK)1 << (m))
+
+typedef char measure_mask_too_small[(MAXMEAS <= 8 * sizeof(MEASURE_MASK)) ? 1 : -1];
+
+static const MEASURE_MASK measure_exclusion_matrix[MAXMEAS] = {
+  [N_CMS_ATTIC_INSULATION_R11]          = EXCLUDES(N_CMS_ATTIC_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_CEILING_CAVITY) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R49),
+  [N_CMS_ATTIC_INSULATION_R19]          = EXCLUDES(N_CMS_ATTIC_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_CEILING_CAVITY) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R49),
+  [N_CMS_ATTIC_INSULATION_R30]          = EXCLUDES(N_CMS_ATTIC_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_CEILING_CAVITY) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R49),
+  [N_CMS_ATTIC_INSULATION_R38]          = EXCLUDES(N_CMS_ATTIC_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_CEILING_CAVITY) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R49),
+  [N_CMS_WALL_INSULATION]               = EXCLUDES(N_CMS_WALL_INSULATION),
+  [N_CMS_SILLBOX_INSULATION]            = EXCLUDES(N_CMS_SILLBOX_INSULATION) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R38),
+  [N_CMS_FOUNDATION_WALL_INSULATION]    = EXCLUDES(N_CMS_FOUNDATION_WALL_INSULATION) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R38),
+  [N_CMS_FLOOR_INSULATION_R11]          = EXCLUDES(N_CMS_SILLBOX_INSULATION) |
+                                          EXCLUDES(N_CMS_FOUNDATION_WALL_INSULATION) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_FLOOR_CAVITY),
+  [N_CMS_FLOOR_INSULATION_R19]          = EXCLUDES(N_CMS_SILLBOX_INSULATION) |
+                                          EXCLUDES(N_CMS_FOUNDATION_WALL_INSULATION) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_FLOOR_CAVITY),
+  [N_CMS_FLOOR_INSULATION_R30]          = EXCLUDES(N_CMS_SILLBOX_INSULATION) |
+                                          EXCLUDES(N_CMS_FOUNDATION_WALL_INSULATION) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_FLOOR_CAVITY),
+  [N_CMS_FLOOR_INSULATION_R38]          = EXCLUDES(N_CMS_SILLBOX_INSULATION) |
+                                          EXCLUDES(N_CMS_FOUNDATION_WALL_INSULATION) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_FLOOR_CAVITY),
+  [N_CMS_STORM_WINDOWS]                 = EXCLUDES(N_CMS_STORM_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SHADING_AWNING) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_FABRIC) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_LOUVERED) |
+                                          EXCLUDES(N_CMS_WINDOW_FILM) |
+                                          EXCLUDES(N_CMS_LOW_E_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SEALING) |
+                                          EXCLUDES(N_CMS_WINDOW_REPLACEMENT),
+  [N_CMS_KNEEWALL_INSULATION]           = EXCLUDES(N_CMS_KNEEWALL_INSULATION),
+  [N_CMS_WINDOW_SHADING_AWNING]         = EXCLUDES(N_CMS_STORM_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SHADING_AWNING) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_FABRIC) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_LOUVERED) |
+                                          EXCLUDES(N_CMS_WINDOW_FILM) |
+                                          EXCLUDES(N_CMS_LOW_E_WINDOWS),
+  [N_CMS_SUN_SCREEN_FABRIC]             = EXCLUDES(N_CMS_STORM_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SHADING_AWNING) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_FABRIC) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_LOUVERED) |
+                                          EXCLUDES(N_CMS_WINDOW_FILM) |
+                                          EXCLUDES(N_CMS_LOW_E_WINDOWS),
+  [N_CMS_SUN_SCREEN_LOUVERED]           = EXCLUDES(N_CMS_STORM_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SHADING_AWNING) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_FABRIC) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_LOUVERED) |
+                                          EXCLUDES(N_CMS_WINDOW_FILM) |
+                                          EXCLUDES(N_CMS_LOW_E_WINDOWS),
+  [N_CMS_WINDOW_FILM]                   = EXCLUDES(N_CMS_STORM_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SHADING_AWNING) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_FABRIC) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_LOUVERED) |
+                                          EXCLUDES(N_CMS_WINDOW_FILM) |
+                                          EXCLUDES(N_CMS_LOW_E_WINDOWS),
+  [N_CMS_LOW_E_WINDOWS]                 = EXCLUDES(N_CMS_STORM_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SHADING_AWNING) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_FABRIC) |
+                                          EXCLUDES(N_CMS_SUN_SCREEN_LOUVERED) |
+                                          EXCLUDES(N_CMS_WINDOW_FILM) |
+                                          EXCLUDES(N_CMS_LOW_E_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SEALING) |
+                                          EXCLUDES(N_CMS_WINDOW_REPLACEMENT),
+  [N_CMS_THERMAL_VENT_DAMPER]           = EXCLUDES(N_CMS_THERMAL_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER_AND_IID) |
+                                          EXCLUDES(N_CMS_FLAME_RETENTION_BURNER) |
+                                          EXCLUDES(N_CMS_REPLACE_HEATING_SYSTEM) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_FURNACE) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_BOILER),
+  [N_CMS_ELECTRIC_VENT_DAMPER]          = EXCLUDES(N_CMS_THERMAL_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER_AND_IID) |
+                                          EXCLUDES(N_CMS_FLAME_RETENTION_BURNER) |
+                                          EXCLUDES(N_CMS_REPLACE_HEATING_SYSTEM) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_FURNACE) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_BOILER),
+  [N_CMS_IID]                           = EXCLUDES(N_CMS_IID) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER_AND_IID) |
+                                          EXCLUDES(N_CMS_REPLACE_HEATING_SYSTEM) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_FURNACE) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_BOILER),
+  [N_CMS_ELECTRIC_VENT_DAMPER_AND_IID]  = EXCLUDES(N_CMS_THERMAL_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_IID) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER_AND_IID) |
+                                          EXCLUDES(N_CMS_FLAME_RETENTION_BURNER) |
+                                          EXCLUDES(N_CMS_REPLACE_HEATING_SYSTEM) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_FURNACE) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_BOILER),
+  [N_CMS_FLAME_RETENTION_BURNER]        = EXCLUDES(N_CMS_THERMAL_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER_AND_IID) |
+                                          EXCLUDES(N_CMS_FLAME_RETENTION_BURNER) |
+                                          EXCLUDES(N_CMS_REPLACE_HEATING_SYSTEM) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_FURNACE) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_BOILER),
+  [N_CMS_FURNACE_TUNE_UP]               = EXCLUDES(N_CMS_FURNACE_TUNE_UP) |
+                                          EXCLUDES(N_CMS_REPLACE_HEATING_SYSTEM) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_FURNACE) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_BOILER),
+  [N_CMS_REPLACE_HEATING_SYSTEM]        = EXCLUDES(N_CMS_THERMAL_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_IID) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER_AND_IID) |
+                                          EXCLUDES(N_CMS_FLAME_RETENTION_BURNER) |
+                                          EXCLUDES(N_CMS_FURNACE_TUNE_UP) |
+                                          EXCLUDES(N_CMS_REPLACE_HEATING_SYSTEM) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_FURNACE) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_BOILER),
+  [N_CMS_HIGH_EFFICIENCY_FURNACE]       = EXCLUDES(N_CMS_THERMAL_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_IID) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER_AND_IID) |
+                                          EXCLUDES(N_CMS_FLAME_RETENTION_BURNER) |
+                                          EXCLUDES(N_CMS_FURNACE_TUNE_UP) |
+                                          EXCLUDES(N_CMS_REPLACE_HEATING_SYSTEM) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_FURNACE),
+  [N_CMS_SMART_THERMOSTAT]              = EXCLUDES(N_CMS_SMART_THERMOSTAT),
+  [N_CMS_REPLACE_AC]                    = EXCLUDES(N_CMS_REPLACE_AC) |
+                                          EXCLUDES(N_CMS_EVAPORATIVE_COOLER) |
+                                          EXCLUDES(N_CMS_INSTALL_OR_REPLACE_HEATPUMP) |
+                                          EXCLUDES(N_CMS_TUNE_UP_AC),
+  [N_CMS_EVAPORATIVE_COOLER]            = EXCLUDES(N_CMS_REPLACE_AC) |
+                                          EXCLUDES(N_CMS_EVAPORATIVE_COOLER) |
+                                          EXCLUDES(N_CMS_INSTALL_OR_REPLACE_HEATPUMP) |
+                                          EXCLUDES(N_CMS_TUNE_UP_AC),
+  [N_CMS_INSTALL_OR_REPLACE_HEATPUMP]   = EXCLUDES(N_CMS_REPLACE_AC) |
+                                          EXCLUDES(N_CMS_EVAPORATIVE_COOLER) |
+                                          EXCLUDES(N_CMS_INSTALL_OR_REPLACE_HEATPUMP) |
+                                          EXCLUDES(N_CMS_TUNE_UP_AC),
+  [N_CMS_INFILTRATION_REDUCTION]        = EXCLUDES(N_CMS_INFILTRATION_REDUCTION),
+  [N_CMS_DUCT_INSULATION]               = EXCLUDES(N_CMS_DUCT_INSULATION),
+  [N_CMS_FILL_CEILING_CAVITY]           = EXCLUDES(N_CMS_ATTIC_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_CEILING_CAVITY) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R49),
+  [N_CMS_LIGHTING_RETROFITS]            = EXCLUDES(N_CMS_LIGHTING_RETROFITS),
+  [N_CMS_TUNE_UP_AC]                    = EXCLUDES(N_CMS_REPLACE_AC) |
+                                          EXCLUDES(N_CMS_EVAPORATIVE_COOLER) |
+                                          EXCLUDES(N_CMS_INSTALL_OR_REPLACE_HEATPUMP) |
+                                          EXCLUDES(N_CMS_TUNE_UP_AC),
+  [N_CMS_WINDOW_SEALING]                = EXCLUDES(N_CMS_STORM_WINDOWS) |
+                                          EXCLUDES(N_CMS_LOW_E_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SEALING) |
+                                          EXCLUDES(N_CMS_WINDOW_REPLACEMENT),
+  [N_CMS_WINDOW_REPLACEMENT]            = EXCLUDES(N_CMS_STORM_WINDOWS) |
+                                          EXCLUDES(N_CMS_LOW_E_WINDOWS) |
+                                          EXCLUDES(N_CMS_WINDOW_SEALING) |
+                                          EXCLUDES(N_CMS_WINDOW_REPLACEMENT),
+  [N_CMS_WATER_HEATER_TANK_INSULATION]  = EXCLUDES(N_CMS_WATER_HEATER_TANK_INSULATION) |
+                                          EXCLUDES(N_CMS_WATER_HEATER_REPLACEMENT),
+  [N_CMS_WATER_HEATER_PIPE_INSULATION]  = EXCLUDES(N_CMS_WATER_HEATER_PIPE_INSULATION),
+  [N_CMS_LOW_FLOW_SHOWERHEADS]          = EXCLUDES(N_CMS_LOW_FLOW_SHOWERHEADS),
+  [N_CMS_REFRIGERATOR_REPLACEMENT]      = EXCLUDES(N_CMS_REFRIGERATOR_REPLACEMENT),
+  [N_CMS_DUCT_SEALING]                  = EXCLUDES(N_CMS_DUCT_SEALING),
+  [N_CMS_WATER_HEATER_REPLACEMENT]      = EXCLUDES(N_CMS_WATER_HEATER_TANK_INSULATION) |
+                                          EXCLUDES(N_CMS_WATER_HEATER_REPLACEMENT),
+  [N_CMS_HIGH_EFFICIENCY_BOILER]        = EXCLUDES(N_CMS_THERMAL_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER) |
+                                          EXCLUDES(N_CMS_IID) |
+                                          EXCLUDES(N_CMS_ELECTRIC_VENT_DAMPER_AND_IID) |
+                                          EXCLUDES(N_CMS_FLAME_RETENTION_BURNER) |
+                                          EXCLUDES(N_CMS_FURNACE_TUNE_UP) |
+                                          EXCLUDES(N_CMS_REPLACE_HEATING_SYSTEM) |
+                                          EXCLUDES(N_CMS_HIGH_EFFICIENCY_BOILER),
+  [N_CMS_ATTIC_INSULATION_R49]          = EXCLUDES(N_CMS_ATTIC_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_CEILING_CAVITY) |
+                                          EXCLUDES(N_CMS_ATTIC_INSULATION_R49),
+  [N_CMS_DOOR_REPLACEMENT]              = EXCLUDES(N_CMS_DOOR_REPLACEMENT),
+  [N_CMS_WHITE_ROOF_COATING]            = EXCLUDES(N_CMS_WHITE_ROOF_COATING),
+  [N_CMS_FILL_FLOOR_CAVITY]             = EXCLUDES(N_CMS_SILLBOX_INSULATION) |
+                                          EXCLUDES(N_CMS_FOUNDATION_WALL_INSULATION) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R11) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R19) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R30) |
+                                          EXCLUDES(N_CMS_FLOOR_INSULATION_R38) |
+                                          EXCLUDES(N_CMS_FILL_FLOOR_CAVITY),
+};
+
+// all of the measures that are mutually exclusive with measure i, a zero
+// mask for measures outside the table (itemized costs)
+
+MEASURE_MASK measure_exclusions(int i) {
+  if (i < 0 || i >= MAXMEAS)
+    return (0);
+  return (measure_exclusion_matrix[i]);
+}
+
 // returns true if measures i and j are mutually exclusive
 
 int mutually_exclusive_measures(int i, int j) {
-  int m;
-  for (m = 0; m < nir->measure_exclusion_count[i]; m++) {
-    if (nir->measure_exclusion[i][m] == j)
-      return (1);
-  }
-  return (0);
+  if (j < 0 || j >= MAXMEAS)
+    return (0);
+  return ((measure_exclusions(i) & EXCLUDES(j)) != 0);
 }
 
 /*****************************************
  *****************************************
- Rank measures(items) according to decreasing B/C (ranking parameter)  */
+ Rank measures(items) according to decreasing B/C (ranking parameter)  
+ items 0..npt, equal ranking parameters put the later item first  */
+
+static int rankms_before(int a, int b, void *context) {
+  float *elc = (float *)context;
+  if (elc[a] != elc[b])
+    return (elc[a] > elc[b]);
+  return (a > b);
+}
 
 int rankms(float elc[], int npt, int kwhc[]) {
-  int np, ip, is, i, j;
-  for (i = 0; i < MAXECMS; i++)
+  for (int i = 0; i < MAXECMS; i++)
     kwhc[i] = 0;
+  for (int i = 0; i <= npt; i++)
+    kwhc[i] = i;
 
-  /*  Rank one item at a time after assuming the first item has the greatest
-        ranking parameter  */
-
-  for (np = 1; np <= npt; np++) {
-
-    /*  Starting with the item with smallest ranking parameter, find the first
-        item previously ranked whose ranking paramter is greater than the item
-        currently being ranked (the test item) */
+  stable_rank(kwhc, npt + 1, rankms_before, elc);
 
-    for (ip = np - 1; ip >= -1; ip--) {
-      if (ip == -1) {
-        for (j = np - 1; j >= ip + 1; j--)
-          is = kwhc[j], kwhc[j + 1] = is;
-        kwhc[ip + 1] = np;
-        goto laba;
-      } else if (elc[np] < elc[kwhc[ip]]) {
-
-        /*  Increase by one the rankings of all items with ranking parameters less
-            than the test item  */
-
-        for (j = np - 1; j >= ip + 1; j--)
-          is = kwhc[j], kwhc[j + 1] = is;
-
-        /*  Set the rank of the test item at the level determined   */
-
-        kwhc[ip + 1] = np;
-        goto laba;
-      }
-    }
-  laba:;
-  }
-  /*
-        fprintf(stderr, "\n    I   elc        I   kwhc  elc\n") ;
-        for(i=0;i<=npt;i++) fprintf(stderr, "%5d%7.2f%8d%5d%7.2f\n",
-           i,elc[i],i,kwhc[i],elc[kwhc[i]]);
-  */
   return (0);
 }
 
@@ -45,6 +45,8 @@ float attic_ins_added_rpi(int nc);
 char *strupr(char *s);
 int getf_line(char line[], int max, FILE *fln);
 
+typedef unsigned long long MEASURE_MASK;   // one bit per cms measure number
+MEASURE_MASK measure_exclusions(int i);
 int mutually_exclusive_measures(int i, int j);
 int rankms(float elc[], int npt, int kwhc[]);
 int solinc(float alat);